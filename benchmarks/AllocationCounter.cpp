@@ -0,0 +1,54 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+using namespace arangodb::velocypack::benchmarks;
+
+namespace {
+// thread_local, so counting doesn't introduce contention in multi-threaded
+// benchmarks.
+thread_local std::size_t allocationCount = 0;
+thread_local std::size_t allocationBytes = 0;
+}  // namespace
+
+std::size_t AllocationCounter::allocations() noexcept {
+  return allocationCount;
+}
+
+std::size_t AllocationCounter::bytes() noexcept { return allocationBytes; }
+
+void* operator new(std::size_t size) {
+  ++allocationCount;
+  allocationBytes += size;
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
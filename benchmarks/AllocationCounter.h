@@ -0,0 +1,39 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef BENCHMARKS_ALLOCATIONCOUNTER_H
+#define BENCHMARKS_ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+
+namespace arangodb::velocypack::benchmarks {
+
+// Counts the heap allocations of the current thread. Global operator new is
+// replaced in AllocationCounter.cpp to feed these counters.
+struct AllocationCounter {
+  static std::size_t allocations() noexcept;
+  static std::size_t bytes() noexcept;
+};
+
+}  // namespace arangodb::velocypack::benchmarks
+
+#endif  // BENCHMARKS_ALLOCATIONCOUNTER_H
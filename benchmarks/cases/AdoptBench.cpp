@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Buffer.h>
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+Builder makeDocument(int64_t size) {
+  Builder builder;
+  builder.openArray();
+  for (int64_t i = 0; i < size; ++i) {
+    builder.add(Value("element" + std::to_string(i)));
+  }
+  builder.close();
+  return builder;
+}
+
+// Stands in for receiving a frame from the network
+std::vector<uint8_t> receive(Slice slice) {
+  return std::vector<uint8_t>(slice.start(), slice.start() + slice.byteSize());
+}
+}  // namespace
+
+static void BM_ReceiveCopyOf(benchmark::State& state) {
+  auto const builder = makeDocument(state.range(0));
+  for (auto _ : state) {
+    auto frame = receive(builder.slice());
+    auto sharedSlice = SharedSlice::copyOf(Slice(frame.data()));
+    benchmark::DoNotOptimize(sharedSlice.slice().start());
+  }
+  state.SetBytesProcessed(state.iterations() * builder.slice().byteSize());
+}
+BENCHMARK(BM_ReceiveCopyOf)->Range(8, 8 << 10);
+
+static void BM_ReceiveBuffer(benchmark::State& state) {
+  auto const builder = makeDocument(state.range(0));
+  for (auto _ : state) {
+    auto frame = receive(builder.slice());
+    auto buffer = std::make_shared<Buffer<uint8_t>>();
+    buffer->append(frame.data(), frame.size());
+    auto sharedSlice = SharedSlice(std::move(buffer));
+    benchmark::DoNotOptimize(sharedSlice.slice().start());
+  }
+  state.SetBytesProcessed(state.iterations() * builder.slice().byteSize());
+}
+BENCHMARK(BM_ReceiveBuffer)->Range(8, 8 << 10);
+
+template <typename S>
+static void BM_ReceiveAdopt(benchmark::State& state) {
+  auto const builder = makeDocument(state.range(0));
+  for (auto _ : state) {
+    auto sharedSlice = S::adopt(receive(builder.slice()));
+    benchmark::DoNotOptimize(sharedSlice.slice().start());
+  }
+  state.SetBytesProcessed(state.iterations() * builder.slice().byteSize());
+}
+BENCHMARK_TEMPLATE(BM_ReceiveAdopt, SharedSlice)->Range(8, 8 << 10);
+BENCHMARK_TEMPLATE(BM_ReceiveAdopt, IntrusiveSharedSlice)->Range(8, 8 << 10);
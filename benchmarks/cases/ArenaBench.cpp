@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "AllocationCounter.h"
+
+#include "velocypack/SharedSlice.h"
+#include "velocypack/SharedSliceArena.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+using namespace arangodb::velocypack::benchmarks;
+
+namespace {
+Builder makeDocument() {
+  Builder builder;
+  builder.openObject();
+  builder.add("_key", Value("12345"));
+  builder.add("value", Value(42));
+  builder.close();
+  return builder;
+}
+}  // namespace
+
+// Creates a batch of small documents which all die together, like a batch
+// operator does.
+
+static void BM_BatchCopyOf(benchmark::State& state) {
+  auto const builder = makeDocument();
+  auto const batchSize = static_cast<std::size_t>(state.range(0));
+  auto batch = std::vector<SharedSlice>();
+  batch.reserve(batchSize);
+  auto const allocationsBefore = AllocationCounter::allocations();
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < batchSize; ++i) {
+      batch.emplace_back(SharedSlice::copyOf(builder.slice()));
+    }
+    batch.clear();
+  }
+  state.counters["allocsPerDoc"] =
+      benchmark::Counter(static_cast<double>(AllocationCounter::allocations() -
+                                             allocationsBefore) /
+                             batchSize,
+                         benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations() * batchSize);
+}
+BENCHMARK(BM_BatchCopyOf)->Arg(1000);
+
+static void BM_BatchArena(benchmark::State& state) {
+  auto const builder = makeDocument();
+  auto const batchSize = static_cast<std::size_t>(state.range(0));
+  auto batch = std::vector<SharedSlice>();
+  batch.reserve(batchSize);
+  auto arena = SharedSliceArena();
+  auto const allocationsBefore = AllocationCounter::allocations();
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < batchSize; ++i) {
+      batch.emplace_back(arena.copyOf(builder.slice()));
+    }
+    batch.clear();
+  }
+  state.counters["allocsPerDoc"] =
+      benchmark::Counter(static_cast<double>(AllocationCounter::allocations() -
+                                             allocationsBefore) /
+                             batchSize,
+                         benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations() * batchSize);
+}
+BENCHMARK(BM_BatchArena)->Arg(1000);
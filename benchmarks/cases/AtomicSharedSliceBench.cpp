@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "velocypack/AtomicSharedSlice.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+SharedSlice makeVersion(int64_t version) {
+  Builder builder;
+  builder.openObject();
+  builder.add("version", Value(version));
+  builder.add("payload", Value("some configuration payload"));
+  builder.close();
+  return SharedSlice::copyOf(builder.slice());
+}
+
+// Thread 0 publishes a new version every so many iterations, all other
+// threads read
+constexpr int64_t writeInterval = 64;
+
+void readerThreads(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ThreadRange(2, 64)->UseRealTime();
+}
+
+AtomicSharedSlice atomicSlice(makeVersion(0));
+std::shared_ptr<uint8_t const> atomicPtr = makeVersion(0).buffer();
+SharedSlice lockedSlice = makeVersion(0);
+std::shared_mutex sliceMutex;
+}  // namespace
+
+static void BM_AtomicSharedSliceGuard(benchmark::State& state) {
+  auto version = int64_t{0};
+  for (auto _ : state) {
+    if (state.thread_index() == 0) {
+      if (++version % writeInterval == 0) {
+        atomicSlice.store(makeVersion(version));
+      }
+    } else {
+      auto guard = atomicSlice.guard();
+      benchmark::DoNotOptimize(guard->head());
+    }
+  }
+}
+BENCHMARK(BM_AtomicSharedSliceGuard)->Apply(readerThreads);
+
+static void BM_AtomicSharedSliceLoad(benchmark::State& state) {
+  auto version = int64_t{0};
+  for (auto _ : state) {
+    if (state.thread_index() == 0) {
+      if (++version % writeInterval == 0) {
+        atomicSlice.store(makeVersion(version));
+      }
+    } else {
+      auto slice = atomicSlice.load();
+      benchmark::DoNotOptimize(slice.slice().head());
+    }
+  }
+}
+BENCHMARK(BM_AtomicSharedSliceLoad)->Apply(readerThreads);
+
+// std::atomic_load on a shared_ptr, which libstdc++ implements with a pool of
+// spin locks
+static void BM_SharedPtrAtomicLoad(benchmark::State& state) {
+  auto version = int64_t{0};
+  for (auto _ : state) {
+    if (state.thread_index() == 0) {
+      if (++version % writeInterval == 0) {
+        std::atomic_store(&atomicPtr, makeVersion(version).buffer());
+      }
+    } else {
+      auto ptr = std::atomic_load(&atomicPtr);
+      benchmark::DoNotOptimize(*ptr);
+    }
+  }
+}
+BENCHMARK(BM_SharedPtrAtomicLoad)->Apply(readerThreads);
+
+static void BM_SharedMutexLoad(benchmark::State& state) {
+  auto version = int64_t{0};
+  for (auto _ : state) {
+    if (state.thread_index() == 0) {
+      if (++version % writeInterval == 0) {
+        auto replacement = makeVersion(version);
+        auto lock = std::unique_lock(sliceMutex);
+        lockedSlice = std::move(replacement);
+      }
+    } else {
+      auto slice = [&] {
+        auto lock = std::shared_lock(sliceMutex);
+        return lockedSlice;
+      }();
+      benchmark::DoNotOptimize(slice.slice().head());
+    }
+  }
+}
+BENCHMARK(BM_SharedMutexLoad)->Apply(readerThreads);
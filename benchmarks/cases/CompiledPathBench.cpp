@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "velocypack/CompiledPath.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+std::vector<SharedSlice> makeDocuments() {
+  auto documents = std::vector<SharedSlice>();
+  for (int i = 0; i < 1000; ++i) {
+    Builder builder;
+    builder.openObject();
+    builder.add("_key", Value(std::to_string(i)));
+    builder.add("user", Value(ValueType::Object));
+    builder.add("name", Value("someone"));
+    builder.add("address", Value(ValueType::Object));
+    builder.add("street", Value("somewhere"));
+    builder.add("city", Value("city" + std::to_string(i % 10)));
+    builder.close();
+    builder.close();
+    builder.close();
+    documents.emplace_back(SharedSlice::copyOf(builder.slice()));
+  }
+  return documents;
+}
+}  // namespace
+
+// Evaluates user.address.city against many documents
+
+static void BM_VectorPathGet(benchmark::State& state) {
+  auto const documents = makeDocuments();
+  for (auto _ : state) {
+    for (auto const& document : documents) {
+      // Like a filter stage building the path per document
+      benchmark::DoNotOptimize(
+          document.get(std::vector<std::string>{"user", "address", "city"}));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * documents.size());
+}
+BENCHMARK(BM_VectorPathGet);
+
+static void BM_VectorPathGetReused(benchmark::State& state) {
+  auto const documents = makeDocuments();
+  auto const path = std::vector<std::string>{"user", "address", "city"};
+  for (auto _ : state) {
+    for (auto const& document : documents) {
+      benchmark::DoNotOptimize(document.get(path));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * documents.size());
+}
+BENCHMARK(BM_VectorPathGetReused);
+
+static void BM_CompiledPathGet(benchmark::State& state) {
+  auto const documents = makeDocuments();
+  auto const path = CompiledPath::parse(StringRef("user.address.city"));
+  for (auto _ : state) {
+    for (auto const& document : documents) {
+      benchmark::DoNotOptimize(path.get(document));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * documents.size());
+}
+BENCHMARK(BM_CompiledPathGet);
+
+static void BM_CompiledPathBorrow(benchmark::State& state) {
+  auto const documents = makeDocuments();
+  auto const path = CompiledPath::parse(StringRef("user.address.city"));
+  for (auto _ : state) {
+    for (auto const& document : documents) {
+      benchmark::DoNotOptimize(path.borrow(document).slice().start());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * documents.size());
+}
+BENCHMARK(BM_CompiledPathBorrow);
+
+static void BM_CompiledPathBatch(benchmark::State& state) {
+  auto const documents = makeDocuments();
+  auto results = std::vector<SharedSlice>(documents.size());
+  auto const path = CompiledPath::parse(StringRef("user.address.city"));
+  for (auto _ : state) {
+    path.get(documents.data(), documents.size(), results.data());
+    benchmark::DoNotOptimize(results.data());
+  }
+  state.SetItemsProcessed(state.iterations() * documents.size());
+}
+BENCHMARK(BM_CompiledPathBatch);
@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "velocypack/AtomicSharedSlice.h"
+#include "velocypack/EpochPtr.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+SharedSlice makeDocument() {
+  Builder builder;
+  builder.openObject();
+  for (int i = 0; i < 16; ++i) {
+    builder.add("attribute" + std::to_string(i), Value(i));
+  }
+  builder.add("nested", Value(ValueType::Array));
+  for (int i = 0; i < 16; ++i) {
+    builder.add(Value(i));
+  }
+  builder.close();
+  builder.close();
+  return SharedSlice::copyOf(builder.slice());
+}
+
+void allCores(benchmark::internal::Benchmark* benchmark) {
+  for (unsigned threads = 1;
+       threads <= std::max(std::thread::hardware_concurrency(), 1u);
+       threads *= 2) {
+    benchmark->Threads(static_cast<int>(threads));
+  }
+  benchmark->UseRealTime();
+}
+
+// A typical short read: a few aliases into the document
+template <typename SharedSliceType>
+int64_t read(SharedSliceType const& document) {
+  auto const nested = document.get("nested");
+  return document.get("attribute3").getInt() + nested.at(7).getInt() +
+         nested.at(11).getInt();
+}
+
+SharedSlice const sharedDocument = makeDocument();
+AtomicSharedSlice atomicDocument(makeDocument());
+EpochAtomicSharedSlice epochDocument(makeDocument());
+}  // namespace
+
+// Every copy and alias increments and decrements the same shared refcount
+static void BM_SharedPtrRead(benchmark::State& state) {
+  for (auto _ : state) {
+    auto const document = sharedDocument;
+    benchmark::DoNotOptimize(read(document));
+  }
+}
+BENCHMARK(BM_SharedPtrRead)->Apply(allCores);
+
+// One increment for load(), the aliases still count references
+static void BM_AtomicSharedSliceRead(benchmark::State& state) {
+  for (auto _ : state) {
+    auto const document = atomicDocument.load();
+    benchmark::DoNotOptimize(read(document));
+  }
+}
+BENCHMARK(BM_AtomicSharedSliceRead)->Apply(allCores);
+
+static void BM_EpochRead(benchmark::State& state) {
+  for (auto _ : state) {
+    EpochGuard guard;
+    auto const document = epochDocument.load(guard);
+    benchmark::DoNotOptimize(read(document));
+  }
+}
+BENCHMARK(BM_EpochRead)->Apply(allCores);
+
+// Thread 0 publishes a new version every so many iterations
+static void BM_EpochReadWithWriter(benchmark::State& state) {
+  auto iteration = int64_t{0};
+  for (auto _ : state) {
+    if (state.thread_index() == 0) {
+      if (++iteration % 64 == 0) {
+        epochDocument.store(makeDocument());
+      }
+    } else {
+      EpochGuard guard;
+      auto const document = epochDocument.load(guard);
+      benchmark::DoNotOptimize(read(document));
+    }
+  }
+}
+BENCHMARK(BM_EpochReadWithWriter)->ThreadRange(2, 64)->UseRealTime();
@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "velocypack/AttributeSet.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+SharedSlice makeObject(bool unindexed) {
+  Builder builder;
+  builder.openObject(unindexed);
+  for (int64_t i = 0; i < 50; ++i) {
+    builder.add("attribute" + std::to_string(i), Value(i));
+  }
+  builder.close();
+  return SharedSlice::copyOf(builder.slice());
+}
+
+std::vector<std::string> makeNames() {
+  auto names = std::vector<std::string>();
+  for (int64_t i = 0; i < 10; ++i) {
+    names.emplace_back("attribute" + std::to_string(i * 5 + 2));
+  }
+  return names;
+}
+}  // namespace
+
+// Extracting 10 out of 50 attributes, the arg is whether the object is
+// compact (unindexed)
+
+static void BM_GetEach(benchmark::State& state) {
+  auto const sharedSlice = makeObject(state.range(0) != 0);
+  auto const names = makeNames();
+  auto results = std::vector<SharedSlice>(names.size());
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      results[i] = sharedSlice.get(names[i]);
+    }
+    benchmark::DoNotOptimize(results.data());
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+BENCHMARK(BM_GetEach)->Arg(0)->Arg(1);
+
+static void BM_GetMany(benchmark::State& state) {
+  auto const sharedSlice = makeObject(state.range(0) != 0);
+  auto const attributes = AttributeSet(makeNames());
+  auto results = std::vector<SharedSlice>(attributes.size());
+  for (auto _ : state) {
+    sharedSlice.getMany(attributes, results.data());
+    benchmark::DoNotOptimize(results.data());
+  }
+  state.SetItemsProcessed(state.iterations() * attributes.size());
+}
+BENCHMARK(BM_GetMany)->Arg(0)->Arg(1);
@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+SharedSlice makeDocument(int64_t size) {
+  Builder builder;
+  builder.openObject();
+  for (int64_t i = 0; i < size; ++i) {
+    builder.add("attribute" + std::to_string(i),
+                Value("value" + std::to_string(i)));
+  }
+  builder.close();
+  return SharedSlice::copyOf(builder.slice());
+}
+}  // namespace
+
+// Hashing the same document over and over, as when it moves between hash
+// tables. The arg is the number of attributes.
+
+static void BM_NormalizedHash(benchmark::State& state) {
+  auto const document = makeDocument(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(document.normalizedHash());
+  }
+  state.SetBytesProcessed(state.iterations() * document.byteSize());
+}
+BENCHMARK(BM_NormalizedHash)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_NormalizedHashCached(benchmark::State& state) {
+  auto const document = makeDocument(state.range(0));
+  document.enableHashCache();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(document.normalizedHash());
+  }
+  state.SetBytesProcessed(state.iterations() * document.byteSize());
+}
+BENCHMARK(BM_NormalizedHashCached)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->ThreadRange(1, 8);
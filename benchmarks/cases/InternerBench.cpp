@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "velocypack/SharedSlice.h"
+#include "velocypack/SharedSliceInterner.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+// count documents, of which about duplicatePercent percent are copies of
+// earlier ones
+std::vector<SharedSlice> makeDocuments(int64_t count,
+                                       int64_t duplicatePercent) {
+  auto documents = std::vector<SharedSlice>();
+  Builder builder;
+  auto const distinct =
+      std::max<int64_t>(1, count * (100 - duplicatePercent) / 100);
+  for (int64_t i = 0; i < count; ++i) {
+    builder.clear();
+    builder.openObject();
+    builder.add("_key", Value(std::to_string(i % distinct)));
+    builder.add("payload", Value(std::string(200, 'x')));
+    builder.close();
+    documents.emplace_back(SharedSlice::copyOf(builder.slice()));
+  }
+  return documents;
+}
+}  // namespace
+
+// Interning a batch of documents, the arg is the percentage of duplicates
+
+static void BM_Intern(benchmark::State& state) {
+  auto const documents = makeDocuments(10000, state.range(0));
+  auto interned = std::vector<SharedSlice>(documents.size());
+  for (auto _ : state) {
+    auto interner = SharedSliceInterner();
+    for (std::size_t i = 0; i < documents.size(); ++i) {
+      interned[i] = interner.intern(documents[i]);
+    }
+    state.counters["dedupRatio"] = interner.stats().dedupRatio();
+  }
+  state.SetItemsProcessed(state.iterations() * documents.size());
+}
+BENCHMARK(BM_Intern)->Arg(0)->Arg(30)->Arg(60);
+
+static void BM_InternConcurrent(benchmark::State& state) {
+  static auto interner = SharedSliceInterner();
+  auto const documents = makeDocuments(1000, 50);
+  for (auto _ : state) {
+    for (auto const& document : documents) {
+      benchmark::DoNotOptimize(interner.intern(document));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * documents.size());
+}
+BENCHMARK(BM_InternConcurrent)->ThreadRange(1, 16);
@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "velocypack/SharedIterator.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+constexpr int64_t numElements = 1 << 20;
+
+SharedSlice makeArray() {
+  Builder builder;
+  builder.openArray();
+  for (int64_t i = 0; i < numElements; ++i) {
+    builder.add(Value(i));
+  }
+  builder.close();
+  return SharedSlice(builder.buffer());
+}
+
+SharedSlice makeObject() {
+  Builder builder;
+  builder.openObject();
+  for (int64_t i = 0; i < numElements; ++i) {
+    builder.add(std::to_string(i), Value(i));
+  }
+  builder.close();
+  return SharedSlice(builder.buffer());
+}
+
+SharedSlice const& array() {
+  static auto const slice = makeArray();
+  return slice;
+}
+
+SharedSlice const& object() {
+  static auto const slice = makeObject();
+  return slice;
+}
+}  // namespace
+
+// Per-element cost of iterating a large array, plain vs. shared vs. borrowed.
+
+static void BM_ArrayIterator(benchmark::State& state) {
+  auto const& slice = array();
+  for (auto _ : state) {
+    for (auto value : ArrayIterator(slice.slice())) {
+      benchmark::DoNotOptimize(value.start());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * numElements);
+}
+BENCHMARK(BM_ArrayIterator);
+
+static void BM_SharedArrayIterator(benchmark::State& state) {
+  auto const& slice = array();
+  for (auto _ : state) {
+    for (auto value : SharedArrayIterator(slice)) {
+      benchmark::DoNotOptimize(value.slice().start());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * numElements);
+}
+BENCHMARK(BM_SharedArrayIterator);
+
+static void BM_BorrowedArrayIterator(benchmark::State& state) {
+  auto const& slice = array();
+  for (auto _ : state) {
+    for (auto value : BorrowedArrayIterator(slice)) {
+      benchmark::DoNotOptimize(value.slice().start());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * numElements);
+}
+BENCHMARK(BM_BorrowedArrayIterator);
+
+static void BM_ObjectIterator(benchmark::State& state) {
+  auto const& slice = object();
+  for (auto _ : state) {
+    for (auto pair : ObjectIterator(slice.slice(), true)) {
+      benchmark::DoNotOptimize(pair.value.start());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * numElements);
+}
+BENCHMARK(BM_ObjectIterator);
+
+static void BM_SharedObjectIterator(benchmark::State& state) {
+  auto const& slice = object();
+  for (auto _ : state) {
+    for (auto pair : SharedObjectIterator(slice, true)) {
+      benchmark::DoNotOptimize(pair.value.slice().start());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * numElements);
+}
+BENCHMARK(BM_SharedObjectIterator);
+
+static void BM_BorrowedObjectIterator(benchmark::State& state) {
+  auto const& slice = object();
+  for (auto _ : state) {
+    for (auto pair : BorrowedObjectIterator(slice, true)) {
+      benchmark::DoNotOptimize(pair.value.slice().start());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * numElements);
+}
+BENCHMARK(BM_BorrowedObjectIterator);
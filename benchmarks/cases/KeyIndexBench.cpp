@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+SharedSlice makeObject(int64_t size, bool unindexed) {
+  Builder builder;
+  builder.openObject(unindexed);
+  for (int64_t i = 0; i < size; ++i) {
+    builder.add("attribute" + std::to_string(i), Value(i));
+  }
+  builder.close();
+  return SharedSlice::copyOf(builder.slice());
+}
+
+std::vector<std::string> makeKeys(int64_t size) {
+  auto keys = std::vector<std::string>();
+  for (int64_t i = 0; i < size; ++i) {
+    keys.emplace_back("attribute" + std::to_string((i * 7919) % size));
+  }
+  return keys;
+}
+}  // namespace
+
+// Repeated lookups against the same large object, args are the number of
+// keys and whether the object is compact (unindexed)
+
+static void BM_GetWithoutIndex(benchmark::State& state) {
+  auto const sharedSlice = makeObject(state.range(0), state.range(1) != 0);
+  auto const keys = makeKeys(state.range(0));
+  for (auto _ : state) {
+    for (auto const& key : keys) {
+      benchmark::DoNotOptimize(sharedSlice.get(key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GetWithoutIndex)
+    ->Args({100, 0})
+    ->Args({100, 1})
+    ->Args({1000, 0})
+    ->Args({1000, 1});
+
+static void BM_GetWithIndex(benchmark::State& state) {
+  auto const sharedSlice = makeObject(state.range(0), state.range(1) != 0);
+  sharedSlice.enableKeyIndex();
+  auto const keys = makeKeys(state.range(0));
+  for (auto _ : state) {
+    for (auto const& key : keys) {
+      benchmark::DoNotOptimize(sharedSlice.get(key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GetWithIndex)
+    ->Args({100, 0})
+    ->Args({100, 1})
+    ->Args({1000, 0})
+    ->Args({1000, 1});
@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "velocypack/KeySearch.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+Builder makeCompactObject(int64_t size) {
+  Builder builder;
+  builder.openObject(true);
+  for (int64_t i = 0; i < size; ++i) {
+    builder.add("attribute" + std::to_string(i), Value(i));
+  }
+  builder.close();
+  return builder;
+}
+
+// A key found in the middle of the object
+std::string middleKey(int64_t size) {
+  return "attribute" + std::to_string(size / 2);
+}
+}  // namespace
+
+// Single lookups in compact objects, the arg is the number of keys
+
+static void BM_CompactSliceGet(benchmark::State& state) {
+  auto const builder = makeCompactObject(state.range(0));
+  auto const key = middleKey(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(builder.slice().get(key));
+  }
+}
+BENCHMARK(BM_CompactSliceGet)->Arg(10)->Arg(100)->Arg(10000);
+
+static void BM_CompactFindKey(benchmark::State& state,
+                              KeySearchImplementation implementation) {
+  if (!isSupported(implementation)) {
+    state.SkipWithError("not supported on this CPU");
+    return;
+  }
+  auto const builder = makeCompactObject(state.range(0));
+  auto const key = middleKey(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        findKeyLinear(builder.slice(), StringRef(key), implementation));
+  }
+}
+BENCHMARK_CAPTURE(BM_CompactFindKey, scalar, KeySearchImplementation::scalar)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(10000);
+BENCHMARK_CAPTURE(BM_CompactFindKey, sse2, KeySearchImplementation::sse2)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(10000);
+BENCHMARK_CAPTURE(BM_CompactFindKey, avx2, KeySearchImplementation::avx2)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(10000);
+
+static void BM_CompactSharedSliceGet(benchmark::State& state) {
+  auto const sharedSlice =
+      SharedSlice::copyOf(makeCompactObject(state.range(0)).slice());
+  auto const key = middleKey(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sharedSlice.get(key));
+  }
+}
+BENCHMARK(BM_CompactSharedSliceGet)->Arg(10)->Arg(100)->Arg(10000);
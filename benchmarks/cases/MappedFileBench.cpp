@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "velocypack/MappedFile.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+// A snapshot file of about 64 MiB, removed at exit
+std::string const& snapshotPath() {
+  static auto const path = [] {
+    char name[] = "/tmp/MappedFileBench.XXXXXX";
+    int fd = ::mkstemp(name);
+    ::close(fd);
+    Builder builder;
+    builder.openArray();
+    for (int64_t i = 0; i < (int64_t{1} << 23); ++i) {
+      builder.add(Value(i));
+    }
+    builder.close();
+    auto stream = std::ofstream(name, std::ios::binary | std::ios::trunc);
+    stream.write(reinterpret_cast<char const*>(builder.slice().start()),
+                 static_cast<std::streamsize>(builder.slice().byteSize()));
+    std::atexit([] { ::unlink(snapshotPath().c_str()); });
+    return std::string(name);
+  }();
+  return path;
+}
+
+SharedSlice readFile(std::string const& path) {
+  auto stream = std::ifstream(path, std::ios::binary | std::ios::ate);
+  auto const size = static_cast<std::size_t>(stream.tellg());
+  stream.seekg(0);
+  auto buffer = std::make_shared<Buffer<uint8_t>>(size);
+  stream.read(reinterpret_cast<char*>(buffer->data()),
+              static_cast<std::streamsize>(size));
+  buffer->resetTo(size);
+  return SharedSlice(std::move(buffer));
+}
+}  // namespace
+
+// Time until the first value of a snapshot can be accessed
+
+static void BM_ReadSnapshot(benchmark::State& state) {
+  auto const& path = snapshotPath();
+  for (auto _ : state) {
+    auto sharedSlice = readFile(path);
+    benchmark::DoNotOptimize(sharedSlice.at(0).getInt());
+  }
+}
+BENCHMARK(BM_ReadSnapshot)->Unit(benchmark::kMillisecond);
+
+static void BM_MapSnapshot(benchmark::State& state) {
+  auto const& path = snapshotPath();
+  auto options = MapFileOptions();
+  options.advice = static_cast<MapFileOptions::Advice>(state.range(0));
+  for (auto _ : state) {
+    auto sharedSlice = mapFile(path, options);
+    benchmark::DoNotOptimize(sharedSlice.at(0).getInt());
+  }
+}
+BENCHMARK(BM_MapSnapshot)
+    ->Arg(static_cast<int64_t>(MapFileOptions::Advice::Normal))
+    ->Arg(static_cast<int64_t>(MapFileOptions::Advice::Random))
+    ->Unit(benchmark::kMillisecond);
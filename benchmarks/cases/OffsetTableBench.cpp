@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+SharedSlice makeCompactArray(int64_t size) {
+  Builder builder;
+  builder.openArray(true);
+  for (int64_t i = 0; i < size; ++i) {
+    builder.add(Value(i));
+  }
+  builder.close();
+  return SharedSlice::copyOf(builder.slice());
+}
+}  // namespace
+
+// at(i) for every i of a compact array. The first arg is its length, the
+// second the offset table stride, 0 meaning no table.
+static void BM_CompactArrayAt(benchmark::State& state) {
+  auto const array = makeCompactArray(state.range(0));
+  if (state.range(1) != 0) {
+    array.enableOffsetTables(static_cast<ValueLength>(state.range(1)));
+  }
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(array.at(static_cast<ValueLength>(i)));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CompactArrayAt)
+    ->Args({1000, 0})
+    ->Args({1000, 1})
+    ->Args({1000, 16})
+    ->Args({10000, 0})
+    ->Args({10000, 1})
+    ->Args({10000, 16});
@@ -0,0 +1,232 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "AllocationCounter.h"
+
+#include "velocypack/IntrusivePtr.h"
+#include "velocypack/SharedIterator.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+using namespace arangodb::velocypack::benchmarks;
+
+namespace {
+Builder makeDocument() {
+  Builder builder;
+  builder.openObject();
+  builder.add("_key", Value("12345"));
+  builder.add("value", Value(42));
+  builder.close();
+  return builder;
+}
+
+SharedSlice makeShared(Slice slice) {
+  auto buffer = std::make_shared<Buffer<uint8_t>>();
+  buffer->append(slice.start(), slice.byteSize());
+  return SharedSlice(std::move(buffer));
+}
+
+IntrusiveSharedSlice makeIntrusiveSlice(Slice slice) {
+  auto buffer = allocateIntrusiveBuffer(slice.byteSize());
+  std::memcpy(buffer.get(), slice.start(), slice.byteSize());
+  return IntrusiveSharedSlice(IntrusivePtr<uint8_t const>(std::move(buffer)));
+}
+
+LocalSharedSlice makeLocalSlice(Slice slice) {
+  auto buffer =
+      allocateIntrusiveBuffer<detail::LocalRefCount>(slice.byteSize());
+  std::memcpy(buffer.get(), slice.start(), slice.byteSize());
+  return LocalSharedSlice(
+      LocalOwnership::pointer<uint8_t const>(std::move(buffer)));
+}
+
+template <typename S>
+S make(Slice slice);
+template <>
+SharedSlice make<SharedSlice>(Slice slice) {
+  return makeShared(slice);
+}
+template <>
+IntrusiveSharedSlice make<IntrusiveSharedSlice>(Slice slice) {
+  return makeIntrusiveSlice(slice);
+}
+template <>
+LocalSharedSlice make<LocalSharedSlice>(Slice slice) {
+  return makeLocalSlice(slice);
+}
+}  // namespace
+
+template <typename S>
+static void BM_CopyDestroy(benchmark::State& state) {
+  auto const builder = makeDocument();
+  auto const sharedSlice = make<S>(builder.slice());
+  for (auto _ : state) {
+    auto copy = sharedSlice;
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK_TEMPLATE(BM_CopyDestroy, SharedSlice);
+BENCHMARK_TEMPLATE(BM_CopyDestroy, IntrusiveSharedSlice);
+BENCHMARK_TEMPLATE(BM_CopyDestroy, LocalSharedSlice);
+BENCHMARK_TEMPLATE(BM_CopyDestroy, SharedSlice)->Threads(4);
+BENCHMARK_TEMPLATE(BM_CopyDestroy, IntrusiveSharedSlice)->Threads(4);
+
+template <typename S>
+static void BM_AliasDestroy(benchmark::State& state) {
+  auto const builder = makeDocument();
+  auto const sharedSlice = make<S>(builder.slice());
+  for (auto _ : state) {
+    auto value = sharedSlice.get("value");
+    benchmark::DoNotOptimize(value);
+  }
+}
+BENCHMARK_TEMPLATE(BM_AliasDestroy, SharedSlice);
+BENCHMARK_TEMPLATE(BM_AliasDestroy, IntrusiveSharedSlice);
+BENCHMARK_TEMPLATE(BM_AliasDestroy, LocalSharedSlice);
+
+template <typename S>
+static void BM_ArrayIteration(benchmark::State& state) {
+  Builder builder;
+  builder.openArray();
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    builder.add(Value(i));
+  }
+  builder.close();
+  auto const sharedSlice = make<S>(builder.slice());
+  for (auto _ : state) {
+    for (auto&& value :
+         BasicSharedArrayIterator<typename S::OwnershipPolicyType>(
+             sharedSlice)) {
+      benchmark::DoNotOptimize(value);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_ArrayIteration, SharedSlice)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_ArrayIteration, IntrusiveSharedSlice)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_ArrayIteration, LocalSharedSlice)->Arg(1000);
+
+// Reports the memory needed per live document: the handle itself plus the
+// heap bytes and allocations needed to own a copy of a small document.
+template <typename S, S (*Make)(Slice)>
+static void BM_MemoryPerDocument(benchmark::State& state) {
+  auto const builder = makeDocument();
+  auto const numDocuments = static_cast<std::size_t>(state.range(0));
+  auto documents = std::vector<S>();
+  documents.reserve(numDocuments);
+  std::size_t heapBytes = 0;
+  std::size_t allocations = 0;
+  for (auto _ : state) {
+    auto const bytesBefore = AllocationCounter::bytes();
+    auto const allocationsBefore = AllocationCounter::allocations();
+    for (std::size_t i = 0; i < numDocuments; ++i) {
+      documents.emplace_back(Make(builder.slice()));
+    }
+    heapBytes = AllocationCounter::bytes() - bytesBefore;
+    allocations = AllocationCounter::allocations() - allocationsBefore;
+    state.PauseTiming();
+    documents.clear();
+    state.ResumeTiming();
+  }
+  state.counters["handleBytes"] = static_cast<double>(sizeof(S));
+  state.counters["heapBytesPerDoc"] =
+      static_cast<double>(heapBytes) / numDocuments;
+  state.counters["allocsPerDoc"] =
+      static_cast<double>(allocations) / numDocuments;
+  state.SetItemsProcessed(state.iterations() * numDocuments);
+}
+BENCHMARK_TEMPLATE(BM_MemoryPerDocument, SharedSlice, make<SharedSlice>)
+    ->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_MemoryPerDocument, IntrusiveSharedSlice,
+                   make<IntrusiveSharedSlice>)
+    ->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_MemoryPerDocument, SharedSlice, SharedSlice::copyOf)
+    ->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_MemoryPerDocument, IntrusiveSharedSlice,
+                   IntrusiveSharedSlice::copyOf)
+    ->Arg(1 << 16);
+
+// Default construction and moves only ever touch the None state. Neither may
+// share a cache line between threads, so the throughput per thread should
+// stay flat as the thread count grows.
+template <typename S>
+static void BM_DefaultConstruct(benchmark::State& state) {
+  for (auto _ : state) {
+    auto sharedSlice = S();
+    benchmark::DoNotOptimize(sharedSlice);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_DefaultConstruct, SharedSlice)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_DefaultConstruct, IntrusiveSharedSlice)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+template <typename S>
+static void BM_MoveRoundTrip(benchmark::State& state) {
+  auto const builder = makeDocument();
+  auto sharedSlice = make<S>(builder.slice());
+  for (auto _ : state) {
+    auto moved = S(std::move(sharedSlice));
+    benchmark::DoNotOptimize(moved);
+    sharedSlice = std::move(moved);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_MoveRoundTrip, SharedSlice)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_MoveRoundTrip, IntrusiveSharedSlice)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+// Creates and copies a temporary scalar result, like an expression evaluator
+template <typename S>
+static void BM_ScalarTemporary(benchmark::State& state) {
+  Builder builder;
+  builder.add(Value(3.14));
+  auto const allocationsBefore = AllocationCounter::allocations();
+  for (auto _ : state) {
+    auto result = S::copyOf(builder.slice());
+    auto copy = result;
+    benchmark::DoNotOptimize(copy);
+  }
+  state.counters["allocsPerValue"] =
+      benchmark::Counter(static_cast<double>(AllocationCounter::allocations() -
+                                             allocationsBefore),
+                         benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_TEMPLATE(BM_ScalarTemporary, SharedSlice);
+BENCHMARK_TEMPLATE(BM_ScalarTemporary, IntrusiveSharedSlice);
+BENCHMARK_TEMPLATE(BM_ScalarTemporary, InlineSharedSlice);
@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "velocypack/ParallelTraversal.h"
+#include "velocypack/SharedIterator.h"
+#include "velocypack/SharedSlice.h"
+#include "velocypack/WorkStealingPool.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+SharedSlice makeArray(int64_t size) {
+  Builder builder;
+  builder.openArray();
+  for (int64_t i = 0; i < size; ++i) {
+    builder.openObject();
+    builder.add("value", Value(i));
+    builder.add("name", Value("element" + std::to_string(i)));
+    builder.close();
+  }
+  builder.close();
+  return SharedSlice::copyOf(builder.slice());
+}
+
+// Some work per element: a lookup and a hash
+uint64_t process(Slice element) {
+  return element.get("value").getUInt() ^ element.get("name").hash();
+}
+
+void allCores(benchmark::internal::Benchmark* benchmark) {
+  for (unsigned threads = 1;
+       threads <= std::max(std::thread::hardware_concurrency(), 1u);
+       threads *= 2) {
+    benchmark->Arg(threads);
+  }
+}
+}  // namespace
+
+static void BM_SequentialReduce(benchmark::State& state) {
+  auto const array = makeArray(1000000);
+  for (auto _ : state) {
+    auto sum = uint64_t{0};
+    for (auto it = BorrowedArrayIterator(array); it.valid(); it.next()) {
+      sum += process(it.value().slice());
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * 1000000);
+}
+BENCHMARK(BM_SequentialReduce)->Unit(benchmark::kMillisecond);
+
+// The arg is the number of threads, including the calling one
+static void BM_ParallelReduce(benchmark::State& state) {
+  auto const array = makeArray(1000000);
+  auto pool = WorkStealingPool(state.range(0) - 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(parallelReduce(
+        array, uint64_t{0},
+        [](ValueLength, BorrowedSlice element) {
+          return process(element.slice());
+        },
+        [](uint64_t left, uint64_t right) { return left + right; },
+        ParallelOptions{4096, &pool}));
+  }
+  state.SetItemsProcessed(state.iterations() * 1000000);
+}
+BENCHMARK(BM_ParallelReduce)
+    ->Apply(allCores)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
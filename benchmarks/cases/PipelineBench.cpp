@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "velocypack/Pipeline.h"
+#include "velocypack/SharedIterator.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+SharedSlice makeArray(int64_t size) {
+  Builder builder;
+  builder.openArray();
+  for (int64_t i = 0; i < size; ++i) {
+    builder.openObject();
+    builder.add("id", Value(i));
+    builder.add("even", Value(i % 2 == 0));
+    builder.close();
+  }
+  builder.close();
+  return SharedSlice::copyOf(builder.slice());
+}
+}  // namespace
+
+// Sum of the ids of the even elements among the first half, the arg is the
+// array length
+
+static void BM_MaterializedSteps(benchmark::State& state) {
+  auto const array = makeArray(state.range(0));
+  for (auto _ : state) {
+    auto even = std::vector<SharedSlice>();
+    for (auto it = SharedArrayIterator(array); it.valid(); it.next()) {
+      if (it.value().get("even").isTrue()) {
+        even.emplace_back(it.value());
+      }
+    }
+    auto ids = std::vector<SharedSlice>();
+    for (auto const& element : even) {
+      ids.emplace_back(element.get("id"));
+    }
+    ids.resize(std::min<std::size_t>(ids.size(), state.range(0) / 4));
+    int64_t sum = 0;
+    for (auto const& id : ids) {
+      sum += id.getInt();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MaterializedSteps)->Arg(1000)->Arg(100000);
+
+static void BM_Pipeline(benchmark::State& state) {
+  auto const array = makeArray(state.range(0));
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto id : pipeline::elements(array) |
+                       pipeline::filter([](BorrowedSlice element) {
+                         return element->get("even").isTrue();
+                       }) |
+                       pipeline::transform([](BorrowedSlice element) {
+                         return element->get("id").getInt();
+                       }) |
+                       pipeline::take(state.range(0) / 4)) {
+      sum += id;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Pipeline)->Arg(1000)->Arg(100000);
+
+static void BM_HandWrittenLoop(benchmark::State& state) {
+  auto const array = makeArray(state.range(0));
+  for (auto _ : state) {
+    int64_t sum = 0;
+    int64_t taken = 0;
+    for (auto it = BorrowedArrayIterator(array);
+         it.valid() && taken < state.range(0) / 4; it.next()) {
+      auto const element = it.value();
+      if (element->get("even").isTrue()) {
+        sum += element->get("id").getInt();
+        ++taken;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HandWrittenLoop)->Arg(1000)->Arg(100000);
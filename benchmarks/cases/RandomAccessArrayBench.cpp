@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "velocypack/RandomAccessArray.h"
+#include "velocypack/SharedIterator.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <algorithm>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+SharedSlice makeSortedArray(int64_t size, bool compact) {
+  Builder builder;
+  builder.openArray(compact);
+  for (int64_t i = 0; i < size; ++i) {
+    builder.add(Value(i * 7));
+  }
+  builder.close();
+  return SharedSlice::copyOf(builder.slice());
+}
+}  // namespace
+
+// Searching a sorted array, args are its size and whether it is compact
+
+static void BM_LinearSearch(benchmark::State& state) {
+  auto const array = makeSortedArray(state.range(0), state.range(1) != 0);
+  auto const needle = state.range(0) * 7 / 2;
+  for (auto _ : state) {
+    auto it = BorrowedArrayIterator(array);
+    while (it.valid() && it.value()->getInt() < needle) {
+      it.next();
+    }
+    benchmark::DoNotOptimize(it.index());
+  }
+}
+BENCHMARK(BM_LinearSearch)
+    ->Args({1000, 0})
+    ->Args({1000, 1})
+    ->Args({100000, 0})
+    ->Args({100000, 1});
+
+static void BM_LowerBound(benchmark::State& state) {
+  auto const array =
+      RandomAccessArray(makeSortedArray(state.range(0), state.range(1) != 0));
+  auto const needle = state.range(0) * 7 / 2;
+  for (auto _ : state) {
+    auto it = std::lower_bound(array.begin(), array.end(), needle,
+                               [](BorrowedSlice element, int64_t value) {
+                                 return element->getInt() < value;
+                               });
+    benchmark::DoNotOptimize(it.index());
+  }
+}
+BENCHMARK(BM_LowerBound)
+    ->Args({1000, 0})
+    ->Args({1000, 1})
+    ->Args({100000, 0})
+    ->Args({100000, 1});
+
+// Building the view, which for compact arrays records every offset
+static void BM_RandomAccessArrayConstruct(benchmark::State& state) {
+  auto const array = makeSortedArray(state.range(0), state.range(1) != 0);
+  for (auto _ : state) {
+    auto const view = RandomAccessArray(array);
+    benchmark::DoNotOptimize(view.size());
+  }
+}
+BENCHMARK(BM_RandomAccessArrayConstruct)->Args({100000, 0})->Args({100000, 1});
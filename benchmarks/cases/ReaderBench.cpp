@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "AllocationCounter.h"
+
+#include "velocypack/SharedSlice.h"
+#include "velocypack/SharedSliceReader.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+using namespace arangodb::velocypack::benchmarks;
+
+namespace {
+constexpr std::size_t numDocuments = 100'000;
+
+// Back-to-back small documents, removed at exit
+std::string const& streamPath() {
+  static auto const path = [] {
+    char name[] = "/tmp/ReaderBench.XXXXXX";
+    int fd = ::mkstemp(name);
+    for (std::size_t i = 0; i < numDocuments; ++i) {
+      Builder builder;
+      builder.openObject();
+      builder.add("_key", Value(std::to_string(i)));
+      builder.add("value", Value(i));
+      builder.close();
+      std::ignore =
+          ::write(fd, builder.slice().start(), builder.slice().byteSize());
+    }
+    ::close(fd);
+    std::atexit([] { ::unlink(streamPath().c_str()); });
+    return std::string(name);
+  }();
+  return path;
+}
+}  // namespace
+
+// Reads the stream into a buffer and copies every document out of it
+static void BM_ReadAndCopy(benchmark::State& state) {
+  auto const& path = streamPath();
+  auto buffer = std::vector<uint8_t>(SharedSliceReader::defaultChunkSize);
+  auto const allocationsBefore = AllocationCounter::allocations();
+  for (auto _ : state) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    auto carry = std::size_t{0};
+    ssize_t result;
+    while ((result = ::read(fd, buffer.data() + carry, buffer.size() - carry)) >
+           0) {
+      auto const end = carry + static_cast<std::size_t>(result);
+      auto begin = std::size_t{0};
+      // Documents are small, so the first 9 bytes determine the size
+      while (end - begin >= 9 &&
+             Slice(buffer.data() + begin).byteSize() <= end - begin) {
+        auto document = SharedSlice::copyOf(Slice(buffer.data() + begin));
+        benchmark::DoNotOptimize(document);
+        begin += document.byteSize();
+      }
+      std::copy(buffer.begin() + begin, buffer.begin() + end, buffer.begin());
+      carry = end - begin;
+    }
+    ::close(fd);
+  }
+  state.counters["allocsPerDoc"] =
+      benchmark::Counter(static_cast<double>(AllocationCounter::allocations() -
+                                             allocationsBefore) /
+                             numDocuments,
+                         benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations() * numDocuments);
+}
+BENCHMARK(BM_ReadAndCopy)->Unit(benchmark::kMillisecond);
+
+static void BM_SharedSliceReader(benchmark::State& state) {
+  auto const& path = streamPath();
+  auto const allocationsBefore = AllocationCounter::allocations();
+  for (auto _ : state) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    auto reader = SharedSliceReader(fd);
+    while (auto document = reader.next()) {
+      benchmark::DoNotOptimize(*document);
+    }
+    ::close(fd);
+  }
+  state.counters["allocsPerDoc"] =
+      benchmark::Counter(static_cast<double>(AllocationCounter::allocations() -
+                                             allocationsBefore) /
+                             numDocuments,
+                         benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations() * numDocuments);
+}
+BENCHMARK(BM_SharedSliceReader)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <algorithm>
+#include <thread>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+Builder makeDocument() {
+  Builder builder;
+  builder.openObject();
+  builder.add("_key", Value("schema"));
+  builder.add("version", Value(42));
+  builder.close();
+  return builder;
+}
+
+// One hot document per type, shared by all threads
+template <typename S>
+S const& hotDocument() {
+  static auto const document = S::copyOf(makeDocument().slice());
+  return document;
+}
+
+void allCores(benchmark::internal::Benchmark* benchmark) {
+  for (unsigned threads = 1;
+       threads <= std::max(std::thread::hardware_concurrency(), 1u);
+       threads *= 2) {
+    benchmark->Threads(static_cast<int>(threads));
+  }
+  benchmark->UseRealTime();
+}
+}  // namespace
+
+// Every thread copies the same document, as workers do with a schema or an
+// ACL table. Per-thread throughput should stay flat for ShardedSharedSlice
+// as threads are added, while the single refcount of the others contends.
+template <typename S>
+static void BM_HotCopy(benchmark::State& state) {
+  auto const& document = hotDocument<S>();
+  for (auto _ : state) {
+    auto copy = document;
+    auto version = copy.get("version");
+    benchmark::DoNotOptimize(version.slice().start());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_HotCopy, SharedSlice)->Apply(allCores);
+BENCHMARK_TEMPLATE(BM_HotCopy, IntrusiveSharedSlice)->Apply(allCores);
+BENCHMARK_TEMPLATE(BM_HotCopy, ShardedSharedSlice)->Apply(allCores);
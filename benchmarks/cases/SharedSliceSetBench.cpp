@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "velocypack/SharedSlice.h"
+#include "velocypack/SharedSliceHash.h"
+#include "velocypack/SharedSliceSet.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+std::vector<SharedSlice> makeDocuments(int64_t count) {
+  auto documents = std::vector<SharedSlice>();
+  documents.reserve(count);
+  Builder builder;
+  for (int64_t i = 0; i < count; ++i) {
+    builder.clear();
+    builder.openObject();
+    builder.add("_key", Value(std::to_string(i)));
+    builder.add("value", Value(i % 100));
+    builder.close();
+    documents.emplace_back(SharedSlice::copyOf(builder.slice()));
+  }
+  return documents;
+}
+
+using StdSet =
+    std::unordered_set<SharedSlice, SharedSliceHash, SharedSliceEqual>;
+using FlatSet = SharedSliceSet<>;
+
+void insert(StdSet& set, SharedSlice const& document) { set.insert(document); }
+void insert(FlatSet& set, SharedSlice const& document) { set.insert(document); }
+
+bool contains(StdSet const& set, SharedSlice const& document) {
+  return set.find(document) != set.end();
+}
+bool contains(FlatSet const& set, SharedSlice const& document) {
+  return set.contains(document);
+}
+}  // namespace
+
+// The arg is the number of distinct documents
+
+template <typename Set>
+static void BM_Insert(benchmark::State& state) {
+  auto const documents = makeDocuments(state.range(0));
+  for (auto _ : state) {
+    auto set = Set();
+    for (auto const& document : documents) {
+      insert(set, document);
+    }
+    benchmark::DoNotOptimize(set);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Insert, StdSet)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Insert, FlatSet)->Arg(1000)->Arg(100000);
+
+template <typename Set>
+static void BM_Lookup(benchmark::State& state) {
+  auto const documents = makeDocuments(state.range(0));
+  auto set = Set();
+  for (auto const& document : documents) {
+    insert(set, document);
+  }
+  for (auto _ : state) {
+    for (auto const& document : documents) {
+      benchmark::DoNotOptimize(contains(set, document));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Lookup, StdSet)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Lookup, FlatSet)->Arg(1000)->Arg(100000);
@@ -0,0 +1,250 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AtomicSharedSlice.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+std::atomic<detail::HazardRecord*> hazardRecords{nullptr};
+
+// Every thread keeps the last record it used, so a guard usually doesn't
+// have to search the list
+struct CachedHazardRecord {
+  ~CachedHazardRecord() {
+    if (record != nullptr) {
+      record->active.store(false, std::memory_order_release);
+    }
+  }
+
+  detail::HazardRecord* record = nullptr;
+  bool inUse = false;
+};
+thread_local CachedHazardRecord cachedHazardRecord;
+}  // namespace
+
+detail::HazardRecord* detail::acquireHazardRecord() {
+  auto& cached = cachedHazardRecord;
+  if (cached.record != nullptr && !cached.inUse) {
+    cached.inUse = true;
+    return cached.record;
+  }
+
+  auto* record = hazardRecords.load(std::memory_order_acquire);
+  for (; record != nullptr; record = record->next) {
+    auto expected = false;
+    if (!record->active.load(std::memory_order_relaxed) &&
+        record->active.compare_exchange_strong(expected, true,
+                                               std::memory_order_acquire)) {
+      break;
+    }
+  }
+  if (record == nullptr) {
+    record = new HazardRecord();
+    record->active.store(true, std::memory_order_relaxed);
+    record->next = hazardRecords.load(std::memory_order_relaxed);
+    while (!hazardRecords.compare_exchange_weak(record->next, record,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed)) {
+    }
+  }
+
+  if (cached.record == nullptr) {
+    cached.record = record;
+    cached.inUse = true;
+  }
+  return record;
+}
+
+void detail::releaseHazardRecord(HazardRecord* record) noexcept {
+  record->hazard.store(nullptr, std::memory_order_release);
+  auto& cached = cachedHazardRecord;
+  if (record == cached.record) {
+    cached.inUse = false;
+  } else {
+    record->active.store(false, std::memory_order_release);
+  }
+}
+
+void detail::collectHazards(std::vector<void const*>& hazards) {
+  for (auto* record = hazardRecords.load(std::memory_order_acquire);
+       record != nullptr; record = record->next) {
+    if (auto const* hazard = record->hazard.load(std::memory_order_seq_cst);
+        hazard != nullptr) {
+      hazards.emplace_back(hazard);
+    }
+  }
+}
+
+template <typename OwnershipPolicy>
+BasicAtomicSharedSlice<OwnershipPolicy>::Guard::Guard(
+    detail::HazardRecord* record, SharedSliceType const* value) noexcept
+    : _record(record), _value(value), _slice(value->slice()) {}
+
+template <typename OwnershipPolicy>
+BasicAtomicSharedSlice<OwnershipPolicy>::Guard::Guard(Guard&& other) noexcept
+    : _record(std::exchange(other._record, nullptr)),
+      _value(other._value),
+      _slice(other._slice) {}
+
+template <typename OwnershipPolicy>
+auto BasicAtomicSharedSlice<OwnershipPolicy>::Guard::operator=(
+    Guard&& other) noexcept -> Guard& {
+  if (this != &other) {
+    if (_record != nullptr) {
+      detail::releaseHazardRecord(_record);
+    }
+    _record = std::exchange(other._record, nullptr);
+    _value = other._value;
+    _slice = other._slice;
+  }
+  return *this;
+}
+
+template <typename OwnershipPolicy>
+BasicAtomicSharedSlice<OwnershipPolicy>::Guard::~Guard() {
+  if (_record != nullptr) {
+    detail::releaseHazardRecord(_record);
+  }
+}
+
+template <typename OwnershipPolicy>
+BasicAtomicSharedSlice<OwnershipPolicy>::BasicAtomicSharedSlice(
+    SharedSliceType value)
+    : _current(new SharedSliceType(std::move(value))) {}
+
+template <typename OwnershipPolicy>
+BasicAtomicSharedSlice<OwnershipPolicy>::~BasicAtomicSharedSlice() {
+  delete _current.load(std::memory_order_relaxed);
+  for (auto* retired : _retired) {
+    delete retired;
+  }
+}
+
+template <typename OwnershipPolicy>
+auto BasicAtomicSharedSlice<OwnershipPolicy>::guard() const -> Guard {
+  auto* record = detail::acquireHazardRecord();
+  auto* current = _current.load(std::memory_order_acquire);
+  while (true) {
+    record->hazard.store(current, std::memory_order_seq_cst);
+    // Only if it is still current, the writer that replaced it will see the
+    // hazard before freeing it
+    auto* again = _current.load(std::memory_order_seq_cst);
+    if (again == current) {
+      return Guard(record, current);
+    }
+    current = again;
+  }
+}
+
+template <typename OwnershipPolicy>
+auto BasicAtomicSharedSlice<OwnershipPolicy>::load() const -> SharedSliceType {
+  return guard().get();
+}
+
+template <typename OwnershipPolicy>
+void BasicAtomicSharedSlice<OwnershipPolicy>::store(SharedSliceType value) {
+  auto lock = std::lock_guard(_writeMutex);
+  _retired.emplace_back(swap(std::move(value)));
+  reclaim();
+}
+
+template <typename OwnershipPolicy>
+auto BasicAtomicSharedSlice<OwnershipPolicy>::exchange(SharedSliceType value)
+    -> SharedSliceType {
+  auto lock = std::lock_guard(_writeMutex);
+  auto* previous = swap(std::move(value));
+  // Readers may still guard it, so hand out a copy
+  auto result = *previous;
+  _retired.emplace_back(previous);
+  reclaim();
+  return result;
+}
+
+template <typename OwnershipPolicy>
+bool BasicAtomicSharedSlice<OwnershipPolicy>::compareExchange(
+    SharedSliceType& expected, SharedSliceType desired) {
+  auto lock = std::lock_guard(_writeMutex);
+  // Only writers change it, and we are the only one
+  auto* current = _current.load(std::memory_order_relaxed);
+  if (current->slice().start() != expected.slice().start()) {
+    expected = *current;
+    return false;
+  }
+  _retired.emplace_back(swap(std::move(desired)));
+  reclaim();
+  return true;
+}
+
+template <typename OwnershipPolicy>
+auto BasicAtomicSharedSlice<OwnershipPolicy>::swap(SharedSliceType value)
+    -> SharedSliceType* {
+  auto* replacement = new SharedSliceType(std::move(value));
+  return _current.exchange(replacement, std::memory_order_seq_cst);
+}
+
+template <typename OwnershipPolicy>
+void BasicAtomicSharedSlice<OwnershipPolicy>::reclaim() {
+  auto hazards = std::vector<void const*>();
+  detail::collectHazards(hazards);
+  std::sort(hazards.begin(), hazards.end());
+  auto const reclaimed = [&](SharedSliceType* retired) {
+    if (std::binary_search(hazards.begin(), hazards.end(), retired)) {
+      return false;
+    }
+    delete retired;
+    return true;
+  };
+  _retired.erase(std::remove_if(_retired.begin(), _retired.end(), reclaimed),
+                 _retired.end());
+}
+
+template class arangodb::velocypack::BasicAtomicSharedSlice<SharedPtrOwnership>;
+template class arangodb::velocypack::BasicAtomicSharedSlice<IntrusiveOwnership>;
+
+EpochAtomicSharedSlice::EpochAtomicSharedSlice(SharedSlice value)
+    : _current(new detail::EpochOwner{value.buffer()}) {}
+
+EpochAtomicSharedSlice::~EpochAtomicSharedSlice() {
+  delete _current.load(std::memory_order_relaxed);
+}
+
+EpochSharedSlice EpochAtomicSharedSlice::load(
+    EpochGuard const&) const noexcept {
+  auto const* current = _current.load(std::memory_order_seq_cst);
+  return EpochSharedSlice(
+      EpochSharedSlice::pointer<uint8_t const>(current, current->data.get()));
+}
+
+void EpochAtomicSharedSlice::store(SharedSlice value) {
+  auto replacement = std::make_unique<detail::EpochOwner const>(
+      detail::EpochOwner{value.buffer()});
+  // Once replaced, the old owner must be retired without failing
+  detail::reserveRetired();
+  detail::retire(
+      _current.exchange(replacement.release(), std::memory_order_seq_cst));
+}
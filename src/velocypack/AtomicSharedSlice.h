@@ -0,0 +1,176 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_ATOMICSHAREDSLICE_H
+#define SRC_ATOMICSHAREDSLICE_H
+
+#include "velocypack/EpochPtr.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Slice.h>
+
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace arangodb::velocypack {
+
+namespace detail {
+// A hazard pointer: while a reader has published a pointer in one, writers
+// must not free the object it points to.
+struct HazardRecord {
+  std::atomic<void const*> hazard{nullptr};
+  std::atomic<bool> active{false};
+  HazardRecord* next = nullptr;
+};
+
+// Claims an unused record, creating one if necessary. Records are never
+// freed, there are about as many as threads ever reading at the same time.
+[[nodiscard]] HazardRecord* acquireHazardRecord();
+void releaseHazardRecord(HazardRecord* record) noexcept;
+// Appends all currently published hazard pointers to hazards
+void collectHazards(std::vector<void const*>& hazards);
+}  // namespace detail
+
+/**
+ * @brief Holds a BasicSharedSlice that readers can load while writers replace
+ *        it, e.g. to publish new versions of a configuration document.
+ *
+ *        Readers never block and never wait for writers: they protect the
+ *        current slice with a hazard pointer, so it can't be freed while
+ *        they access it. guard() does not touch the slice's refcount at all,
+ *        load() increments it once to return an owning copy.
+ *        Writers are serialized by a mutex. A replaced slice is freed by the
+ *        writer once no reader guards it any more.
+ */
+template <typename OwnershipPolicy>
+class BasicAtomicSharedSlice {
+  static_assert(!std::is_same_v<OwnershipPolicy, LocalOwnership>,
+                "LocalSharedSlices must not be shared between threads");
+  static_assert(!std::is_same_v<OwnershipPolicy, EpochOwnership>,
+                "EpochSharedSlices must not outlive their EpochGuard, use "
+                "EpochAtomicSharedSlice");
+
+ public:
+  using SharedSliceType = BasicSharedSlice<OwnershipPolicy>;
+
+  // Keeps the slice that was current when it was created alive, without
+  // owning a reference to it. Must be destroyed on the thread that created
+  // it, and shouldn't be held for long, as it delays freeing replaced
+  // slices.
+  class Guard {
+   public:
+    Guard(Guard const&) = delete;
+    Guard& operator=(Guard const&) = delete;
+    Guard(Guard&& other) noexcept;
+    Guard& operator=(Guard&& other) noexcept;
+    ~Guard();
+
+    // Copy it to keep it beyond the guard's lifetime
+    [[nodiscard]] SharedSliceType const& get() const noexcept {
+      return *_value;
+    }
+    [[nodiscard]] Slice slice() const noexcept { return _value->slice(); }
+    Slice const* operator->() const noexcept { return &_slice; }
+
+   private:
+    friend class BasicAtomicSharedSlice;
+    Guard(detail::HazardRecord* record, SharedSliceType const* value) noexcept;
+
+    detail::HazardRecord* _record;
+    SharedSliceType const* _value;
+    Slice _slice;
+  };
+
+  explicit BasicAtomicSharedSlice(SharedSliceType value = SharedSliceType());
+
+  BasicAtomicSharedSlice(BasicAtomicSharedSlice const&) = delete;
+  BasicAtomicSharedSlice& operator=(BasicAtomicSharedSlice const&) = delete;
+
+  // Must not be called while any thread reads or writes
+  ~BasicAtomicSharedSlice();
+
+  [[nodiscard]] Guard guard() const;
+
+  [[nodiscard]] SharedSliceType load() const;
+
+  void store(SharedSliceType value);
+
+  // Stores value, returning the previous one
+  [[nodiscard]] SharedSliceType exchange(SharedSliceType value);
+
+  // Stores desired if the current slice is expected, i.e. points to the same
+  // bytes. Otherwise sets expected to the current slice. Returns whether
+  // desired was stored.
+  bool compareExchange(SharedSliceType& expected, SharedSliceType desired);
+
+ private:
+  // Replaces the current slice. Requires _writeMutex.
+  [[nodiscard]] SharedSliceType* swap(SharedSliceType value);
+  // Frees the retired slices no reader guards. Requires _writeMutex.
+  void reclaim();
+
+ private:
+  std::atomic<SharedSliceType*> _current;
+  std::mutex _writeMutex;
+  std::vector<SharedSliceType*> _retired;
+};
+
+using AtomicSharedSlice = BasicAtomicSharedSlice<SharedPtrOwnership>;
+using IntrusiveAtomicSharedSlice = BasicAtomicSharedSlice<IntrusiveOwnership>;
+
+extern template class BasicAtomicSharedSlice<SharedPtrOwnership>;
+extern template class BasicAtomicSharedSlice<IntrusiveOwnership>;
+
+/**
+ * @brief Like AtomicSharedSlice, but protects readers with epochs instead of
+ *        hazard pointers.
+ *
+ *        load() returns an EpochSharedSlice borrowing the current slice for
+ *        the duration of the EpochGuard: it costs a single atomic load, and
+ *        neither it nor any copy or alias touches a refcount. The slice
+ *        replaced by store() is released once every thread has left the
+ *        critical section it was in. Writers don't block each other.
+ */
+class EpochAtomicSharedSlice {
+ public:
+  explicit EpochAtomicSharedSlice(SharedSlice value = SharedSlice());
+
+  EpochAtomicSharedSlice(EpochAtomicSharedSlice const&) = delete;
+  EpochAtomicSharedSlice& operator=(EpochAtomicSharedSlice const&) = delete;
+
+  // Must not be called while any thread reads or writes
+  ~EpochAtomicSharedSlice();
+
+  // Valid until guard, which must be the calling thread's, ends
+  [[nodiscard]] EpochSharedSlice load(EpochGuard const& guard) const noexcept;
+
+  void store(SharedSlice value);
+
+ private:
+  std::atomic<detail::EpochOwner const*> _current;
+};
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_ATOMICSHAREDSLICE_H
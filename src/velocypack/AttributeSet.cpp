@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AttributeSet.h"
+
+#include "BufferCaches.h"
+
+#include <velocypack/Exception.h>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+AttributeSet::AttributeSet(std::vector<std::string> names)
+    : _names(std::move(names)) {
+  // At most half full
+  auto capacity = std::size_t{2};
+  while (capacity < 2 * _names.size()) {
+    capacity *= 2;
+  }
+  _table.resize(capacity, 0);
+  _hashes.resize(capacity, 0);
+  _mask = capacity - 1;
+
+  for (std::size_t index = 0; index < _names.size(); ++index) {
+    auto const name = StringRef(_names[index]);
+    if (find(name) != npos) {
+      throw Exception(Exception::DuplicateAttributeName);
+    }
+    auto const hash = KeyIndex::hash(name);
+    auto i = hash & _mask;
+    while (_table[i] != 0) {
+      i = (i + 1) & _mask;
+    }
+    _table[i] = static_cast<uint32_t>(index + 1);
+    _hashes[i] = hash;
+  }
+}
+
+std::size_t AttributeSet::find(StringRef name) const noexcept {
+  auto const hash = KeyIndex::hash(name);
+  for (auto i = hash & _mask; _table[i] != 0; i = (i + 1) & _mask) {
+    if (_hashes[i] == hash) {
+      auto const index = _table[i] - 1;
+      if (StringRef(_names[index]).equals(name)) {
+        return index;
+      }
+    }
+  }
+  return npos;
+}
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_ATTRIBUTESET_H
+#define SRC_ATTRIBUTESET_H
+
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+#include <velocypack/StringRef.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace arangodb::velocypack {
+
+/**
+ * @brief A set of attribute names, hashed once, to look up many attributes
+ *        of an object in a single pass. See BasicSharedSlice::getMany().
+ */
+class AttributeSet {
+ public:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  // Throws an Exception if a name occurs twice
+  explicit AttributeSet(std::vector<std::string> names);
+
+  [[nodiscard]] std::size_t size() const noexcept { return _names.size(); }
+
+  [[nodiscard]] std::string const& operator[](
+      std::size_t index) const noexcept {
+    return _names[index];
+  }
+
+  // Returns the index of name, or npos
+  [[nodiscard]] std::size_t find(StringRef name) const noexcept;
+
+  // Writes the value of the i-th attribute in object to results[i], or None
+  // if object has no such attribute. Like Slice::get(), the first of
+  // duplicate keys wins. object must be an object.
+  void getMany(Slice object, Slice* results) const {
+    getMany(object, results, [](Slice value) { return value; });
+  }
+
+  // Same, but writes make(value) to results[i]. T must be default
+  // constructible as None, and have isNone().
+  template <typename T, typename F>
+  void getMany(Slice object, T* results, F&& make) const {
+    for (std::size_t i = 0; i < size(); ++i) {
+      results[i] = T();
+    }
+    auto remaining = size();
+    for (auto it = ObjectIterator(object, true); remaining > 0 && it.valid();
+         it.next()) {
+      auto const key = it.key(true);
+      if (!key.isString()) {
+        continue;
+      }
+      auto const index = find(key.stringRef());
+      // Values in an object are never None, so a None result is a missing one
+      if (index != npos && results[index].isNone()) {
+        results[index] = make(it.value());
+        --remaining;
+      }
+    }
+  }
+
+ private:
+  std::vector<std::string> _names;
+  // Open addressing table of indexes into _names plus one, 0 marks empty
+  std::vector<uint32_t> _table;
+  std::vector<uint32_t> _hashes;
+  std::size_t _mask;
+};
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_ATTRIBUTESET_H
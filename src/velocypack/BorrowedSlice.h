@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_BORROWEDSLICE_H
+#define SRC_BORROWEDSLICE_H
+
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb::velocypack {
+
+/**
+ * @brief A Slice into the buffer of a BasicSharedSlice, without a reference
+ *        of its own. Only valid as long as the BasicSharedSlice it was
+ *        borrowed from lives.
+ *
+ *        Creating and copying it never touches a refcount. Call own() to get
+ *        an owning alias, e.g. to store the value beyond the owner's
+ *        lifetime.
+ */
+template <typename OwnershipPolicy>
+class BasicBorrowedSlice {
+ public:
+  using SharedSliceType = BasicSharedSlice<OwnershipPolicy>;
+
+  BasicBorrowedSlice(SharedSliceType const& owner, Slice slice) noexcept
+      : _owner(&owner), _slice(slice) {}
+
+  [[nodiscard]] Slice slice() const noexcept { return _slice; }
+
+  Slice const* operator->() const noexcept { return &_slice; }
+
+  // Returns another slice into the same buffer, e.g. a member of this one,
+  // borrowed from the same owner
+  [[nodiscard]] BasicBorrowedSlice borrow(Slice slice) const noexcept {
+    return BasicBorrowedSlice(*_owner, slice);
+  }
+
+  // Returns an owning alias of this slice
+  [[nodiscard]] SharedSliceType own() const noexcept {
+    return SharedSliceType(*_owner, _slice);
+  }
+
+ private:
+  SharedSliceType const* _owner;
+  Slice _slice;
+};
+
+using BorrowedSlice = BasicBorrowedSlice<SharedPtrOwnership>;
+using IntrusiveBorrowedSlice = BasicBorrowedSlice<IntrusiveOwnership>;
+using LocalBorrowedSlice = BasicBorrowedSlice<LocalOwnership>;
+using EpochBorrowedSlice = BasicBorrowedSlice<EpochOwnership>;
+using ShardedBorrowedSlice = BasicBorrowedSlice<ShardedOwnership>;
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_BORROWEDSLICE_H
@@ -0,0 +1,196 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "BufferCaches.h"
+
+#include <velocypack/Exception.h>
+#include <velocypack/Iterator.h>
+
+#include <mutex>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+KeyIndex::KeyIndex(std::size_t capacity)
+    : _entries(capacity, Entry{0, 0}), _mask(capacity - 1) {}
+
+uint32_t KeyIndex::hash(StringRef key) noexcept {
+  return static_cast<uint32_t>(
+      VELOCYPACK_HASH(key.data(), key.size(), 0xdeadbeef));
+}
+
+std::unique_ptr<KeyIndex> KeyIndex::build(Slice object) {
+  if (object.byteSize() > UINT32_MAX) {
+    return nullptr;
+  }
+  // At most half full
+  auto capacity = std::size_t{1};
+  while (capacity < 2 * object.length()) {
+    capacity *= 2;
+  }
+  auto index = std::unique_ptr<KeyIndex>(new KeyIndex(capacity));
+
+  for (auto it = ObjectIterator(object, true); it.valid(); it.next()) {
+    auto const key = it.key(false);
+    if (!key.isString()) {
+      return nullptr;
+    }
+    auto const keyRef = key.stringRef();
+    auto const keyHash = hash(keyRef);
+    for (auto i = keyHash & index->_mask;; i = (i + 1) & index->_mask) {
+      auto& entry = index->_entries[i];
+      if (entry.keyOffset == 0) {
+        entry.hash = keyHash;
+        entry.keyOffset = static_cast<uint32_t>(key.start() - object.start());
+        break;
+      }
+      if (entry.hash == keyHash && Slice(object.start() + entry.keyOffset)
+                                       .isEqualStringUnchecked(keyRef)) {
+        // Duplicate key, keep the first one
+        break;
+      }
+    }
+  }
+  return index;
+}
+
+Slice KeyIndex::get(Slice object, StringRef key,
+                    uint32_t keyHash) const noexcept {
+  for (auto i = keyHash & _mask;; i = (i + 1) & _mask) {
+    auto const& entry = _entries[i];
+    if (entry.keyOffset == 0) {
+      return Slice();
+    }
+    if (entry.hash == keyHash) {
+      auto const candidate = Slice(object.start() + entry.keyOffset);
+      if (candidate.isEqualStringUnchecked(key)) {
+        return Slice(candidate.start() + candidate.byteSize());
+      }
+    }
+  }
+}
+
+OffsetTable::OffsetTable(ValueLength length, ValueLength stride, bool isObject)
+    : _length(length), _stride(stride), _isObject(isObject) {}
+
+std::unique_ptr<OffsetTable> OffsetTable::build(Slice compact,
+                                                ValueLength stride) {
+  if (compact.byteSize() > UINT32_MAX) {
+    return nullptr;
+  }
+  auto const isObject = compact.head() == 0x14;
+  auto table = std::unique_ptr<OffsetTable>(
+      new OffsetTable(compact.length(), stride, isObject));
+  table->_checkpoints.reserve(
+      static_cast<std::size_t>((table->_length + stride - 1) / stride));
+
+  auto const record = [&](ValueLength index, Slice member) {
+    if (index % stride == 0) {
+      table->_checkpoints.emplace_back(
+          static_cast<uint32_t>(member.start() - compact.start()));
+    }
+  };
+  auto index = ValueLength{0};
+  if (isObject) {
+    for (auto it = ObjectIterator(compact, true); it.valid();
+         it.next(), ++index) {
+      record(index, it.key(false));
+    }
+  } else {
+    for (auto it = ArrayIterator(compact); it.valid(); it.next(), ++index) {
+      record(index, it.value());
+    }
+  }
+  return table;
+}
+
+Slice OffsetTable::member(Slice compact, ValueLength index) const {
+  if (index >= _length) {
+    throw Exception(Exception::IndexOutOfBounds);
+  }
+  auto member = Slice(compact.start() + _checkpoints[index / _stride]);
+  for (auto steps = index % _stride; steps > 0; --steps) {
+    member = Slice(member.start() + member.byteSize());
+    if (_isObject) {
+      // Skip the value, too
+      member = Slice(member.start() + member.byteSize());
+    }
+  }
+  return member;
+}
+
+KeyIndex const* BufferCaches::keyIndex(Slice object) {
+  if (auto const* index = _keyIndexes.find(object.start()); index != nullptr) {
+    return index->get();
+  }
+  // Build it without holding the lock, other readers may race us to it
+  auto index = KeyIndex::build(object);
+  auto lock = std::lock_guard(_mutex);
+  return _keyIndexes.insert(object.start(), std::move(index)).get();
+}
+
+OffsetTable const* BufferCaches::offsetTable(Slice compact) {
+  if (auto const* table = _offsetTables.find(compact.start());
+      table != nullptr) {
+    return table->get();
+  }
+  // Build it without holding the lock, other readers may race us to it
+  auto table = OffsetTable::build(compact, offsetTableStride());
+  auto lock = std::lock_guard(_mutex);
+  return _offsetTables.insert(compact.start(), std::move(table)).get();
+}
+
+std::optional<uint64_t> BufferCaches::cachedHash(Slice value, HashKind kind,
+                                                 uint64_t seed) const {
+  if (auto const* hash = _hashes.find(HashKey{value.start(), seed, kind});
+      hash != nullptr) {
+    return *hash;
+  }
+  return std::nullopt;
+}
+
+void BufferCaches::storeHash(Slice value, HashKind kind, uint64_t seed,
+                             uint64_t hash) {
+  auto lock = std::lock_guard(_mutex);
+  _hashes.insert(HashKey{value.start(), seed, kind}, hash);
+}
+
+std::size_t BufferCaches::HashKeyHash::operator()(
+    HashKey const& key) const noexcept {
+  auto const pointer = reinterpret_cast<std::uintptr_t>(key.start);
+  // Values are rarely hashed with different seeds, the pointer is what
+  // tells keys apart
+  return detail::mixAddress(pointer ^ (key.seed * 31) ^
+                            (static_cast<std::uintptr_t>(key.kind) << 1));
+}
+
+BufferCaches& detail::LazyBufferCaches::get() const {
+  auto* caches = _caches.load(std::memory_order_acquire);
+  if (caches == nullptr) {
+    auto created = std::make_unique<BufferCaches>();
+    if (_caches.compare_exchange_strong(caches, created.get(),
+                                        std::memory_order_acq_rel)) {
+      caches = created.release();
+    }
+  }
+  return *caches;
+}
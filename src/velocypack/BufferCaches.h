@@ -0,0 +1,344 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_BUFFERCACHES_H
+#define SRC_BUFFERCACHES_H
+
+#include <velocypack/Slice.h>
+#include <velocypack/StringRef.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace arangodb::velocypack {
+
+// Maps the keys of one object to their values via a hash of the key bytes.
+// Immutable once built.
+class KeyIndex {
+ public:
+  // Smaller objects are cheap enough to scan
+  static constexpr ValueLength minObjectLength = 16;
+
+  // Returns nullptr if the object cannot be indexed, e.g. because it has
+  // non-string keys
+  [[nodiscard]] static std::unique_ptr<KeyIndex> build(Slice object);
+
+  // Returns the value of key in object, which must be the object this index
+  // was built for, or a None slice if there is no such key. Like Slice::get(),
+  // the first of duplicate keys wins.
+  [[nodiscard]] Slice get(Slice object, StringRef key) const noexcept {
+    return get(object, key, hash(key));
+  }
+  // Same, with keyHash == hash(key) computed in advance
+  [[nodiscard]] Slice get(Slice object, StringRef key,
+                          uint32_t keyHash) const noexcept;
+
+  [[nodiscard]] static uint32_t hash(StringRef key) noexcept;
+
+ private:
+  struct Entry {
+    uint32_t hash;
+    // Offset of the key in the object. 0 marks an empty entry, as it is the
+    // object's head.
+    uint32_t keyOffset;
+  };
+
+  explicit KeyIndex(std::size_t capacity);
+
+ private:
+  std::vector<Entry> _entries;
+  std::size_t _mask;
+};
+
+// Records the position of every stride-th member of a compact array or
+// object, which have no index table, so that finding the n-th member takes
+// at most stride - 1 steps instead of n. Immutable once built.
+class OffsetTable {
+ public:
+  // Smaller ones are cheap enough to scan
+  static constexpr ValueLength minLength = 16;
+
+  [[nodiscard]] static bool isCompact(Slice slice) noexcept {
+    return slice.head() == 0x13 || slice.head() == 0x14;
+  }
+
+  // compact must be a compact array or object. Returns nullptr if it is too
+  // large for 32 bit offsets.
+  [[nodiscard]] static std::unique_ptr<OffsetTable> build(Slice compact,
+                                                          ValueLength stride);
+
+  [[nodiscard]] ValueLength length() const noexcept { return _length; }
+
+  // Returns the index-th element of compact, or its index-th key if it is an
+  // object. compact must be the slice this table was built for. Throws an
+  // Exception if index is out of bounds.
+  [[nodiscard]] Slice member(Slice compact, ValueLength index) const;
+
+ private:
+  OffsetTable(ValueLength length, ValueLength stride, bool isObject);
+
+ private:
+  std::vector<uint32_t> _checkpoints;
+  ValueLength _length;
+  ValueLength _stride;
+  bool _isObject;
+};
+
+namespace detail {
+/**
+ * @brief Insert-only hash map whose lookups take no lock: each entry, and
+ *        each table of slots, is built first and then published through an
+ *        atomic pointer that find() loads with acquire.
+ *
+ *        Inserting requires a mutex held by the owner. Entries and outgrown
+ *        tables are kept until the map is destroyed, so a concurrent find()
+ *        never reads freed memory.
+ */
+template <typename Key, typename Value, typename Hash>
+class PublishedMap {
+ public:
+  PublishedMap() = default;
+  PublishedMap(PublishedMap const&) = delete;
+  PublishedMap& operator=(PublishedMap const&) = delete;
+
+  // Returns nullptr if there is no entry for key (yet)
+  [[nodiscard]] Value const* find(Key const& key) const noexcept {
+    auto const* table = _table.load(std::memory_order_acquire);
+    if (table == nullptr) {
+      return nullptr;
+    }
+    for (auto i = Hash{}(key)&table->mask;; i = (i + 1) & table->mask) {
+      auto const* entry = table->slots[i].load(std::memory_order_acquire);
+      if (entry == nullptr) {
+        return nullptr;
+      }
+      if (entry->first == key) {
+        return &entry->second;
+      }
+    }
+  }
+
+  // Requires the owner's mutex. Keeps the value of an existing entry.
+  Value const& insert(Key const& key, Value value) {
+    if (auto const* existing = find(key); existing != nullptr) {
+      return *existing;
+    }
+    if (_tables.empty() ||
+        2 * (_entries.size() + 1) > _tables.back()->slots.size()) {
+      grow();
+    }
+    auto const* entry =
+        _entries.emplace_back(std::make_unique<Entry>(key, std::move(value)))
+            .get();
+    publish(*_tables.back(), entry);
+    return entry->second;
+  }
+
+ private:
+  using Entry = std::pair<Key const, Value>;
+
+  struct Table {
+    explicit Table(std::size_t capacity)
+        : slots(capacity), mask(capacity - 1) {}
+
+    std::vector<std::atomic<Entry const*>> slots;
+    std::size_t mask;
+  };
+
+  static void publish(Table& table, Entry const* entry) noexcept {
+    for (auto i = Hash{}(entry->first) & table.mask;;
+         i = (i + 1) & table.mask) {
+      if (table.slots[i].load(std::memory_order_relaxed) == nullptr) {
+        table.slots[i].store(entry, std::memory_order_release);
+        return;
+      }
+    }
+  }
+
+  // At most half full
+  void grow() {
+    auto const capacity =
+        _tables.empty() ? minCapacity : 2 * _tables.back()->slots.size();
+    auto table = std::make_unique<Table>(capacity);
+    for (auto const& entry : _entries) {
+      publish(*table, entry.get());
+    }
+    _table.store(table.get(), std::memory_order_release);
+    _tables.emplace_back(std::move(table));
+  }
+
+  static constexpr std::size_t minCapacity = 16;
+
+  std::atomic<Table const*> _table{nullptr};
+  // The last one is current
+  std::vector<std::unique_ptr<Table>> _tables;
+  std::vector<std::unique_ptr<Entry const>> _entries;
+};
+
+// Spreads addresses, which share their low bits, over a table's slots
+[[nodiscard]] inline std::size_t mixAddress(std::uintptr_t address) noexcept {
+  auto const mixed = static_cast<uint64_t>(address) * 0x9e3779b97f4a7c15ULL;
+  return static_cast<std::size_t>(mixed ^ (mixed >> 32));
+}
+
+struct AddressHash {
+  std::size_t operator()(uint8_t const* start) const noexcept {
+    return mixAddress(reinterpret_cast<std::uintptr_t>(start));
+  }
+};
+}  // namespace detail
+
+/**
+ * @brief Lazily computed data about the values in one buffer, shared by all
+ *        slices into it and destroyed with it.
+ *
+ *        Entries are keyed by the address of a value and never invalidated,
+ *        so bytes of a buffer that were handed out in a slice must never be
+ *        rewritten while the buffer lives (see SharedSliceArena and
+ *        SharedSliceReader, which move on to a new chunk instead).
+ *
+ *        Thread-safe. Lookups take no lock, see detail::PublishedMap; the
+ *        mutex only serializes inserting what was built.
+ */
+class BufferCaches {
+ public:
+  // Makes get() and hasKey() on objects in this buffer use a KeyIndex
+  void enableKeyIndex() noexcept {
+    _keyIndexEnabled.store(true, std::memory_order_relaxed);
+  }
+  [[nodiscard]] bool keyIndexEnabled() const noexcept {
+    return _keyIndexEnabled.load(std::memory_order_relaxed);
+  }
+
+  // Returns the index of object, which must point into this buffer, building
+  // it on first use. Returns nullptr if the object cannot be indexed.
+  [[nodiscard]] KeyIndex const* keyIndex(Slice object);
+
+  enum class HashKind : uint8_t {
+    hash,
+    hash32,
+    hashSlow,
+    normalizedHash,
+    normalizedHash32
+  };
+
+  // Hashing smaller values is cheaper than looking them up
+  static constexpr ValueLength minMemoizedHashBytes = 64;
+
+  // Makes the hash functions of slices into this buffer remember their
+  // results, keyed by value, hash kind and seed
+  void enableHashCache() noexcept {
+    _hashCacheEnabled.store(true, std::memory_order_relaxed);
+  }
+  [[nodiscard]] bool hashCacheEnabled() const noexcept {
+    return _hashCacheEnabled.load(std::memory_order_relaxed);
+  }
+
+  // Makes random access into compact arrays and objects in this buffer use an
+  // OffsetTable with the given stride, built on first access. 1 records
+  // every member; larger strides use less memory at the cost of up to
+  // stride - 1 steps per access. Changing the stride affects only tables
+  // built afterwards.
+  void enableOffsetTables(ValueLength stride) noexcept {
+    _offsetTableStride.store(stride == 0 ? 1 : stride,
+                             std::memory_order_relaxed);
+  }
+  // 0 if offset tables are disabled
+  [[nodiscard]] ValueLength offsetTableStride() const noexcept {
+    return _offsetTableStride.load(std::memory_order_relaxed);
+  }
+
+  // Returns the offset table of compact, which must be a compact array or
+  // object in this buffer, building it on first use. Returns nullptr if it
+  // cannot have one.
+  [[nodiscard]] OffsetTable const* offsetTable(Slice compact);
+
+  // value must point into this buffer
+  [[nodiscard]] std::optional<uint64_t> cachedHash(Slice value, HashKind kind,
+                                                   uint64_t seed) const;
+  void storeHash(Slice value, HashKind kind, uint64_t seed, uint64_t hash);
+
+ private:
+  struct HashKey {
+    uint8_t const* start;
+    uint64_t seed;
+    HashKind kind;
+
+    bool operator==(HashKey const& other) const noexcept {
+      return start == other.start && seed == other.seed && kind == other.kind;
+    }
+  };
+  struct HashKeyHash {
+    std::size_t operator()(HashKey const& key) const noexcept;
+  };
+
+ private:
+  std::atomic<bool> _keyIndexEnabled{false};
+  std::atomic<bool> _hashCacheEnabled{false};
+  std::atomic<ValueLength> _offsetTableStride{0};
+  std::mutex _mutex;
+  // By object start. nullptr for objects that cannot be indexed.
+  detail::PublishedMap<uint8_t const*, std::unique_ptr<KeyIndex const>,
+                       detail::AddressHash>
+      _keyIndexes;
+  detail::PublishedMap<HashKey, uint64_t, HashKeyHash> _hashes;
+  // By array or object start. nullptr for ones that cannot have a table.
+  detail::PublishedMap<uint8_t const*, std::unique_ptr<OffsetTable const>,
+                       detail::AddressHash>
+      _offsetTables;
+};
+
+namespace detail {
+// A BufferCaches created by the first get(). Readers use peek(), which never
+// allocates, so buffers without an enabled cache pay nothing for it. Copies
+// start out empty, so they must not be made after the first get().
+class LazyBufferCaches {
+ public:
+  LazyBufferCaches() noexcept = default;
+  LazyBufferCaches(LazyBufferCaches const&) noexcept {}
+  LazyBufferCaches& operator=(LazyBufferCaches const&) = delete;
+  ~LazyBufferCaches() { delete _caches.load(std::memory_order_acquire); }
+
+  [[nodiscard]] BufferCaches& get() const;
+  // nullptr until the first get()
+  [[nodiscard]] BufferCaches* peek() const noexcept {
+    return _caches.load(std::memory_order_acquire);
+  }
+
+ private:
+  mutable std::atomic<BufferCaches*> _caches{nullptr};
+};
+
+[[nodiscard]] inline BufferCaches* peekCaches(
+    LazyBufferCaches const* caches) noexcept {
+  return caches == nullptr ? nullptr : caches->peek();
+}
+}  // namespace detail
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_BUFFERCACHES_H
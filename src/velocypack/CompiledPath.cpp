@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CompiledPath.h"
+
+#include <velocypack/Exception.h>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+CompiledPath::CompiledPath(std::vector<std::string> attributes) {
+  if (attributes.empty()) {
+    throw Exception(Exception::InvalidAttributePath);
+  }
+  _components.reserve(attributes.size());
+  for (auto& attribute : attributes) {
+    auto const hash = KeyIndex::hash(StringRef(attribute));
+    _components.emplace_back(Component{std::move(attribute), hash});
+  }
+}
+
+CompiledPath CompiledPath::parse(StringRef path) {
+  auto attributes = std::vector<std::string>();
+  auto const* begin = path.data();
+  auto const* const end = path.data() + path.size();
+  for (auto const* it = begin; it != end; ++it) {
+    if (*it == '.') {
+      attributes.emplace_back(begin, it);
+      begin = it + 1;
+    }
+  }
+  attributes.emplace_back(begin, end);
+  return CompiledPath(std::move(attributes));
+}
+
+Slice CompiledPath::get(Slice document) const {
+  return resolve(document, nullptr);
+}
+
+Slice CompiledPath::resolve(Slice document, BufferCaches* caches) const {
+  auto const useIndex = caches != nullptr && caches->keyIndexEnabled();
+  auto current = document;
+  for (auto const& component : _components) {
+    if (!current.isObject()) {
+      return Slice();
+    }
+    auto const key = StringRef(component.name.data(), component.name.size());
+    KeyIndex const* index = nullptr;
+    if (useIndex && current.length() >= KeyIndex::minObjectLength) {
+      index = caches->keyIndex(current);
+    }
+    current = index != nullptr ? index->get(current, key, component.hash)
+                               : current.get(key);
+    if (current.isExternal()) {
+      current = current.resolveExternal();
+    }
+  }
+  return current;
+}
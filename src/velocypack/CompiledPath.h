@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_COMPILEDPATH_H
+#define SRC_COMPILEDPATH_H
+
+#include "velocypack/BorrowedSlice.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Slice.h>
+#include <velocypack/StringRef.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace arangodb::velocypack {
+
+/**
+ * @brief An attribute path like `user.address.city`, prepared once to be
+ *        looked up in many documents.
+ *
+ *        The components are measured and hashed in advance, the latter for
+ *        buffers with a key index (see BasicSharedSlice::enableKeyIndex()).
+ *        Lookups never allocate.
+ *
+ *        Resolves like Slice::get(std::vector<std::string> const&), except
+ *        that a document which isn't an object yields None instead of
+ *        throwing.
+ */
+class CompiledPath {
+ public:
+  // Throws an Exception if attributes is empty
+  explicit CompiledPath(std::vector<std::string> attributes);
+
+  // Splits path at each '.'
+  [[nodiscard]] static CompiledPath parse(StringRef path);
+
+  [[nodiscard]] std::size_t size() const noexcept { return _components.size(); }
+
+  // Returns the value at this path, or None
+  [[nodiscard]] Slice get(Slice document) const;
+
+  // Returns an alias of the value at this path, or None
+  template <typename OwnershipPolicy>
+  [[nodiscard]] BasicSharedSlice<OwnershipPolicy> get(
+      BasicSharedSlice<OwnershipPolicy> const& document) const {
+    return BasicSharedSlice<OwnershipPolicy>(document, resolve(document));
+  }
+
+  // Returns the value at this path, or None, borrowed from document
+  template <typename OwnershipPolicy>
+  [[nodiscard]] BasicBorrowedSlice<OwnershipPolicy> borrow(
+      BasicSharedSlice<OwnershipPolicy> const& document) const {
+    return BasicBorrowedSlice<OwnershipPolicy>(document, resolve(document));
+  }
+
+  // Writes get(documents[i]) to results[i] for each of the count documents
+  template <typename OwnershipPolicy>
+  void get(BasicSharedSlice<OwnershipPolicy> const* documents,
+           std::size_t count,
+           BasicSharedSlice<OwnershipPolicy>* results) const {
+    for (std::size_t i = 0; i < count; ++i) {
+      results[i] = get(documents[i]);
+    }
+  }
+
+ private:
+  struct Component {
+    std::string name;
+    uint32_t hash;
+  };
+
+  template <typename OwnershipPolicy>
+  [[nodiscard]] Slice resolve(
+      BasicSharedSlice<OwnershipPolicy> const& document) const {
+    return resolve(document.slice(), detail::peekCaches(OwnershipPolicy::caches(
+                                         document.buffer())));
+  }
+
+  // Uses the key index of caches, if not nullptr and enabled
+  [[nodiscard]] Slice resolve(Slice document, BufferCaches* caches) const;
+
+ private:
+  std::vector<Component> _components;
+};
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_COMPILEDPATH_H
@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "EpochPtr.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+// One per thread that ever entered a critical section. Records are reused
+// by later threads, but never freed.
+struct EpochRecord {
+  // The epoch the thread's critical section started in, 0 outside of one
+  std::atomic<uint64_t> epoch{0};
+  std::atomic<bool> active{false};
+  EpochRecord* next = nullptr;
+};
+
+std::atomic<EpochRecord*> epochRecords{nullptr};
+
+// Advanced by every reclamation. An owner retired in epoch e can't be seen
+// by critical sections that started in a later epoch.
+std::atomic<uint64_t> globalEpoch{1};
+
+struct Retired {
+  uint64_t epoch;
+  detail::EpochOwner const* owner;
+};
+
+// Deletes all owners retired before oldest, keeps the others. Returns the
+// number of deleted owners.
+std::size_t deleteRetiredBefore(std::vector<Retired>& retired,
+                                uint64_t oldest) {
+  auto const kept =
+      std::partition(retired.begin(), retired.end(), [&](Retired const& entry) {
+        return entry.epoch >= oldest;
+      });
+  auto const deleted = static_cast<std::size_t>(retired.end() - kept);
+  std::for_each(kept, retired.end(),
+                [](Retired const& entry) { delete entry.owner; });
+  retired.erase(kept, retired.end());
+  return deleted;
+}
+
+// What exited threads retired but couldn't delete yet
+struct Orphans {
+  ~Orphans() {
+    // No critical sections are left at static destruction
+    deleteRetiredBefore(retired, std::numeric_limits<uint64_t>::max());
+  }
+
+  std::mutex mutex;
+  std::vector<Retired> retired;
+};
+Orphans orphans;
+
+EpochRecord* acquireRecord() {
+  auto* record = epochRecords.load(std::memory_order_acquire);
+  for (; record != nullptr; record = record->next) {
+    auto expected = false;
+    if (!record->active.load(std::memory_order_relaxed) &&
+        record->active.compare_exchange_strong(expected, true,
+                                               std::memory_order_acquire)) {
+      return record;
+    }
+  }
+  record = new EpochRecord();
+  record->active.store(true, std::memory_order_relaxed);
+  record->next = epochRecords.load(std::memory_order_relaxed);
+  while (!epochRecords.compare_exchange_weak(record->next, record,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+  }
+  return record;
+}
+
+// The epoch of the oldest critical section of any thread, or the maximum if
+// there is none
+uint64_t oldestEpoch() noexcept {
+  auto oldest = std::numeric_limits<uint64_t>::max();
+  for (auto* record = epochRecords.load(std::memory_order_acquire);
+       record != nullptr; record = record->next) {
+    if (auto const epoch = record->epoch.load(std::memory_order_seq_cst);
+        epoch != 0) {
+      oldest = std::min(oldest, epoch);
+    }
+  }
+  return oldest;
+}
+
+constexpr std::size_t minReclaimThreshold = 64;
+
+struct ThreadState {
+  ~ThreadState() {
+    if (record != nullptr) {
+      record->active.store(false, std::memory_order_release);
+    }
+    if (!retired.empty()) {
+      auto lock = std::lock_guard(orphans.mutex);
+      orphans.retired.insert(orphans.retired.end(), retired.begin(),
+                             retired.end());
+    }
+  }
+
+  EpochRecord* record = nullptr;
+  std::size_t depth = 0;
+  std::vector<Retired> retired;
+  // Reclaim once this many owners are retired, so owners still guarded by
+  // long critical sections aren't scanned over and over
+  std::size_t reclaimThreshold = minReclaimThreshold;
+};
+thread_local ThreadState threadState;
+}  // namespace
+
+EpochGuard::EpochGuard() {
+  auto& state = threadState;
+  if (state.depth++ == 0) {
+    if (state.record == nullptr) {
+      state.record = acquireRecord();
+    }
+    // Must be visible to reclaiming threads before this thread reads any
+    // pointer they could retire
+    state.record->epoch.store(globalEpoch.load(std::memory_order_seq_cst),
+                              std::memory_order_seq_cst);
+  }
+}
+
+EpochGuard::~EpochGuard() {
+  auto& state = threadState;
+  if (--state.depth == 0) {
+    state.record->epoch.store(0, std::memory_order_release);
+  }
+}
+
+bool velocypack::inEpoch() noexcept { return threadState.depth > 0; }
+
+void detail::reserveRetired() {
+  auto& retired = threadState.retired;
+  if (retired.size() == retired.capacity()) {
+    retired.reserve(std::max(minReclaimThreshold, 2 * retired.capacity()));
+  }
+}
+
+void detail::retire(EpochOwner const* owner) noexcept {
+  auto& state = threadState;
+  state.retired.push_back({globalEpoch.load(std::memory_order_seq_cst), owner});
+  if (state.retired.size() >= state.reclaimThreshold) {
+    reclaimEpochs();
+  }
+}
+
+std::size_t velocypack::reclaimEpochs() noexcept {
+  auto& state = threadState;
+  globalEpoch.fetch_add(1, std::memory_order_seq_cst);
+  auto const oldest = oldestEpoch();
+  auto deleted = deleteRetiredBefore(state.retired, oldest);
+  if (auto lock = std::unique_lock(orphans.mutex, std::try_to_lock);
+      lock.owns_lock() && !orphans.retired.empty()) {
+    deleted += deleteRetiredBefore(orphans.retired, oldest);
+  }
+  state.reclaimThreshold =
+      std::max(minReclaimThreshold, 2 * state.retired.size());
+  return deleted;
+}
@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_EPOCHPTR_H
+#define SRC_EPOCHPTR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace arangodb::velocypack {
+
+namespace detail {
+// The reference an EpochPtr borrows. Retired to the epoch domain instead of
+// deleted, so it outlives every read-side critical section that could see it.
+struct EpochOwner {
+  std::shared_ptr<uint8_t const> data;
+};
+
+// Makes sure the next retire() of the calling thread doesn't allocate
+void reserveRetired();
+// Deletes owner once every thread that is in a read-side critical section
+// now has left it. Call reserveRetired() first.
+void retire(EpochOwner const* owner) noexcept;
+}  // namespace detail
+
+/**
+ * @brief Marks a read-side critical section of the calling thread.
+ *
+ *        EpochPtrs (and so EpochSharedSlices) created in it stay valid until
+ *        it ends; the buffers they point to are released only after every
+ *        thread has left the critical section it was in when they were
+ *        retired. Guards may be nested, only the outermost one counts.
+ *
+ *        Entering costs a store to a cache line owned by the calling thread,
+ *        but no atomic read-modify-write on shared data. Long critical
+ *        sections delay the release of all retired buffers.
+ */
+class EpochGuard {
+ public:
+  EpochGuard();
+  ~EpochGuard();
+
+  EpochGuard(EpochGuard const&) = delete;
+  EpochGuard& operator=(EpochGuard const&) = delete;
+};
+
+// Whether the calling thread is in a read-side critical section
+[[nodiscard]] bool inEpoch() noexcept;
+
+// Deletes everything the calling thread retired (and what exited threads
+// left behind) that no critical section can see any more. Returns the number
+// of owners deleted. Called automatically every so many retirements.
+std::size_t reclaimEpochs() noexcept;
+
+/**
+ * @brief A shared_ptr-like pointer that doesn't count references at all.
+ *
+ *        It borrows the std::shared_ptr of a detail::EpochOwner, which the
+ *        epoch domain keeps alive during the read-side critical section the
+ *        pointer was created in. Copying or aliasing one is as cheap as
+ *        copying a raw pointer; in exchange, it must not be used after that
+ *        critical section ended, nor by another thread.
+ *
+ *        use_count() reports the references of the borrowed shared_ptr.
+ */
+template <typename T>
+class EpochPtr {
+ public:
+  using element_type = T;
+
+  constexpr EpochPtr() noexcept = default;
+  EpochPtr(detail::EpochOwner const* owner, T* ptr) noexcept
+      : _ptr(ptr), _owner(owner) {}
+
+  // Aliasing constructor
+  template <typename U>
+  EpochPtr(EpochPtr<U> const& other, T* ptr) noexcept
+      : _ptr(ptr), _owner(other._owner) {}
+
+  // Converting constructor
+  template <typename U,
+            typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  EpochPtr(
+      EpochPtr<U> const& other) noexcept  // NOLINT(google-explicit-constructor)
+      : _ptr(other._ptr), _owner(other._owner) {}
+
+  [[nodiscard]] T* get() const noexcept { return _ptr; }
+
+  template <typename U = T>
+  [[nodiscard]] U& operator*() const noexcept {
+    return *_ptr;
+  }
+
+  T* operator->() const noexcept { return _ptr; }
+
+  [[nodiscard]] long use_count() const noexcept {
+    return _owner == nullptr ? 0 : _owner->data.use_count();
+  }
+
+  explicit operator bool() const noexcept { return _ptr != nullptr; }
+
+  // The owner this pointer borrows from, if any
+  [[nodiscard]] detail::EpochOwner const* owner() const noexcept {
+    return _owner;
+  }
+
+ private:
+  template <typename>
+  friend class EpochPtr;
+
+  T* _ptr = nullptr;
+  detail::EpochOwner const* _owner = nullptr;
+};
+
+template <typename T, typename U>
+bool operator==(EpochPtr<T> const& left, EpochPtr<U> const& right) noexcept {
+  return left.get() == right.get();
+}
+
+template <typename T, typename U>
+bool operator!=(EpochPtr<T> const& left, EpochPtr<U> const& right) noexcept {
+  return left.get() != right.get();
+}
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_EPOCHPTR_H
@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_INLINEPTR_H
+#define SRC_INLINEPTR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace arangodb::velocypack {
+
+/**
+ * @brief A std::shared_ptr that stores small payloads in itself instead.
+ *
+ *        In inline mode, up to inlineCapacity bytes live inside the pointer
+ *        object, and get() points into them. Copying such a pointer copies
+ *        the bytes and touches no refcount; use_count() is 0, as nothing is
+ *        shared. Otherwise it behaves like the std::shared_ptr it holds.
+ *
+ *        Aliasing an inline pointer copies its bytes, and points at the same
+ *        offset in the copy. Aliasing it with a pointer outside of its bytes
+ *        results in a pointer that owns nothing.
+ *
+ *        Unlike with a std::shared_ptr, get() of an inline pointer changes
+ *        when the pointer is copied or moved: raw pointers obtained from it
+ *        are only valid as long as the InlinePtr itself lives, unmoved.
+ */
+template <typename T>
+class InlinePtr {
+ public:
+  static constexpr std::size_t inlineCapacity = 16;
+
+  using element_type = T;
+
+  InlinePtr() noexcept { new (&_shared) std::shared_ptr<T>(); }
+
+  explicit InlinePtr(std::shared_ptr<T> ptr) noexcept {
+    new (&_shared) std::shared_ptr<T>(std::move(ptr));
+  }
+
+  // Aliasing constructors
+  template <typename U>
+  InlinePtr(InlinePtr<U> const& other, T* ptr) noexcept {
+    initAlias(other, ptr);
+  }
+  template <typename U>
+  InlinePtr(InlinePtr<U>&& other, T* ptr) noexcept {
+    if (other._isInline) {
+      initAlias(other, ptr);
+    } else {
+      new (&_shared) std::shared_ptr<T>(std::move(other._shared), ptr);
+    }
+  }
+
+  // Converting constructors
+  template <typename U,
+            typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  InlinePtr(InlinePtr<U> const&
+                other) noexcept  // NOLINT(google-explicit-constructor)
+      : InlinePtr(other, other.get()) {}
+  template <typename U,
+            typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  InlinePtr(
+      InlinePtr<U>&& other) noexcept  // NOLINT(google-explicit-constructor)
+      : InlinePtr(std::move(other), other.get()) {}
+
+  InlinePtr(InlinePtr const& other) noexcept : InlinePtr(other, other.get()) {}
+  InlinePtr(InlinePtr&& other) noexcept
+      : InlinePtr(std::move(other), other.get()) {}
+
+  InlinePtr& operator=(InlinePtr const& other) noexcept {
+    if (this != &other) {
+      this->~InlinePtr();
+      new (this) InlinePtr(other);
+    }
+    return *this;
+  }
+  InlinePtr& operator=(InlinePtr&& other) noexcept {
+    if (this != &other) {
+      this->~InlinePtr();
+      new (this) InlinePtr(std::move(other));
+    }
+    return *this;
+  }
+
+  ~InlinePtr() {
+    if (!_isInline) {
+      _shared.~shared_ptr();
+    }
+  }
+
+  // Returns an inline pointer to inlineCapacity zeroed bytes
+  [[nodiscard]] static InlinePtr makeInline() noexcept {
+    return InlinePtr(InlineTag{});
+  }
+
+  // Returns an inline pointer to a copy of size bytes. size must not exceed
+  // inlineCapacity.
+  [[nodiscard]] static InlinePtr copyOf(uint8_t const* data,
+                                        std::size_t size) noexcept {
+    auto result = makeInline();
+    std::memcpy(result._inline, data, size);
+    return result;
+  }
+
+  void reset() noexcept { *this = InlinePtr(); }
+
+  [[nodiscard]] T* get() const noexcept {
+    if (_isInline) {
+      return reinterpret_cast<T*>(const_cast<uint8_t*>(_inline) + _offset);
+    }
+    return _shared.get();
+  }
+
+  T* operator->() const noexcept { return get(); }
+
+  [[nodiscard]] long use_count() const noexcept {
+    return _isInline ? 0 : _shared.use_count();
+  }
+
+  [[nodiscard]] bool isInline() const noexcept { return _isInline; }
+
+  explicit operator bool() const noexcept { return get() != nullptr; }
+
+  // The shared_ptr this pointer holds, or an empty one if it is inline
+  [[nodiscard]] std::shared_ptr<T> const& shared() const noexcept {
+    static std::shared_ptr<T> const empty;
+    return _isInline ? empty : _shared;
+  }
+
+  template <typename U>
+  [[nodiscard]] bool owner_before(InlinePtr<U> const& other) const noexcept {
+    return shared().owner_before(other.shared());
+  }
+
+ private:
+  template <typename>
+  friend class InlinePtr;
+
+  struct InlineTag {};
+
+  explicit InlinePtr(InlineTag) noexcept : _isInline(true) {
+    std::memset(_inline, 0, inlineCapacity);
+  }
+
+  // Initializes the still unconstructed storage
+  template <typename U>
+  void initAlias(InlinePtr<U> const& other, T* ptr) noexcept {
+    auto const* address = reinterpret_cast<uint8_t const*>(ptr);
+    if (!other._isInline) {
+      new (&_shared) std::shared_ptr<T>(other._shared, ptr);
+    } else if (address >= other._inline &&
+               address < other._inline + inlineCapacity) {
+      std::memcpy(_inline, other._inline, inlineCapacity);
+      _offset = static_cast<uint8_t>(address - other._inline);
+      _isInline = true;
+    } else {
+      // Points outside of the inline bytes, e.g. to external memory
+      new (&_shared) std::shared_ptr<T>(std::shared_ptr<T>(), ptr);
+    }
+  }
+
+ private:
+  union {
+    std::shared_ptr<T> _shared;
+    uint8_t _inline[inlineCapacity];
+  };
+  uint8_t _offset = 0;
+  bool _isInline = false;
+};
+
+template <typename T, typename U>
+bool operator==(InlinePtr<T> const& left, InlinePtr<U> const& right) noexcept {
+  return left.get() == right.get();
+}
+
+template <typename T, typename U>
+bool operator!=(InlinePtr<T> const& left, InlinePtr<U> const& right) noexcept {
+  return left.get() != right.get();
+}
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_INLINEPTR_H
@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "IntrusivePtr.h"
+
+#include "BufferCaches.h"
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+template <typename RefCount>
+struct BufferHeader : detail::IntrusiveHeader<RefCount> {
+  BufferHeader(void (*destroy)(detail::IntrusiveHeader<RefCount>*) noexcept,
+               std::size_t size) noexcept
+      : detail::IntrusiveHeader<RefCount>(destroy), size(size) {}
+
+  std::size_t size;
+  detail::LazyBufferCaches caches;
+};
+
+template <typename RefCount>
+constexpr std::size_t headerSize =
+    detail::payloadOffset<BufferHeader<RefCount>>;
+
+template <typename RefCount>
+void destroyBuffer(detail::IntrusiveHeader<RefCount>* header) noexcept {
+  static_cast<BufferHeader<RefCount>*>(header)->~BufferHeader();
+  ::operator delete(static_cast<void*>(header));
+}
+}  // namespace
+
+template <typename RefCount>
+IntrusivePtr<uint8_t, RefCount> velocypack::allocateIntrusiveBuffer(
+    std::size_t size) {
+  void* block = ::operator new(headerSize<RefCount> + size);
+  auto* header = detail::checkIntrusiveHeader(
+      new (block) BufferHeader<RefCount>(&destroyBuffer<RefCount>, size));
+  auto* data = static_cast<uint8_t*>(block) + headerSize<RefCount>;
+  return IntrusivePtr<uint8_t, RefCount>::adopt(header, data);
+}
+
+template <typename RefCount>
+std::optional<std::size_t> velocypack::intrusiveBufferSize(
+    detail::IntrusiveHeader<RefCount> const* header) noexcept {
+  if (header == nullptr || header->destroy != &destroyBuffer<RefCount>) {
+    return std::nullopt;
+  }
+  return static_cast<BufferHeader<RefCount> const*>(header)->size;
+}
+
+template <typename RefCount>
+detail::LazyBufferCaches const* velocypack::intrusiveBufferCaches(
+    detail::IntrusiveHeader<RefCount> const* header) {
+  if (header == nullptr || header->destroy != &destroyBuffer<RefCount>) {
+    return nullptr;
+  }
+  return &static_cast<BufferHeader<RefCount> const*>(header)->caches;
+}
+
+template IntrusivePtr<uint8_t, detail::AtomicRefCount>
+    velocypack::allocateIntrusiveBuffer<detail::AtomicRefCount>(std::size_t);
+template IntrusivePtr<uint8_t, detail::LocalRefCount>
+    velocypack::allocateIntrusiveBuffer<detail::LocalRefCount>(std::size_t);
+template std::optional<std::size_t>
+velocypack::intrusiveBufferSize<detail::AtomicRefCount>(
+    detail::IntrusiveHeader<detail::AtomicRefCount> const*) noexcept;
+template std::optional<std::size_t>
+velocypack::intrusiveBufferSize<detail::LocalRefCount>(
+    detail::IntrusiveHeader<detail::LocalRefCount> const*) noexcept;
+template detail::LazyBufferCaches const*
+velocypack::intrusiveBufferCaches<detail::AtomicRefCount>(
+    detail::IntrusiveHeader<detail::AtomicRefCount> const*);
+template detail::LazyBufferCaches const*
+velocypack::intrusiveBufferCaches<detail::LocalRefCount>(
+    detail::IntrusiveHeader<detail::LocalRefCount> const*);
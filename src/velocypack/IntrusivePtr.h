@@ -0,0 +1,424 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_INTRUSIVEPTR_H
+#define SRC_INTRUSIVEPTR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace arangodb::velocypack {
+
+namespace detail {
+class LazyBufferCaches;
+
+// Where the payload behind a Header in the same allocation starts, so that
+// it is aligned as if it came from operator new directly
+template <typename Header>
+constexpr std::size_t payloadOffset = (sizeof(Header) +
+                                       alignof(std::max_align_t) - 1) /
+                                      alignof(std::max_align_t) *
+                                      alignof(std::max_align_t);
+
+// Thread-safe reference count
+class AtomicRefCount {
+ public:
+  void increment() noexcept { _value.fetch_add(1, std::memory_order_relaxed); }
+  // Returns true if this was the last reference
+  [[nodiscard]] bool decrement() noexcept {
+    return _value.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+  [[nodiscard]] std::size_t load() const noexcept {
+    return _value.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<std::size_t> _value{1};
+};
+
+// Reference count for allocations that never leave the thread that created
+// them. No atomic instructions at all.
+class LocalRefCount {
+ public:
+  void increment() noexcept { ++_value; }
+  // Returns true if this was the last reference
+  [[nodiscard]] bool decrement() noexcept { return --_value == 0; }
+  [[nodiscard]] std::size_t load() const noexcept { return _value; }
+
+ private:
+  std::size_t _value{1};
+};
+
+// Lives directly in front of the payload of every intrusively refcounted
+// allocation. There is no separate control block.
+template <typename RefCount>
+struct alignas(16) IntrusiveHeader {
+  explicit IntrusiveHeader(void (*destroy)(IntrusiveHeader*) noexcept) noexcept
+      : destroy(destroy) {}
+
+  RefCount refCount;
+  // Destroys the payload and frees the whole allocation
+  void (*const destroy)(IntrusiveHeader*) noexcept;
+  // Pointers that are not behind the header, e.g. into a wrapped buffer, are
+  // stored relative to this. Set it before aliasing such a pointer.
+  void const* base = nullptr;
+};
+
+template <typename RefCount>
+void releaseIntrusive(IntrusiveHeader<RefCount>* header) noexcept {
+  if (header != nullptr && header->refCount.decrement()) {
+    header->destroy(header);
+  }
+}
+
+// Stands in for the header of an allocation when a pointer is too far from
+// both the header and its base to be stored relative to them, with the
+// pointer as its base. Holds one reference on the real header.
+template <typename RefCount>
+struct IntrusiveForward : IntrusiveHeader<RefCount> {
+  IntrusiveForward(IntrusiveHeader<RefCount>* root, void const* base) noexcept
+      : IntrusiveHeader<RefCount>(&destroyForward), root(root) {
+    this->base = base;
+  }
+
+  static void destroyForward(IntrusiveHeader<RefCount>* header) noexcept {
+    auto* forward = static_cast<IntrusiveForward*>(header);
+    releaseIntrusive(forward->root);
+    delete forward;
+  }
+
+  IntrusiveHeader<RefCount>* const root;
+};
+
+// Returns the header of the allocation itself, looking through forwards
+template <typename RefCount>
+IntrusiveHeader<RefCount>* rootOf(IntrusiveHeader<RefCount>* header) noexcept {
+  if (header != nullptr &&
+      header->destroy == &IntrusiveForward<RefCount>::destroyForward) {
+    return static_cast<IntrusiveForward<RefCount>*>(header)->root;
+  }
+  return header;
+}
+
+// The layout of the single word of an IntrusivePtr:
+//  - 0 is null;
+//  - with bit 0 set, it is an unowned pointer in bits 1 to 63;
+//  - otherwise bits 2 to 45 hold the header divided by 16, and bits 46 to
+//    63 the offset of the pointer from the header, or from header->base if
+//    bit 1 is set.
+// This needs user space addresses to fit into 48 bits, as on x86-64 and
+// AArch64; the allocating functions check that.
+struct IntrusiveWord {
+  static constexpr unsigned addressBits = 48;
+  static constexpr unsigned alignmentBits = 4;
+  static constexpr unsigned headerShift = 2;
+  static constexpr unsigned offsetShift =
+      headerShift + addressBits - alignmentBits;
+  static constexpr std::uintptr_t unowned = 1;
+  static constexpr std::uintptr_t fromBase = 2;
+  static constexpr std::uintptr_t headerMask =
+      (std::uintptr_t{1} << offsetShift) - (std::uintptr_t{1} << headerShift);
+  static constexpr std::uintptr_t maxOffset =
+      (std::uintptr_t{1} << (64 - offsetShift)) - 1;
+
+  static_assert(sizeof(std::uintptr_t) == 8, "needs 64-bit pointers");
+
+  [[nodiscard]] static bool fits(void const* header) noexcept {
+    auto const address = reinterpret_cast<std::uintptr_t>(header);
+    return address % (std::uintptr_t{1} << alignmentBits) == 0 &&
+           address >> addressBits == 0;
+  }
+};
+
+// Throws std::bad_alloc if header cannot be stored in an IntrusivePtr
+template <typename Header>
+Header* checkIntrusiveHeader(Header* header) {
+  if (!IntrusiveWord::fits(header)) {
+    header->destroy(header);
+    throw std::bad_alloc();
+  }
+  return header;
+}
+}  // namespace detail
+
+/**
+ * @brief A shared_ptr-like pointer whose reference count is stored in a
+ *        header allocated together with the payload.
+ *
+ *        Supports the subset of the std::shared_ptr interface SharedSlice
+ *        needs, most notably the aliasing constructor: all aliases share the
+ *        header of the allocation they were derived from.
+ *
+ *        The header and the pointer are packed into a single word, see
+ *        detail::IntrusiveWord. A pointer more than 256 KiB behind both the
+ *        header and its base gets a small forwarding allocation, so aliasing
+ *        may allocate; use_count() then counts the forward as one reference.
+ *
+ *        RefCount is either detail::AtomicRefCount, or detail::LocalRefCount
+ *        for pointers that must not be shared between threads.
+ */
+template <typename T, typename RefCount = detail::AtomicRefCount>
+class IntrusivePtr {
+ public:
+  using element_type = T;
+  using header_type = detail::IntrusiveHeader<RefCount>;
+
+  constexpr IntrusivePtr() noexcept = default;
+
+  // Aliasing constructors
+  template <typename U>
+  IntrusivePtr(IntrusivePtr<U, RefCount> const& other, T* ptr)
+      : _word(encode(other.acquire(), ptr)) {}
+  template <typename U>
+  IntrusivePtr(IntrusivePtr<U, RefCount>&& other, T* ptr)
+      : _word(encode(other.take(), ptr)) {}
+
+  // Converting constructors. The address stays the same, and so does the
+  // encoding.
+  template <typename U,
+            typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  IntrusivePtr(IntrusivePtr<U, RefCount> const& other) noexcept
+      : _word(other._word) {
+    acquire();
+  }
+  template <typename U,
+            typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  IntrusivePtr(IntrusivePtr<U, RefCount>&& other) noexcept
+      : _word(std::exchange(other._word, 0)) {}
+
+  IntrusivePtr(IntrusivePtr const& other) noexcept : _word(other._word) {
+    acquire();
+  }
+  IntrusivePtr(IntrusivePtr&& other) noexcept
+      : _word(std::exchange(other._word, 0)) {}
+
+  IntrusivePtr& operator=(IntrusivePtr const& other) noexcept {
+    IntrusivePtr(other).swap(*this);
+    return *this;
+  }
+  IntrusivePtr& operator=(IntrusivePtr&& other) noexcept {
+    IntrusivePtr(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  ~IntrusivePtr() { detail::releaseIntrusive(direct()); }
+
+  void swap(IntrusivePtr& other) noexcept { std::swap(_word, other._word); }
+
+  void reset() noexcept { IntrusivePtr().swap(*this); }
+
+  [[nodiscard]] T* get() const noexcept {
+    using Word = detail::IntrusiveWord;
+    if ((_word & Word::unowned) != 0) {
+      return reinterpret_cast<T*>(_word >> 1);
+    }
+    auto const* header = direct();
+    if (header == nullptr) {
+      return nullptr;
+    }
+    auto const origin = (_word & Word::fromBase) != 0
+                            ? reinterpret_cast<std::uintptr_t>(header->base)
+                            : reinterpret_cast<std::uintptr_t>(header);
+    return reinterpret_cast<T*>(origin + (_word >> Word::offsetShift));
+  }
+
+  template <typename U = T>
+  [[nodiscard]] U& operator*() const noexcept {
+    return *get();
+  }
+
+  T* operator->() const noexcept { return get(); }
+
+  [[nodiscard]] long use_count() const noexcept {
+    auto const* root = header();
+    return root == nullptr ? 0 : static_cast<long>(root->refCount.load());
+  }
+
+  explicit operator bool() const noexcept { return get() != nullptr; }
+
+  // The header of the allocation this pointer shares, if any
+  [[nodiscard]] header_type* header() const noexcept {
+    return detail::rootOf(direct());
+  }
+
+  template <typename U>
+  [[nodiscard]] bool owner_before(
+      IntrusivePtr<U, RefCount> const& other) const noexcept {
+    return std::less<>{}(header(), other.header());
+  }
+
+  // Takes over one reference already held on header. ptr must be behind
+  // header or its base by at most 256 KiB, then this doesn't allocate.
+  [[nodiscard]] static IntrusivePtr adopt(header_type* header,
+                                          T* ptr) noexcept {
+    auto result = IntrusivePtr();
+    result._word = encode(header, ptr);
+    return result;
+  }
+
+ private:
+  template <typename, typename>
+  friend class IntrusivePtr;
+
+  [[nodiscard]] header_type* direct() const noexcept {
+    using Word = detail::IntrusiveWord;
+    if ((_word & Word::unowned) != 0) {
+      return nullptr;
+    }
+    return reinterpret_cast<header_type*>(
+        (_word & Word::headerMask)
+        << (Word::alignmentBits - Word::headerShift));
+  }
+
+  header_type* acquire() const noexcept {
+    auto* header = direct();
+    if (header != nullptr) {
+      header->refCount.increment();
+    }
+    return header;
+  }
+
+  header_type* take() noexcept {
+    auto* header = direct();
+    _word = 0;
+    return header;
+  }
+
+  // Takes over one reference on header. Allocates a forward if ptr is too
+  // far from header to be stored relative to it.
+  static std::uintptr_t encode(header_type* header, void const* ptr) {
+    using Word = detail::IntrusiveWord;
+    auto const address = reinterpret_cast<std::uintptr_t>(ptr);
+    if (header == nullptr) {
+      return address == 0 ? 0 : address << 1 | Word::unowned;
+    }
+    auto const packed = reinterpret_cast<std::uintptr_t>(header) >>
+                        (Word::alignmentBits - Word::headerShift);
+    auto const origin = reinterpret_cast<std::uintptr_t>(header);
+    if (address >= origin && address - origin <= Word::maxOffset) {
+      return packed | (address - origin) << Word::offsetShift;
+    }
+    auto const base = reinterpret_cast<std::uintptr_t>(header->base);
+    if (base != 0 && address >= base && address - base <= Word::maxOffset) {
+      return packed | Word::fromBase | (address - base) << Word::offsetShift;
+    }
+    // Forward to the root, so forwards never chain
+    auto* root = detail::rootOf(header);
+    root->refCount.increment();
+    detail::releaseIntrusive(header);
+    auto* forward =
+        new (std::nothrow) detail::IntrusiveForward<RefCount>(root, ptr);
+    if (forward == nullptr) {
+      detail::releaseIntrusive(root);
+      throw std::bad_alloc();
+    }
+    detail::checkIntrusiveHeader<header_type>(forward);
+    return reinterpret_cast<std::uintptr_t>(forward) >>
+               (Word::alignmentBits - Word::headerShift) |
+           Word::fromBase;
+  }
+
+ private:
+  std::uintptr_t _word = 0;
+};
+
+template <typename T, typename U, typename RefCount>
+bool operator==(IntrusivePtr<T, RefCount> const& left,
+                IntrusivePtr<U, RefCount> const& right) noexcept {
+  return left.get() == right.get();
+}
+
+template <typename T, typename U, typename RefCount>
+bool operator!=(IntrusivePtr<T, RefCount> const& left,
+                IntrusivePtr<U, RefCount> const& right) noexcept {
+  return left.get() != right.get();
+}
+
+// Allocates a header and `size` uninitialized bytes in one block.
+// Instantiated for detail::AtomicRefCount and detail::LocalRefCount.
+template <typename RefCount = detail::AtomicRefCount>
+[[nodiscard]] IntrusivePtr<uint8_t, RefCount> allocateIntrusiveBuffer(
+    std::size_t size);
+
+// Returns the size passed to allocateIntrusiveBuffer() if header belongs to
+// an allocation made by it, and std::nullopt otherwise.
+template <typename RefCount>
+[[nodiscard]] std::optional<std::size_t> intrusiveBufferSize(
+    detail::IntrusiveHeader<RefCount> const* header) noexcept;
+
+// Returns the caches of an allocation made by allocateIntrusiveBuffer(), and
+// nullptr for any other header.
+template <typename RefCount>
+[[nodiscard]] detail::LazyBufferCaches const* intrusiveBufferCaches(
+    detail::IntrusiveHeader<RefCount> const* header);
+
+extern template IntrusivePtr<uint8_t, detail::AtomicRefCount>
+    allocateIntrusiveBuffer<detail::AtomicRefCount>(std::size_t);
+extern template IntrusivePtr<uint8_t, detail::LocalRefCount>
+    allocateIntrusiveBuffer<detail::LocalRefCount>(std::size_t);
+extern template std::optional<std::size_t>
+intrusiveBufferSize<detail::AtomicRefCount>(
+    detail::IntrusiveHeader<detail::AtomicRefCount> const*) noexcept;
+extern template std::optional<std::size_t>
+intrusiveBufferSize<detail::LocalRefCount>(
+    detail::IntrusiveHeader<detail::LocalRefCount> const*) noexcept;
+extern template detail::LazyBufferCaches const*
+intrusiveBufferCaches<detail::AtomicRefCount>(
+    detail::IntrusiveHeader<detail::AtomicRefCount> const*);
+extern template detail::LazyBufferCaches const*
+intrusiveBufferCaches<detail::LocalRefCount>(
+    detail::IntrusiveHeader<detail::LocalRefCount> const*);
+
+namespace detail {
+template <typename T, typename RefCount>
+struct IntrusiveBlock : IntrusiveHeader<RefCount> {
+  template <typename... Args>
+  explicit IntrusiveBlock(Args&&... args)
+      : IntrusiveHeader<RefCount>(&destroyBlock),
+        value(std::forward<Args>(args)...) {}
+
+  static void destroyBlock(IntrusiveHeader<RefCount>* header) noexcept {
+    delete static_cast<IntrusiveBlock*>(header);
+  }
+
+  T value;
+};
+}  // namespace detail
+
+// Allocates a header and a T constructed from args in one block.
+template <typename T, typename RefCount = detail::AtomicRefCount,
+          typename... Args>
+[[nodiscard]] IntrusivePtr<T, RefCount> makeIntrusive(Args&&... args) {
+  auto* block = detail::checkIntrusiveHeader(
+      new detail::IntrusiveBlock<T, RefCount>(std::forward<Args>(args)...));
+  return IntrusivePtr<T, RefCount>::adopt(block, &block->value);
+}
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_INTRUSIVEPTR_H
@@ -0,0 +1,245 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "KeySearch.h"
+
+#include <velocypack/Iterator.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define VELOCYPACK_KEYSEARCH_X86
+#endif
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+// Keys of up to this many characters are stored as short strings, with the
+// length in the head byte
+constexpr std::size_t maxShortStringLength = 126;
+
+[[nodiscard]] bool isShortString(uint8_t head) noexcept {
+  return head >= 0x40 && head <= 0xbe;
+}
+
+// Compares a candidate key byte by byte
+class ScalarMatcher {
+ public:
+  // Longer keys are only stored as long strings. Their head is 0, which no
+  // short string has.
+  explicit ScalarMatcher(StringRef key) noexcept
+      : _key(key),
+        _head(key.size() <= maxShortStringLength
+                  ? static_cast<uint8_t>(0x40 + key.size())
+                  : 0) {}
+
+  // candidate points to a short string inside the object ending at end
+  [[nodiscard]] bool operator()(uint8_t const* candidate,
+                                uint8_t const* end) const noexcept {
+    return candidate[0] == _head &&
+           static_cast<std::size_t>(end - candidate) > _key.size() &&
+           std::memcmp(candidate + 1, _key.data(), _key.size()) == 0;
+  }
+
+ private:
+  StringRef _key;
+  uint8_t _head;
+};
+
+#ifdef VELOCYPACK_KEYSEARCH_X86
+// The key as it is stored in an object, head first, cut off or zero padded to
+// Width bytes. Candidates are compared against it with one vector compare,
+// which rejects almost all of them without looking at any further byte.
+template <std::size_t Width>
+class Needle {
+ public:
+  explicit Needle(StringRef key) noexcept : _scalar(key), _key(key) {
+    auto const stored = 1 + key.size();
+    _compared = stored < Width ? stored : Width;
+    _bytes[0] = static_cast<uint8_t>(0x40 + key.size());
+    std::memcpy(_bytes + 1, key.data(), _compared - 1);
+    _mask = _compared == 32 ? UINT32_MAX : (uint32_t{1} << _compared) - 1;
+  }
+
+ protected:
+  // equal has bit i set if byte i of the candidate matched
+  [[nodiscard]] bool matches(uint8_t const* candidate, uint8_t const* end,
+                             uint32_t equal) const noexcept {
+    if ((equal & _mask) != _mask) {
+      return false;
+    }
+    // Equal heads mean equal lengths, compare the rest of the key
+    return _compared == 1 + _key.size() ||
+           (static_cast<std::size_t>(end - candidate) > _key.size() &&
+            std::memcmp(candidate + _compared, _key.data() + _compared - 1,
+                        _key.size() + 1 - _compared) == 0);
+  }
+
+  uint8_t _bytes[Width]{};
+  ScalarMatcher _scalar;
+
+ private:
+  StringRef _key;
+  std::size_t _compared;
+  uint32_t _mask;
+};
+
+class Sse2Matcher : private Needle<16> {
+ public:
+  using Needle::Needle;
+
+  [[nodiscard]] bool operator()(uint8_t const* candidate,
+                                uint8_t const* end) const noexcept {
+    if (end - candidate < 16) {
+      // Loading a full vector would read past the object
+      return _scalar(candidate, end);
+    }
+    auto const needle =
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(_bytes));
+    auto const loaded =
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(candidate));
+    auto const equal = static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(loaded, needle)));
+    return matches(candidate, end, equal);
+  }
+};
+
+class Avx2Matcher : private Needle<32> {
+ public:
+  using Needle::Needle;
+
+  [[nodiscard]] __attribute__((target("avx2"))) bool operator()(
+      uint8_t const* candidate, uint8_t const* end) const noexcept {
+    if (end - candidate < 32) {
+      return _scalar(candidate, end);
+    }
+    auto const needle =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const*>(_bytes));
+    auto const loaded =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const*>(candidate));
+    auto const equal = static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(loaded, needle)));
+    return matches(candidate, end, equal);
+  }
+};
+#endif
+
+template <typename Matcher>
+[[nodiscard]] inline Slice search(Slice object, StringRef key,
+                                  Matcher const& matcher) {
+  auto const* end = object.start() + object.byteSize();
+  for (auto it = ObjectIterator(object, true); it.valid(); it.next()) {
+    auto const candidate = it.key(false);
+    if (isShortString(candidate.head())) {
+      if (matcher(candidate.start(), end)) {
+        return it.value();
+      }
+    } else {
+      // Long strings cannot match a short key, but translated ones can
+      auto const translated = it.key(true);
+      if (translated.isString() && translated.isEqualStringUnchecked(key)) {
+        return it.value();
+      }
+    }
+  }
+  return Slice();
+}
+
+[[nodiscard]] Slice searchScalar(Slice object, StringRef key) {
+  return search(object, key, ScalarMatcher(key));
+}
+
+#ifdef VELOCYPACK_KEYSEARCH_X86
+[[nodiscard]] Slice searchSse2(Slice object, StringRef key) {
+  return search(object, key, Sse2Matcher(key));
+}
+
+[[nodiscard]] __attribute__((target("avx2"))) Slice searchAvx2(Slice object,
+                                                               StringRef key) {
+  return search(object, key, Avx2Matcher(key));
+}
+#endif
+}  // namespace
+
+bool velocypack::isSupported(KeySearchImplementation implementation) noexcept {
+  switch (implementation) {
+    case KeySearchImplementation::scalar:
+      return true;
+#ifdef VELOCYPACK_KEYSEARCH_X86
+    case KeySearchImplementation::sse2:
+      // Part of x86-64
+      return true;
+    case KeySearchImplementation::avx2:
+      return __builtin_cpu_supports("avx2");
+#else
+    case KeySearchImplementation::sse2:
+    case KeySearchImplementation::avx2:
+      return false;
+#endif
+  }
+  return false;
+}
+
+KeySearchImplementation velocypack::bestKeySearchImplementation() noexcept {
+  static auto const best = [] {
+    for (auto implementation :
+         {KeySearchImplementation::avx2, KeySearchImplementation::sse2}) {
+      if (isSupported(implementation)) {
+        return implementation;
+      }
+    }
+    return KeySearchImplementation::scalar;
+  }();
+  return best;
+}
+
+bool velocypack::needsLinearKeySearch(Slice object) noexcept {
+  auto const head = object.head();
+  // 0x0f - 0x12 have an unsorted index table, 0x14 is compact
+  return (head >= 0x0f && head <= 0x12) || head == 0x14;
+}
+
+Slice velocypack::findKeyLinear(Slice object, StringRef key) {
+  return findKeyLinear(object, key, bestKeySearchImplementation());
+}
+
+Slice velocypack::findKeyLinear(Slice object, StringRef key,
+                                KeySearchImplementation implementation) {
+  if (key.size() > maxShortStringLength) {
+    // Only long strings can match, the vector compares do not help
+    implementation = KeySearchImplementation::scalar;
+  }
+  switch (implementation) {
+#ifdef VELOCYPACK_KEYSEARCH_X86
+    case KeySearchImplementation::avx2:
+      return searchAvx2(object, key);
+    case KeySearchImplementation::sse2:
+      return searchSse2(object, key);
+#endif
+    default:
+      return searchScalar(object, key);
+  }
+}
@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_KEYSEARCH_H
+#define SRC_KEYSEARCH_H
+
+#include <velocypack/Slice.h>
+#include <velocypack/StringRef.h>
+
+namespace arangodb::velocypack {
+
+enum class KeySearchImplementation {
+  scalar,
+  // Compares the head and the first 15 characters of a key at once
+  sse2,
+  // Compares the head and the first 31 characters of a key at once
+  avx2,
+};
+
+// Whether the running CPU supports implementation
+[[nodiscard]] bool isSupported(KeySearchImplementation implementation) noexcept;
+
+// The fastest supported implementation, detected once
+[[nodiscard]] KeySearchImplementation bestKeySearchImplementation() noexcept;
+
+// Whether Slice::get() has to scan the keys of object one by one, because
+// they are not sorted. This is the case for compact objects and objects with
+// an unsorted index table.
+[[nodiscard]] bool needsLinearKeySearch(Slice object) noexcept;
+
+// Returns the value of key in object, or a None slice if there is no such
+// key, scanning all keys. Like Slice::get(), the first of duplicate keys
+// wins. object must be an object.
+[[nodiscard]] Slice findKeyLinear(Slice object, StringRef key);
+// Same, using the given implementation, which must be supported.
+[[nodiscard]] Slice findKeyLinear(Slice object, StringRef key,
+                                  KeySearchImplementation implementation);
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_KEYSEARCH_H
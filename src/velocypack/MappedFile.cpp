@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MappedFile.h"
+
+#include <velocypack/Exception.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <memory>
+#include <system_error>
+#include <tuple>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+[[noreturn]] void throwErrno(char const* what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+int adviceFlag(MapFileOptions::Advice advice) noexcept {
+  switch (advice) {
+    case MapFileOptions::Advice::Sequential:
+      return MADV_SEQUENTIAL;
+    case MapFileOptions::Advice::Random:
+      return MADV_RANDOM;
+    case MapFileOptions::Advice::WillNeed:
+      return MADV_WILLNEED;
+    case MapFileOptions::Advice::Normal:
+      break;
+  }
+  return MADV_NORMAL;
+}
+
+class FileDescriptor {
+ public:
+  explicit FileDescriptor(int fd) noexcept : _fd(fd) {}
+  FileDescriptor(FileDescriptor const&) = delete;
+  FileDescriptor& operator=(FileDescriptor const&) = delete;
+  ~FileDescriptor() { ::close(_fd); }
+
+  [[nodiscard]] int get() const noexcept { return _fd; }
+
+ private:
+  int _fd;
+};
+}  // namespace
+
+SharedSlice velocypack::mapFile(std::string const& path,
+                                MapFileOptions options) {
+  int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throwErrno("cannot open file");
+  }
+  // The mapping stays valid after the descriptor is closed
+  auto const file = FileDescriptor(fd);
+
+  struct stat status {};
+  if (::fstat(file.get(), &status) != 0) {
+    throwErrno("cannot stat file");
+  }
+  auto const size = static_cast<std::size_t>(status.st_size);
+  if (size == 0) {
+    throw Exception(Exception::ValidatorInvalidLength,
+                    "cannot map an empty file");
+  }
+
+  void* address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, file.get(), 0);
+  if (address == MAP_FAILED) {
+    throwErrno("cannot map file");
+  }
+  auto const unmap = [](void* data, std::size_t size) noexcept {
+    ::munmap(data, size);
+  };
+  auto data =
+      std::shared_ptr<uint8_t const>(static_cast<uint8_t const*>(address),
+                                     BufferInfo{size, unmap, address});
+
+  // Hints only, failures are harmless
+  if (options.advice != MapFileOptions::Advice::Normal) {
+    std::ignore = ::madvise(address, size, adviceFlag(options.advice));
+  }
+#ifdef MADV_HUGEPAGE
+  if (options.hugePages) {
+    std::ignore = ::madvise(address, size, MADV_HUGEPAGE);
+  }
+#endif
+
+  // Reading the header may go past the end of a tiny file, but stays within
+  // the (zero-filled) last page of the mapping
+  if (Slice(data.get()).byteSize() > size) {
+    throw Exception(Exception::ValidatorInvalidLength,
+                    "file is shorter than its value");
+  }
+  return SharedSlice(std::move(data));
+}
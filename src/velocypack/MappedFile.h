@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_MAPPEDFILE_H
+#define SRC_MAPPEDFILE_H
+
+#include "velocypack/SharedSlice.h"
+
+#include <string>
+
+namespace arangodb::velocypack {
+
+struct MapFileOptions {
+  // Passed to madvise() for the whole mapping
+  enum class Advice { Normal, Sequential, Random, WillNeed };
+
+  Advice advice = Advice::Normal;
+  // Asks for transparent huge pages (MADV_HUGEPAGE) where the kernel
+  // supports them for file mappings. Ignored elsewhere.
+  bool hugePages = false;
+};
+
+// Maps the VPack value stored at the start of the file at `path` read-only
+// and returns a SharedSlice owning the mapping. The file is unmapped when the
+// last alias is gone. The file must not be truncated while it is mapped.
+// Throws std::system_error if the file cannot be opened or mapped, and an
+// Exception if it is too short for the value it starts with.
+[[nodiscard]] SharedSlice mapFile(std::string const& path,
+                                  MapFileOptions options = {});
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_MAPPEDFILE_H
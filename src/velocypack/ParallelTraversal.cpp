@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ParallelTraversal.h"
+
+#include <velocypack/Iterator.h>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+std::vector<uint8_t const*> detail::grainStarts(Slice array,
+                                                ValueLength grainSize) {
+  auto const length = array.length();
+  auto starts = std::vector<uint8_t const*>();
+  starts.reserve(
+      static_cast<std::size_t>((length + grainSize - 1) / grainSize));
+  if (array.head() == 0x13) {
+    // Compact, getNthOffset() would scan from the start every time
+    auto index = ValueLength{0};
+    for (auto it = ArrayIterator(array); it.valid(); it.next(), ++index) {
+      if (index % grainSize == 0) {
+        starts.emplace_back(it.value().start());
+      }
+    }
+  } else {
+    for (auto index = ValueLength{0}; index < length; index += grainSize) {
+      starts.emplace_back(array.start() + array.getNthOffset(index));
+    }
+  }
+  return starts;
+}
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_PARALLELTRAVERSAL_H
+#define SRC_PARALLELTRAVERSAL_H
+
+#include "velocypack/BorrowedSlice.h"
+#include "velocypack/SharedSlice.h"
+#include "velocypack/WorkStealingPool.h"
+
+#include <velocypack/Slice.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace arangodb::velocypack {
+
+struct ParallelOptions {
+  // Number of consecutive elements handled by one task
+  std::size_t grainSize = 4096;
+  // nullptr means WorkStealingPool::global()
+  WorkStealingPool* pool = nullptr;
+};
+
+namespace detail {
+// The result of one grain of parallelReduce(), on a cache line of its own.
+// Unlike a std::vector<T> element, it can be written concurrently with its
+// neighbours even for T = bool.
+template <typename T>
+struct alignas(64) Partial {
+  T value;
+};
+
+// Returns the start of every grainSize-th element of array, using
+// getNthOffset(), or a single pass for compact arrays, which have no index
+// table.
+[[nodiscard]] std::vector<uint8_t const*> grainStarts(Slice array,
+                                                      ValueLength grainSize);
+
+// Calls f(index, element) for the elements of one grain, borrowed from a
+// task-local alias of array
+template <typename OwnershipPolicy, typename F>
+void forEachInGrain(BasicSharedSlice<OwnershipPolicy> const& array,
+                    uint8_t const* start, ValueLength begin, ValueLength end,
+                    F& f) {
+  // Aliases of the elements would all hit the same refcount from every
+  // thread, borrowing from a copy per task touches it once per grain
+  auto const owner = array;
+  auto element = Slice(start);
+  for (auto index = begin; index < end; ++index) {
+    f(index, BasicBorrowedSlice<OwnershipPolicy>(owner, element));
+    element = Slice(element.start() + element.byteSize());
+  }
+}
+}  // namespace detail
+
+// Calls f(index, element) for every element of array, in parallel, with each
+// element a BasicBorrowedSlice valid for the duration of the call. Use
+// element.own() to keep it. Rethrows the first exception thrown by f. array
+// must be an array.
+template <typename OwnershipPolicy, typename F>
+void parallelForEach(BasicSharedSlice<OwnershipPolicy> const& array, F&& f,
+                     ParallelOptions options = {}) {
+  static_assert(!std::is_same_v<OwnershipPolicy, LocalOwnership>,
+                "LocalSharedSlices must not be used from other threads");
+  auto const length = array.length();
+  auto const grainSize =
+      static_cast<ValueLength>(std::max<std::size_t>(options.grainSize, 1));
+  auto const starts = detail::grainStarts(array.slice(), grainSize);
+  auto& pool =
+      options.pool != nullptr ? *options.pool : WorkStealingPool::global();
+  pool.run(starts.size(), [&](std::size_t grain) {
+    auto const begin = grain * grainSize;
+    detail::forEachInGrain(array, starts[grain], begin,
+                           std::min(length, begin + grainSize), f);
+  });
+}
+
+// Returns combine(...combine(combine(identity, map(0, e0)), map(1, e1))...),
+// with map called in parallel and the results combined per grain first, so
+// combine must be associative, and identity an identity of it. The elements
+// are passed to map as in parallelForEach().
+template <typename OwnershipPolicy, typename T, typename Map, typename Combine>
+[[nodiscard]] T parallelReduce(BasicSharedSlice<OwnershipPolicy> const& array,
+                               T identity, Map&& map, Combine&& combine,
+                               ParallelOptions options = {}) {
+  static_assert(!std::is_same_v<OwnershipPolicy, LocalOwnership>,
+                "LocalSharedSlices must not be used from other threads");
+  auto const length = array.length();
+  auto const grainSize =
+      static_cast<ValueLength>(std::max<std::size_t>(options.grainSize, 1));
+  auto const starts = detail::grainStarts(array.slice(), grainSize);
+  auto partials = std::vector<detail::Partial<T>>(starts.size(), {identity});
+  auto& pool =
+      options.pool != nullptr ? *options.pool : WorkStealingPool::global();
+  pool.run(starts.size(), [&](std::size_t grain) {
+    auto const begin = grain * grainSize;
+    auto accumulated = identity;
+    auto accumulate = [&](ValueLength index,
+                          BasicBorrowedSlice<OwnershipPolicy> element) {
+      accumulated = combine(std::move(accumulated), map(index, element));
+    };
+    detail::forEachInGrain(array, starts[grain], begin,
+                           std::min(length, begin + grainSize), accumulate);
+    partials[grain].value = std::move(accumulated);
+  });
+
+  auto result = std::move(identity);
+  for (auto& partial : partials) {
+    result = combine(std::move(result), std::move(partial.value));
+  }
+  return result;
+}
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_PARALLELTRAVERSAL_H
@@ -0,0 +1,471 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_PIPELINE_H
+#define SRC_PIPELINE_H
+
+#include "velocypack/BorrowedSlice.h"
+#include "velocypack/SharedIterator.h"
+#include "velocypack/SharedSlice.h"
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if __cpp_lib_ranges
+#include <ranges>
+#endif
+
+/**
+ * Lazy pipelines over the elements of arrays and the members of objects:
+ *
+ *   auto names = pipeline::elements(array)
+ *       | pipeline::filter([](BorrowedSlice e) { return
+ * e->get("active").isTrue(); }) | pipeline::transform([](BorrowedSlice e) {
+ * return e.borrow(e->get("name")); }) | pipeline::take(10) |
+ * pipeline::toVector();
+ *
+ * Sources yield BorrowedSlices, so no stage touches a refcount or allocates.
+ * Only toVector() owns what it collects, see BasicBorrowedSlice::own(). The
+ * SharedSlice a source is created from must outlive the pipeline.
+ *
+ * Every stage is an input range: it can be iterated once, with range-for or
+ * with algorithms taking iterators, including std::ranges ones in C++20.
+ */
+namespace arangodb::velocypack::pipeline {
+
+namespace detail {
+struct AdaptorTag {};
+
+// Gives a stage with `std::optional<value_type> next()` begin() and end()
+template <typename Stage>
+class Range {
+ public:
+  class iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = typename Stage::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type const*;
+    using reference = value_type const&;
+
+    iterator() noexcept = default;
+    explicit iterator(Stage* stage) : _stage(stage), _current(stage->next()) {}
+
+    reference operator*() const noexcept { return *_current; }
+    pointer operator->() const noexcept { return &*_current; }
+
+    iterator& operator++() {
+      _current = _stage->next();
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+
+    // Only meant to compare against end()
+    friend bool operator==(iterator const& left,
+                           iterator const& right) noexcept {
+      return left._current.has_value() == right._current.has_value();
+    }
+    friend bool operator!=(iterator const& left,
+                           iterator const& right) noexcept {
+      return !(left == right);
+    }
+
+   private:
+    Stage* _stage = nullptr;
+    std::optional<value_type> _current;
+  };
+
+  // May be called only once, the stage is consumed as it is iterated
+  [[nodiscard]] iterator begin() { return iterator(static_cast<Stage*>(this)); }
+  [[nodiscard]] iterator end() noexcept { return iterator(); }
+};
+
+template <typename T>
+struct IsBorrowed : std::false_type {};
+template <typename OwnershipPolicy>
+struct IsBorrowed<BasicBorrowedSlice<OwnershipPolicy>> : std::true_type {};
+
+template <typename T>
+struct IsPair : std::false_type {};
+template <typename First, typename Second>
+struct IsPair<std::pair<First, Second>> : std::true_type {};
+
+// BasicBorrowedObjectIterator::ObjectPair
+template <typename T, typename = void>
+struct IsObjectPair : std::false_type {};
+template <typename T>
+struct IsObjectPair<T, std::void_t<decltype(std::declval<T>().key.own()),
+                                   decltype(std::declval<T>().value.own())>>
+    : std::true_type {};
+
+// Turns BorrowedSlices, also in pairs, into owning slices
+template <typename T>
+[[nodiscard]] auto escape(T&& value) {
+  using Value = std::decay_t<T>;
+  if constexpr (IsBorrowed<Value>::value) {
+    return value.own();
+  } else if constexpr (IsPair<Value>::value) {
+    return std::make_pair(escape(std::forward<T>(value).first),
+                          escape(std::forward<T>(value).second));
+  } else if constexpr (IsObjectPair<Value>::value) {
+    return std::make_pair(value.key.own(), value.value.own());
+  } else {
+    return Value(std::forward<T>(value));
+  }
+}
+
+template <typename T>
+using Escaped = std::decay_t<decltype(escape(std::declval<T>()))>;
+}  // namespace detail
+
+/*************
+ * Sources
+ *************/
+
+template <typename OwnershipPolicy>
+class Elements : public detail::Range<Elements<OwnershipPolicy>> {
+ public:
+  using value_type = BasicBorrowedSlice<OwnershipPolicy>;
+
+  explicit Elements(BasicSharedSlice<OwnershipPolicy> const& array)
+      : _iterator(array) {}
+
+  std::optional<value_type> next() {
+    if (!_iterator.valid()) {
+      return std::nullopt;
+    }
+    auto value = _iterator.value();
+    _iterator.next();
+    return value;
+  }
+
+ private:
+  BasicBorrowedArrayIterator<OwnershipPolicy> _iterator;
+};
+
+// Selects what Members yields
+enum class Member { key, value, both };
+
+template <typename OwnershipPolicy, Member What>
+class Members : public detail::Range<Members<OwnershipPolicy, What>> {
+  using Iterator = BasicBorrowedObjectIterator<OwnershipPolicy>;
+
+ public:
+  using value_type =
+      std::conditional_t<What == Member::both, typename Iterator::ObjectPair,
+                         BasicBorrowedSlice<OwnershipPolicy>>;
+
+  explicit Members(BasicSharedSlice<OwnershipPolicy> const& object)
+      : _iterator(object, true) {}
+
+  std::optional<value_type> next() {
+    if (!_iterator.valid()) {
+      return std::nullopt;
+    }
+    auto result = std::optional<value_type>();
+    if constexpr (What == Member::key) {
+      result.emplace(_iterator.key());
+    } else if constexpr (What == Member::value) {
+      result.emplace(_iterator.value());
+    } else {
+      result.emplace(_iterator.key(), _iterator.value());
+    }
+    _iterator.next();
+    return result;
+  }
+
+ private:
+  Iterator _iterator;
+};
+
+// The elements of array
+template <typename OwnershipPolicy>
+[[nodiscard]] Elements<OwnershipPolicy> elements(
+    BasicSharedSlice<OwnershipPolicy> const& array) {
+  return Elements<OwnershipPolicy>(array);
+}
+template <typename OwnershipPolicy>
+void elements(BasicSharedSlice<OwnershipPolicy>&& array) = delete;
+
+// The (translated) keys of object, in storage order
+template <typename OwnershipPolicy>
+[[nodiscard]] Members<OwnershipPolicy, Member::key> keys(
+    BasicSharedSlice<OwnershipPolicy> const& object) {
+  return Members<OwnershipPolicy, Member::key>(object);
+}
+template <typename OwnershipPolicy>
+void keys(BasicSharedSlice<OwnershipPolicy>&& object) = delete;
+
+// The values of object, in storage order
+template <typename OwnershipPolicy>
+[[nodiscard]] Members<OwnershipPolicy, Member::value> values(
+    BasicSharedSlice<OwnershipPolicy> const& object) {
+  return Members<OwnershipPolicy, Member::value>(object);
+}
+template <typename OwnershipPolicy>
+void values(BasicSharedSlice<OwnershipPolicy>&& object) = delete;
+
+// Key and value pairs of object, in storage order
+template <typename OwnershipPolicy>
+[[nodiscard]] Members<OwnershipPolicy, Member::both> members(
+    BasicSharedSlice<OwnershipPolicy> const& object) {
+  return Members<OwnershipPolicy, Member::both>(object);
+}
+template <typename OwnershipPolicy>
+void members(BasicSharedSlice<OwnershipPolicy>&& object) = delete;
+
+/*************
+ * Stages
+ *************/
+
+template <typename Source, typename Predicate>
+class Filter : public detail::Range<Filter<Source, Predicate>> {
+ public:
+  using value_type = typename Source::value_type;
+
+  Filter(Source source, Predicate predicate)
+      : _source(std::move(source)), _predicate(std::move(predicate)) {}
+
+  std::optional<value_type> next() {
+    while (auto value = _source.next()) {
+      if (_predicate(std::as_const(*value))) {
+        return value;
+      }
+    }
+    return std::nullopt;
+  }
+
+ private:
+  Source _source;
+  Predicate _predicate;
+};
+
+template <typename Source, typename Function>
+class Transform : public detail::Range<Transform<Source, Function>> {
+ public:
+  using value_type = std::decay_t<
+      std::invoke_result_t<Function&, typename Source::value_type>>;
+
+  Transform(Source source, Function function)
+      : _source(std::move(source)), _function(std::move(function)) {}
+
+  std::optional<value_type> next() {
+    if (auto value = _source.next()) {
+      return _function(std::move(*value));
+    }
+    return std::nullopt;
+  }
+
+ private:
+  Source _source;
+  Function _function;
+};
+
+template <typename Source>
+class Take : public detail::Range<Take<Source>> {
+ public:
+  using value_type = typename Source::value_type;
+
+  Take(Source source, std::size_t count)
+      : _source(std::move(source)), _remaining(count) {}
+
+  std::optional<value_type> next() {
+    if (_remaining == 0) {
+      return std::nullopt;
+    }
+    --_remaining;
+    return _source.next();
+  }
+
+ private:
+  Source _source;
+  std::size_t _remaining;
+};
+
+template <typename Source>
+class Drop : public detail::Range<Drop<Source>> {
+ public:
+  using value_type = typename Source::value_type;
+
+  Drop(Source source, std::size_t count)
+      : _source(std::move(source)), _toDrop(count) {}
+
+  std::optional<value_type> next() {
+    for (; _toDrop > 0; --_toDrop) {
+      if (!_source.next().has_value()) {
+        _toDrop = 0;
+        return std::nullopt;
+      }
+    }
+    return _source.next();
+  }
+
+ private:
+  Source _source;
+  std::size_t _toDrop;
+};
+
+template <typename Source>
+class Enumerate : public detail::Range<Enumerate<Source>> {
+ public:
+  using value_type = std::pair<std::size_t, typename Source::value_type>;
+
+  explicit Enumerate(Source source) : _source(std::move(source)) {}
+
+  std::optional<value_type> next() {
+    if (auto value = _source.next()) {
+      return value_type(_index++, std::move(*value));
+    }
+    return std::nullopt;
+  }
+
+ private:
+  Source _source;
+  std::size_t _index = 0;
+};
+
+/*************
+ * Adaptors
+ *************/
+
+namespace detail {
+template <typename Predicate>
+struct FilterAdaptor : AdaptorTag {
+  template <typename Source>
+  auto apply(Source&& source) && {
+    return Filter<std::decay_t<Source>, Predicate>(std::forward<Source>(source),
+                                                   std::move(predicate));
+  }
+  Predicate predicate;
+};
+
+template <typename Function>
+struct TransformAdaptor : AdaptorTag {
+  template <typename Source>
+  auto apply(Source&& source) && {
+    return Transform<std::decay_t<Source>, Function>(std::forward<Source>(
+                                                         source),
+                                                     std::move(function));
+  }
+  Function function;
+};
+
+struct TakeAdaptor : AdaptorTag {
+  template <typename Source>
+  auto apply(Source&& source) && {
+    return Take<std::decay_t<Source>>(std::forward<Source>(source), count);
+  }
+  std::size_t count;
+};
+
+struct DropAdaptor : AdaptorTag {
+  template <typename Source>
+  auto apply(Source&& source) && {
+    return Drop<std::decay_t<Source>>(std::forward<Source>(source), count);
+  }
+  std::size_t count;
+};
+
+struct EnumerateAdaptor : AdaptorTag {
+  template <typename Source>
+  auto apply(Source&& source) && {
+    return Enumerate<std::decay_t<Source>>(std::forward<Source>(source));
+  }
+};
+
+struct ToVectorAdaptor : AdaptorTag {
+  template <typename Source>
+  auto apply(Source&& source) && {
+    auto result =
+        std::vector<Escaped<typename std::decay_t<Source>::value_type>>();
+    while (auto value = source.next()) {
+      result.emplace_back(escape(std::move(*value)));
+    }
+    return result;
+  }
+};
+}  // namespace detail
+
+// Only the values for which predicate(value) is true
+template <typename Predicate>
+[[nodiscard]] auto filter(Predicate predicate) {
+  return detail::FilterAdaptor<Predicate>{{}, std::move(predicate)};
+}
+
+// function(value) instead of value. Return value.borrow(...) to keep
+// borrowing members of a BorrowedSlice.
+template <typename Function>
+[[nodiscard]] auto transform(Function function) {
+  return detail::TransformAdaptor<Function>{{}, std::move(function)};
+}
+
+// At most the first count values
+[[nodiscard]] inline auto take(std::size_t count) {
+  return detail::TakeAdaptor{{}, count};
+}
+
+// All but the first count values
+[[nodiscard]] inline auto drop(std::size_t count) {
+  return detail::DropAdaptor{{}, count};
+}
+
+// Pairs of the index and the value
+[[nodiscard]] inline auto enumerate() { return detail::EnumerateAdaptor{}; }
+
+// Runs the pipeline and collects the values, with BorrowedSlices owned, also
+// in pairs
+[[nodiscard]] inline auto toVector() { return detail::ToVectorAdaptor{}; }
+
+template <typename Source, typename Adaptor,
+          typename = std::enable_if_t<
+              std::is_base_of_v<detail::AdaptorTag, std::decay_t<Adaptor>>>>
+auto operator|(Source&& source, Adaptor&& adaptor) {
+  return std::decay_t<Adaptor>(std::forward<Adaptor>(adaptor))
+      .apply(std::forward<Source>(source));
+}
+
+#if __cpp_lib_ranges
+// Every stage is an input range, see above
+namespace detail {
+using CheckedSource = Elements<SharedPtrOwnership>;
+using CheckedValue = BasicBorrowedSlice<SharedPtrOwnership>;
+static_assert(std::ranges::input_range<CheckedSource&>);
+static_assert(
+    std::ranges::input_range<Members<SharedPtrOwnership, Member::key>&>);
+static_assert(
+    std::ranges::input_range<Members<SharedPtrOwnership, Member::both>&>);
+static_assert(std::ranges::input_range<
+              Filter<CheckedSource, bool (*)(CheckedValue const&)>&>);
+static_assert(std::ranges::input_range<
+              Transform<CheckedSource, CheckedValue (*)(CheckedValue)>&>);
+static_assert(std::ranges::input_range<Take<CheckedSource>&>);
+static_assert(std::ranges::input_range<Drop<CheckedSource>&>);
+static_assert(std::ranges::input_range<Enumerate<CheckedSource>&>);
+}  // namespace detail
+#endif
+
+}  // namespace arangodb::velocypack::pipeline
+
+#endif  // SRC_PIPELINE_H
@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RandomAccessArray.h"
+
+#include <velocypack/Exception.h>
+#include <velocypack/Iterator.h>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+template <typename OwnershipPolicy>
+BasicRandomAccessArray<OwnershipPolicy>::BasicRandomAccessArray(
+    SharedSliceType array)
+    : _array(std::move(array)) {
+  auto const slice = _array.slice();
+  if (!slice.isArray()) {
+    throw Exception(Exception::InvalidValueType, "Expecting Array");
+  }
+  _size = static_cast<std::size_t>(slice.length());
+  if (slice.head() == 0x13 && _size > 0) {
+    // Compact, getNthOffset() would scan from the start every time
+    _offsets.reserve(_size);
+    for (auto it = ArrayIterator(slice); it.valid(); it.next()) {
+      _offsets.emplace_back(
+          static_cast<ValueLength>(it.value().start() - slice.start()));
+    }
+  }
+}
+
+template class arangodb::velocypack::BasicRandomAccessArray<SharedPtrOwnership>;
+template class arangodb::velocypack::BasicRandomAccessArray<IntrusiveOwnership>;
+template class arangodb::velocypack::BasicRandomAccessArray<LocalOwnership>;
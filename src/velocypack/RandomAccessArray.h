@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_RANDOMACCESSARRAY_H
+#define SRC_RANDOMACCESSARRAY_H
+
+#include "velocypack/BorrowedSlice.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Slice.h>
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace arangodb::velocypack {
+
+/**
+ * @brief A random access view of the elements of a SharedSlice array, e.g.
+ *        for std::lower_bound() or other standard algorithms.
+ *
+ *        Elements are located with getNthOffset(), which takes constant time
+ *        for arrays with an index table and arrays of equally sized
+ *        elements. For compact arrays, which have neither, the constructor
+ *        records all offsets in one pass.
+ *
+ *        Elements are borrowed from the view's own reference to the array,
+ *        so the view must outlive its iterators and the borrowed slices. It
+ *        cannot be copied or moved for the same reason.
+ */
+template <typename OwnershipPolicy>
+class BasicRandomAccessArray {
+ public:
+  using SharedSliceType = BasicSharedSlice<OwnershipPolicy>;
+  using BorrowedSliceType = BasicBorrowedSlice<OwnershipPolicy>;
+
+  class iterator {
+   public:
+    // Dereferencing returns a proxy by value. Like other proxy iterators,
+    // e.g. std::vector<bool>'s, it still claims random access, so that
+    // algorithms (and the parallel ones split the range) dispatch on it.
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept = std::random_access_iterator_tag;
+    using value_type = BorrowedSliceType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = BorrowedSliceType;
+
+    iterator() noexcept = default;
+
+    reference operator*() const { return (*_array)[_index]; }
+    reference operator[](difference_type n) const {
+      return (*_array)[static_cast<ValueLength>(_index + n)];
+    }
+
+    iterator& operator++() noexcept {
+      ++_index;
+      return *this;
+    }
+    iterator operator++(int) noexcept {
+      auto result = *this;
+      ++_index;
+      return result;
+    }
+    iterator& operator--() noexcept {
+      --_index;
+      return *this;
+    }
+    iterator operator--(int) noexcept {
+      auto result = *this;
+      --_index;
+      return result;
+    }
+    iterator& operator+=(difference_type n) noexcept {
+      _index += n;
+      return *this;
+    }
+    iterator& operator-=(difference_type n) noexcept {
+      _index -= n;
+      return *this;
+    }
+
+    friend iterator operator+(iterator it, difference_type n) noexcept {
+      return it += n;
+    }
+    friend iterator operator+(difference_type n, iterator it) noexcept {
+      return it += n;
+    }
+    friend iterator operator-(iterator it, difference_type n) noexcept {
+      return it -= n;
+    }
+    friend difference_type operator-(iterator const& left,
+                                     iterator const& right) noexcept {
+      return left._index - right._index;
+    }
+
+    friend bool operator==(iterator const& left,
+                           iterator const& right) noexcept {
+      return left._index == right._index;
+    }
+    friend bool operator!=(iterator const& left,
+                           iterator const& right) noexcept {
+      return left._index != right._index;
+    }
+    friend bool operator<(iterator const& left,
+                          iterator const& right) noexcept {
+      return left._index < right._index;
+    }
+    friend bool operator>(iterator const& left,
+                          iterator const& right) noexcept {
+      return left._index > right._index;
+    }
+    friend bool operator<=(iterator const& left,
+                           iterator const& right) noexcept {
+      return left._index <= right._index;
+    }
+    friend bool operator>=(iterator const& left,
+                           iterator const& right) noexcept {
+      return left._index >= right._index;
+    }
+
+    // The index of the element this iterator points to
+    [[nodiscard]] ValueLength index() const noexcept {
+      return static_cast<ValueLength>(_index);
+    }
+
+   private:
+    friend class BasicRandomAccessArray;
+
+    iterator(BasicRandomAccessArray const* array,
+             difference_type index) noexcept
+        : _array(array), _index(index) {}
+
+    BasicRandomAccessArray const* _array = nullptr;
+    difference_type _index = 0;
+  };
+  using const_iterator = iterator;
+
+  // array must be an array, otherwise an Exception is thrown
+  explicit BasicRandomAccessArray(SharedSliceType array);
+
+  BasicRandomAccessArray(BasicRandomAccessArray const&) = delete;
+  BasicRandomAccessArray(BasicRandomAccessArray&&) = delete;
+  BasicRandomAccessArray& operator=(BasicRandomAccessArray const&) = delete;
+  BasicRandomAccessArray& operator=(BasicRandomAccessArray&&) = delete;
+  ~BasicRandomAccessArray() = default;
+
+  [[nodiscard]] std::size_t size() const noexcept { return _size; }
+  [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+
+  // index must be less than size()
+  [[nodiscard]] BorrowedSliceType operator[](ValueLength index) const {
+    auto const offset =
+        _offsets.empty() ? _array.slice().getNthOffset(index) : _offsets[index];
+    return BorrowedSliceType(_array, Slice(_array.slice().start() + offset));
+  }
+
+  [[nodiscard]] iterator begin() const noexcept { return iterator(this, 0); }
+  [[nodiscard]] iterator end() const noexcept {
+    return iterator(this,
+                    static_cast<typename iterator::difference_type>(_size));
+  }
+
+  [[nodiscard]] SharedSliceType const& array() const noexcept { return _array; }
+
+ private:
+  SharedSliceType _array;
+  std::size_t _size;
+  // Offsets of all elements of compact arrays, empty otherwise
+  std::vector<ValueLength> _offsets;
+};
+
+using RandomAccessArray = BasicRandomAccessArray<SharedPtrOwnership>;
+using IntrusiveRandomAccessArray = BasicRandomAccessArray<IntrusiveOwnership>;
+using LocalRandomAccessArray = BasicRandomAccessArray<LocalOwnership>;
+
+extern template class BasicRandomAccessArray<SharedPtrOwnership>;
+extern template class BasicRandomAccessArray<IntrusiveOwnership>;
+extern template class BasicRandomAccessArray<LocalOwnership>;
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_RANDOMACCESSARRAY_H
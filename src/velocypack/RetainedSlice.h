@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_RETAINEDSLICE_H
+#define SRC_RETAINEDSLICE_H
+
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Slice.h>
+
+#include <utility>
+
+namespace arangodb::velocypack {
+
+// The RetentionPolicy of a BasicRetainedSlice. A type rather than a member,
+// so a holder is no bigger than the slice it holds.
+struct DefaultRetention {
+  [[nodiscard]] static constexpr RetentionPolicy policy() noexcept {
+    return {};
+  }
+};
+
+/**
+ * @brief Holds a slice for a long time, e.g. as an element of a container
+ *        or a cache: every slice stored into it goes through
+ *        BasicSharedSlice::retain() with Retention::policy(), so a small
+ *        value cannot pin a large buffer by accident.
+ *
+ *        Converts implicitly from and to the slice, so e.g. push_back() on a
+ *        std::vector<RetainedSlice> applies the policy on every insert.
+ */
+template <typename OwnershipPolicy, typename Retention = DefaultRetention>
+class BasicRetainedSlice {
+ public:
+  using shared_slice_type = BasicSharedSlice<OwnershipPolicy>;
+
+  BasicRetainedSlice() = default;
+  // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+  BasicRetainedSlice(shared_slice_type const& sharedSlice)
+      : _sharedSlice(sharedSlice.retain(Retention::policy())) {}
+
+  BasicRetainedSlice& operator=(shared_slice_type const& sharedSlice) {
+    _sharedSlice = sharedSlice.retain(Retention::policy());
+    return *this;
+  }
+
+  [[nodiscard]] shared_slice_type const& get() const noexcept {
+    return _sharedSlice;
+  }
+  // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+  operator shared_slice_type const&() const noexcept { return _sharedSlice; }
+  shared_slice_type const* operator->() const noexcept { return &_sharedSlice; }
+
+  [[nodiscard]] Slice slice() const noexcept { return _sharedSlice.slice(); }
+
+ private:
+  shared_slice_type _sharedSlice;
+};
+
+using RetainedSlice = BasicRetainedSlice<SharedPtrOwnership>;
+using IntrusiveRetainedSlice = BasicRetainedSlice<IntrusiveOwnership>;
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_RETAINEDSLICE_H
@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ShardedPtr.h"
+
+#include "BufferCaches.h"
+#include "IntrusivePtr.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <thread>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+std::size_t detail::refCountShards() noexcept {
+  static std::size_t const shards = [] {
+    auto const threads =
+        std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    auto shards = std::size_t{1};
+    while (shards < threads && shards < maxRefCountShards) {
+      shards *= 2;
+    }
+    return shards;
+  }();
+  return shards;
+}
+
+std::uint32_t detail::assignRefCountShard() noexcept {
+  static std::atomic<std::uint32_t> nextShard{0};
+  return nextShard.fetch_add(1, std::memory_order_relaxed) &
+         static_cast<std::uint32_t>(refCountShards() - 1);
+}
+
+namespace {
+std::size_t shardBytes() noexcept {
+  return detail::refCountShards() * sizeof(detail::RefCountShard);
+}
+}  // namespace
+
+void* detail::allocateSharded(std::size_t size) {
+  auto const prefix = shardBytes();
+  auto* block = static_cast<RefCountShard*>(
+      ::operator new (prefix + size, std::align_val_t{alignof(RefCountShard)}));
+  for (std::size_t shard = 0; shard < refCountShards(); ++shard) {
+    new (block + shard) RefCountShard();
+  }
+  return reinterpret_cast<std::byte*>(block) + prefix;
+}
+
+void detail::deallocateSharded(void* header) noexcept {
+  // RefCountShard is trivially destructible
+  ::operator delete (static_cast<std::byte*>(header) - shardBytes(),
+                     std::align_val_t{alignof(RefCountShard)});
+}
+
+std::size_t detail::ShardedRefCount::load() const noexcept {
+  auto sum = std::size_t{0};
+  for (std::size_t shard = 0; shard < refCountShards(); ++shard) {
+    sum += this->shardAt(static_cast<std::uint32_t>(shard))
+               .value.load(std::memory_order_relaxed);
+  }
+  return sum;
+}
+
+namespace {
+struct BufferHeader : detail::ShardedHeader {
+  BufferHeader(void (*destroy)(detail::ShardedHeader*) noexcept,
+               std::uint32_t shard, std::size_t size)
+      : detail::ShardedHeader(destroy, shard), size(size) {}
+
+  std::size_t size;
+  detail::LazyBufferCaches caches;
+};
+
+constexpr std::size_t headerSize = detail::payloadOffset<BufferHeader>;
+
+void destroyBuffer(detail::ShardedHeader* header) noexcept {
+  static_cast<BufferHeader*>(header)->~BufferHeader();
+  detail::deallocateSharded(header);
+}
+}  // namespace
+
+ShardedPtr<uint8_t> velocypack::allocateShardedBuffer(std::size_t size) {
+  auto const shard = detail::currentRefCountShard();
+  void* block = detail::allocateSharded(headerSize + size);
+  BufferHeader* header = nullptr;
+  try {
+    header = new (block) BufferHeader(&destroyBuffer, shard, size);
+  } catch (...) {
+    detail::deallocateSharded(block);
+    throw;
+  }
+  auto* data = static_cast<uint8_t*>(block) + headerSize;
+  return ShardedPtr<uint8_t>::adopt(header, data, shard);
+}
+
+std::optional<std::size_t> velocypack::shardedBufferSize(
+    detail::ShardedHeader const* header) noexcept {
+  if (header == nullptr || header->destroy != &destroyBuffer) {
+    return std::nullopt;
+  }
+  return static_cast<BufferHeader const*>(header)->size;
+}
+
+detail::LazyBufferCaches const* velocypack::shardedBufferCaches(
+    detail::ShardedHeader const* header) {
+  if (header == nullptr || header->destroy != &destroyBuffer) {
+    return nullptr;
+  }
+  return &static_cast<BufferHeader const*>(header)->caches;
+}
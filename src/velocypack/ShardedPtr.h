@@ -0,0 +1,318 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_SHARDEDPTR_H
+#define SRC_SHARDEDPTR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace arangodb::velocypack {
+
+namespace detail {
+class LazyBufferCaches;
+
+// A reference count on a cache line of its own
+struct alignas(64) RefCountShard {
+  std::atomic<std::size_t> value{0};
+};
+
+constexpr std::size_t maxRefCountShards = 64;
+
+// The number of shards of every sharded refcount: the number of hardware
+// threads rounded up to a power of two, at most maxRefCountShards
+[[nodiscard]] std::size_t refCountShards() noexcept;
+
+// Assigns threads to shards round-robin
+[[nodiscard]] std::uint32_t assignRefCountShard() noexcept;
+
+// The shard the calling thread counts its references in
+[[nodiscard]] inline std::uint32_t currentRefCountShard() noexcept {
+  thread_local std::uint32_t const shard = assignRefCountShard();
+  return shard;
+}
+
+// A reference count split into per-thread shards, so threads copying the
+// same pointer don't contend on one cache line. Every reference is counted
+// in, and released from, a single shard. The payload is destroyed once the
+// number of shards with references drops to zero.
+//
+// The shards live right in front of the refcount, in the block returned by
+// allocateSharded(), shard i at the i-th cache line before it. So a
+// ShardedRefCount must be the first member of a ShardedHeader placed at the
+// start of such a block.
+class ShardedRefCount {
+ public:
+  // Starts with one reference, in shard
+  explicit ShardedRefCount(std::uint32_t shard) noexcept {
+    this->shardAt(shard).value.store(1, std::memory_order_relaxed);
+  }
+
+  ShardedRefCount(ShardedRefCount const&) = delete;
+  ShardedRefCount& operator=(ShardedRefCount const&) = delete;
+
+  void increment(std::uint32_t shard) noexcept {
+    if (this->shardAt(shard).value.fetch_add(1, std::memory_order_relaxed) ==
+        0) {
+      _nonZeroShards.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  // Returns true if this was the last reference
+  [[nodiscard]] bool decrement(std::uint32_t shard) noexcept {
+    return this->shardAt(shard).value.fetch_sub(1, std::memory_order_acq_rel) ==
+               1 &&
+           _nonZeroShards.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+  // Only a snapshot while other threads count
+  [[nodiscard]] std::size_t load() const noexcept;
+
+ private:
+  [[nodiscard]] RefCountShard& shardAt(std::uint32_t shard) const noexcept {
+    auto* self =
+        reinterpret_cast<RefCountShard*>(const_cast<ShardedRefCount*>(this));
+    return *std::launder(self - 1 - shard);
+  }
+
+ private:
+  std::atomic<std::size_t> _nonZeroShards{1};
+};
+
+// Lives in front of the payload of every allocation with a sharded refcount
+struct ShardedHeader {
+  ShardedHeader(void (*destroy)(ShardedHeader*) noexcept, std::uint32_t shard)
+      : refCount(shard), destroy(destroy) {}
+
+  ShardedRefCount refCount;
+  // Destroys the payload and frees the whole allocation
+  void (*const destroy)(ShardedHeader*) noexcept;
+};
+
+// Allocates one block of refCountShards() zeroed shards followed by `size`
+// bytes for a ShardedHeader and its payload, and returns the latter. The
+// header is aligned to a cache line.
+[[nodiscard]] void* allocateSharded(std::size_t size);
+// Frees a block, given the pointer allocateSharded() returned
+void deallocateSharded(void* header) noexcept;
+}  // namespace detail
+
+/**
+ * @brief Like IntrusivePtr, but with a sharded reference count, see
+ *        detail::ShardedRefCount.
+ *
+ *        A copy counts its reference in the copying thread's shard, and
+ *        remembers the shard to release it from there, so pointers may be
+ *        passed between threads freely. Copying and releasing on the same
+ *        thread only touches that thread's cache line; use it for a few
+ *        hot buffers many threads copy, as every allocation carries a
+ *        cache line per shard.
+ */
+template <typename T>
+class ShardedPtr {
+ public:
+  using element_type = T;
+
+  constexpr ShardedPtr() noexcept = default;
+
+  // Aliasing constructors
+  template <typename U>
+  ShardedPtr(ShardedPtr<U> const& other, T* ptr) noexcept
+      : _ptr(ptr), _header(other._header) {
+    acquire();
+  }
+  template <typename U>
+  ShardedPtr(ShardedPtr<U>&& other, T* ptr) noexcept
+      : _ptr(ptr),
+        _header(std::exchange(other._header, nullptr)),
+        _shard(other._shard) {
+    other._ptr = nullptr;
+  }
+
+  // Converting constructors
+  template <typename U,
+            typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  ShardedPtr(ShardedPtr<U> const&
+                 other) noexcept  // NOLINT(google-explicit-constructor)
+      : ShardedPtr(other, other.get()) {}
+  template <typename U,
+            typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  ShardedPtr(
+      ShardedPtr<U>&& other) noexcept  // NOLINT(google-explicit-constructor)
+      : ShardedPtr(std::move(other), other.get()) {}
+
+  ShardedPtr(ShardedPtr const& other) noexcept
+      : _ptr(other._ptr), _header(other._header) {
+    acquire();
+  }
+  ShardedPtr(ShardedPtr&& other) noexcept
+      : _ptr(std::exchange(other._ptr, nullptr)),
+        _header(std::exchange(other._header, nullptr)),
+        _shard(other._shard) {}
+
+  ShardedPtr& operator=(ShardedPtr const& other) noexcept {
+    ShardedPtr(other).swap(*this);
+    return *this;
+  }
+  ShardedPtr& operator=(ShardedPtr&& other) noexcept {
+    ShardedPtr(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  ~ShardedPtr() { release(); }
+
+  void swap(ShardedPtr& other) noexcept {
+    std::swap(_ptr, other._ptr);
+    std::swap(_header, other._header);
+    std::swap(_shard, other._shard);
+  }
+
+  void reset() noexcept { ShardedPtr().swap(*this); }
+
+  [[nodiscard]] T* get() const noexcept { return _ptr; }
+
+  template <typename U = T>
+  [[nodiscard]] U& operator*() const noexcept {
+    return *_ptr;
+  }
+
+  T* operator->() const noexcept { return _ptr; }
+
+  [[nodiscard]] long use_count() const noexcept {
+    return _header == nullptr ? 0 : static_cast<long>(_header->refCount.load());
+  }
+
+  explicit operator bool() const noexcept { return _ptr != nullptr; }
+
+  // The header of the allocation this pointer shares, if any
+  [[nodiscard]] detail::ShardedHeader* header() const noexcept {
+    return _header;
+  }
+
+  template <typename U>
+  [[nodiscard]] bool owner_before(ShardedPtr<U> const& other) const noexcept {
+    return std::less<>{}(_header, other._header);
+  }
+
+  // Takes over the reference header was created with, in shard
+  [[nodiscard]] static ShardedPtr adopt(detail::ShardedHeader* header, T* ptr,
+                                        std::uint32_t shard) noexcept {
+    auto result = ShardedPtr();
+    result._header = header;
+    result._ptr = ptr;
+    result._shard = shard;
+    return result;
+  }
+
+ private:
+  template <typename>
+  friend class ShardedPtr;
+
+  void acquire() noexcept {
+    if (_header != nullptr) {
+      _shard = detail::currentRefCountShard();
+      _header->refCount.increment(_shard);
+    }
+  }
+
+  void release() noexcept {
+    if (_header != nullptr && _header->refCount.decrement(_shard)) {
+      _header->destroy(_header);
+    }
+  }
+
+ private:
+  T* _ptr = nullptr;
+  detail::ShardedHeader* _header = nullptr;
+  // The shard this pointer's reference is counted in
+  std::uint32_t _shard = 0;
+};
+
+template <typename T, typename U>
+bool operator==(ShardedPtr<T> const& left,
+                ShardedPtr<U> const& right) noexcept {
+  return left.get() == right.get();
+}
+
+template <typename T, typename U>
+bool operator!=(ShardedPtr<T> const& left,
+                ShardedPtr<U> const& right) noexcept {
+  return left.get() != right.get();
+}
+
+// Allocates the shards, a header and `size` uninitialized bytes in one block
+[[nodiscard]] ShardedPtr<uint8_t> allocateShardedBuffer(std::size_t size);
+
+// Returns the size passed to allocateShardedBuffer() if header belongs to an
+// allocation made by it, and std::nullopt otherwise.
+[[nodiscard]] std::optional<std::size_t> shardedBufferSize(
+    detail::ShardedHeader const* header) noexcept;
+
+// Returns the caches of an allocation made by allocateShardedBuffer(), and
+// nullptr for any other header.
+[[nodiscard]] detail::LazyBufferCaches const* shardedBufferCaches(
+    detail::ShardedHeader const* header);
+
+namespace detail {
+template <typename T>
+struct ShardedBlock : ShardedHeader {
+  template <typename... Args>
+  explicit ShardedBlock(std::uint32_t shard, Args&&... args)
+      : ShardedHeader(&destroyBlock, shard),
+        value(std::forward<Args>(args)...) {}
+
+  static void destroyBlock(ShardedHeader* header) noexcept {
+    auto* block = static_cast<ShardedBlock*>(header);
+    block->~ShardedBlock();
+    deallocateSharded(block);
+  }
+
+  T value;
+};
+}  // namespace detail
+
+// Allocates the shards, a header and a T constructed from args in one block
+template <typename T, typename... Args>
+[[nodiscard]] ShardedPtr<T> makeSharded(Args&&... args) {
+  static_assert(alignof(T) <= alignof(detail::RefCountShard),
+                "the header is only aligned to a cache line");
+  auto const shard = detail::currentRefCountShard();
+  void* memory = detail::allocateSharded(sizeof(detail::ShardedBlock<T>));
+  detail::ShardedBlock<T>* block = nullptr;
+  try {
+    block = new (memory)
+        detail::ShardedBlock<T>(shard, std::forward<Args>(args)...);
+  } catch (...) {
+    detail::deallocateSharded(memory);
+    throw;
+  }
+  return ShardedPtr<T>::adopt(block, &block->value, shard);
+}
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_SHARDEDPTR_H
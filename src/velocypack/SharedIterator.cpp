@@ -25,170 +25,514 @@
 using namespace arangodb;
 using namespace arangodb::velocypack;
 
-SharedArrayIterator::SharedArrayIterator(SharedSlice&& slice)
+template <typename OwnershipPolicy>
+BasicSharedArrayIterator<OwnershipPolicy>::BasicSharedArrayIterator(
+    SharedSliceType&& slice)
     : _slice(std::move(slice)), _iterator(_slice.slice()) {}
 
-SharedArrayIterator::SharedArrayIterator(SharedSlice const& slice)
+template <typename OwnershipPolicy>
+BasicSharedArrayIterator<OwnershipPolicy>::BasicSharedArrayIterator(
+    SharedSliceType const& slice)
     : _slice(slice), _iterator(_slice.slice()) {}
 
-SharedArrayIterator& SharedArrayIterator::operator++() {
+template <typename OwnershipPolicy>
+auto BasicSharedArrayIterator<OwnershipPolicy>::operator++()
+    -> BasicSharedArrayIterator& {
   iterator().operator++();
   return *this;
 }
 
-SharedArrayIterator SharedArrayIterator::operator++(int) & {
-  SharedArrayIterator result(*this);
+template <typename OwnershipPolicy>
+auto BasicSharedArrayIterator<OwnershipPolicy>::operator++(
+    int) & -> BasicSharedArrayIterator {
+  BasicSharedArrayIterator result(*this);
   this->operator++();
   return result;
 }
 
-bool SharedArrayIterator::operator!=(SharedArrayIterator const& other) const noexcept {
+template <typename OwnershipPolicy>
+bool BasicSharedArrayIterator<OwnershipPolicy>::operator!=(
+    BasicSharedArrayIterator const& other) const noexcept {
   return iterator() != other.iterator();
 }
 
-SharedSlice SharedArrayIterator::operator*() const {
+template <typename OwnershipPolicy>
+auto BasicSharedArrayIterator<OwnershipPolicy>::operator*() const
+    -> SharedSliceType {
   return alias(iterator().operator*());
 }
 
-SharedArrayIterator SharedArrayIterator::begin() const {
-  auto it = SharedArrayIterator(*this);
+template <typename OwnershipPolicy>
+auto BasicSharedArrayIterator<OwnershipPolicy>::begin() const
+    -> BasicSharedArrayIterator {
+  auto it = BasicSharedArrayIterator(*this);
   it.iterator().begin();
   return it;
 }
 
-SharedArrayIterator SharedArrayIterator::end() const {
-  auto it = SharedArrayIterator(*this);
+template <typename OwnershipPolicy>
+auto BasicSharedArrayIterator<OwnershipPolicy>::end() const
+    -> BasicSharedArrayIterator {
+  auto it = BasicSharedArrayIterator(*this);
   it.iterator().end();
   return it;
 }
 
-bool SharedArrayIterator::valid() const noexcept { return iterator().valid(); }
+template <typename OwnershipPolicy>
+bool BasicSharedArrayIterator<OwnershipPolicy>::valid() const noexcept {
+  return iterator().valid();
+}
 
-SharedSlice SharedArrayIterator::value() const { return operator*(); }
+template <typename OwnershipPolicy>
+auto BasicSharedArrayIterator<OwnershipPolicy>::value() const
+    -> SharedSliceType {
+  return operator*();
+}
 
-void SharedArrayIterator::next() { operator++(); }
+template <typename OwnershipPolicy>
+void BasicSharedArrayIterator<OwnershipPolicy>::next() {
+  operator++();
+}
 
-ValueLength SharedArrayIterator::index() const noexcept {
+template <typename OwnershipPolicy>
+ValueLength BasicSharedArrayIterator<OwnershipPolicy>::index() const noexcept {
   return iterator().index();
 }
 
-ValueLength SharedArrayIterator::size() const noexcept {
+template <typename OwnershipPolicy>
+ValueLength BasicSharedArrayIterator<OwnershipPolicy>::size() const noexcept {
   return iterator().size();
 }
 
-bool SharedArrayIterator::isFirst() const noexcept {
+template <typename OwnershipPolicy>
+bool BasicSharedArrayIterator<OwnershipPolicy>::isFirst() const noexcept {
   return iterator().isFirst();
 }
 
-bool SharedArrayIterator::isLast() const noexcept {
+template <typename OwnershipPolicy>
+bool BasicSharedArrayIterator<OwnershipPolicy>::isLast() const noexcept {
   return iterator().isLast();
 }
 
-void SharedArrayIterator::forward(ValueLength count) {
+template <typename OwnershipPolicy>
+void BasicSharedArrayIterator<OwnershipPolicy>::forward(ValueLength count) {
   iterator().forward(count);
 }
 
-void SharedArrayIterator::reset() { iterator().reset(); }
+template <typename OwnershipPolicy>
+void BasicSharedArrayIterator<OwnershipPolicy>::reset() {
+  iterator().reset();
+}
 
-SharedSlice& SharedArrayIterator::sharedSlice() noexcept { return _slice; }
+template <typename OwnershipPolicy>
+auto BasicSharedArrayIterator<OwnershipPolicy>::sharedSlice() noexcept
+    -> SharedSliceType& {
+  return _slice;
+}
 
-SharedSlice const& SharedArrayIterator::sharedSlice() const noexcept {
+template <typename OwnershipPolicy>
+auto BasicSharedArrayIterator<OwnershipPolicy>::sharedSlice() const noexcept
+    -> SharedSliceType const& {
   return _slice;
 }
 
-ArrayIterator& SharedArrayIterator::iterator() noexcept { return _iterator; }
+template <typename OwnershipPolicy>
+ArrayIterator& BasicSharedArrayIterator<OwnershipPolicy>::iterator() noexcept {
+  return _iterator;
+}
 
-ArrayIterator const& SharedArrayIterator::iterator() const noexcept {
+template <typename OwnershipPolicy>
+ArrayIterator const& BasicSharedArrayIterator<OwnershipPolicy>::iterator()
+    const noexcept {
   return _iterator;
 }
 
-SharedSlice SharedArrayIterator::alias(Slice slice) const noexcept {
-  return SharedSlice(sharedSlice(), slice);
+template <typename OwnershipPolicy>
+auto BasicSharedArrayIterator<OwnershipPolicy>::alias(
+    Slice slice) const noexcept -> SharedSliceType {
+  return SharedSliceType(sharedSlice(), slice);
 }
 
-SharedObjectIterator::ObjectPair::ObjectPair(SharedSlice key, SharedSlice value) noexcept
+template <typename OwnershipPolicy>
+BasicSharedObjectIterator<OwnershipPolicy>::ObjectPair::ObjectPair(
+    SharedSliceType key, SharedSliceType value) noexcept
     : key(std::move(key)), value(std::move(value)) {}
 
-SharedObjectIterator::SharedObjectIterator(SharedSlice&& slice, bool useSequentialIteration)
-    : _slice(std::move(slice)), _iterator(_slice.slice(), useSequentialIteration) {}
+template <typename OwnershipPolicy>
+BasicSharedObjectIterator<OwnershipPolicy>::BasicSharedObjectIterator(
+    SharedSliceType&& slice, bool useSequentialIteration)
+    : _slice(std::move(slice)),
+      _iterator(_slice.slice(), useSequentialIteration) {}
 
-SharedObjectIterator::SharedObjectIterator(SharedSlice const& slice, bool useSequentialIteration)
+template <typename OwnershipPolicy>
+BasicSharedObjectIterator<OwnershipPolicy>::BasicSharedObjectIterator(
+    SharedSliceType const& slice, bool useSequentialIteration)
     : _slice(slice), _iterator(_slice.slice(), useSequentialIteration) {}
 
-SharedObjectIterator& SharedObjectIterator::operator++() {
+template <typename OwnershipPolicy>
+auto BasicSharedObjectIterator<OwnershipPolicy>::operator++()
+    -> BasicSharedObjectIterator& {
   iterator().operator++();
   return *this;
 }
 
-SharedObjectIterator SharedObjectIterator::operator++(int) & {
-  SharedObjectIterator result(*this);
+template <typename OwnershipPolicy>
+auto BasicSharedObjectIterator<OwnershipPolicy>::operator++(
+    int) & -> BasicSharedObjectIterator {
+  BasicSharedObjectIterator result(*this);
   iterator().operator++();
   return result;
 }
 
-bool SharedObjectIterator::operator!=(SharedObjectIterator const& other) const {
+template <typename OwnershipPolicy>
+bool BasicSharedObjectIterator<OwnershipPolicy>::operator!=(
+    BasicSharedObjectIterator const& other) const {
   return iterator() != other.iterator();
 }
 
-SharedObjectIterator::ObjectPair SharedObjectIterator::operator*() const {
+template <typename OwnershipPolicy>
+auto BasicSharedObjectIterator<OwnershipPolicy>::operator*() const
+    -> ObjectPair {
   auto pair = iterator().operator*();
   return ObjectPair(alias(pair.key), alias(pair.value));
 }
 
-SharedObjectIterator SharedObjectIterator::begin() const {
-  auto it = SharedObjectIterator(*this);
+template <typename OwnershipPolicy>
+auto BasicSharedObjectIterator<OwnershipPolicy>::begin() const
+    -> BasicSharedObjectIterator {
+  auto it = BasicSharedObjectIterator(*this);
   it.iterator().begin();
   return it;
 }
 
-SharedObjectIterator SharedObjectIterator::end() const {
-  auto it = SharedObjectIterator(*this);
+template <typename OwnershipPolicy>
+auto BasicSharedObjectIterator<OwnershipPolicy>::end() const
+    -> BasicSharedObjectIterator {
+  auto it = BasicSharedObjectIterator(*this);
   it.iterator().end();
   return it;
 }
 
-bool SharedObjectIterator::valid() const noexcept { return iterator().valid(); }
+template <typename OwnershipPolicy>
+bool BasicSharedObjectIterator<OwnershipPolicy>::valid() const noexcept {
+  return iterator().valid();
+}
 
-SharedSlice SharedObjectIterator::key(bool translate) const {
+template <typename OwnershipPolicy>
+auto BasicSharedObjectIterator<OwnershipPolicy>::key(bool translate) const
+    -> SharedSliceType {
   return alias(iterator().key(translate));
 }
 
-SharedSlice SharedObjectIterator::value() const {
+template <typename OwnershipPolicy>
+auto BasicSharedObjectIterator<OwnershipPolicy>::value() const
+    -> SharedSliceType {
   return alias(iterator().value());
 }
 
-void SharedObjectIterator::next() { operator++(); }
+template <typename OwnershipPolicy>
+void BasicSharedObjectIterator<OwnershipPolicy>::next() {
+  operator++();
+}
 
-ValueLength SharedObjectIterator::index() const noexcept {
+template <typename OwnershipPolicy>
+ValueLength BasicSharedObjectIterator<OwnershipPolicy>::index() const noexcept {
   return iterator().index();
 }
 
-ValueLength SharedObjectIterator::size() const noexcept {
+template <typename OwnershipPolicy>
+ValueLength BasicSharedObjectIterator<OwnershipPolicy>::size() const noexcept {
   return iterator().size();
 }
 
-bool SharedObjectIterator::isFirst() const noexcept {
+template <typename OwnershipPolicy>
+bool BasicSharedObjectIterator<OwnershipPolicy>::isFirst() const noexcept {
   return iterator().isFirst();
 }
 
-bool SharedObjectIterator::isLast() const noexcept {
+template <typename OwnershipPolicy>
+bool BasicSharedObjectIterator<OwnershipPolicy>::isLast() const noexcept {
   return iterator().isLast();
 }
 
-void SharedObjectIterator::reset() { iterator().reset(); }
+template <typename OwnershipPolicy>
+void BasicSharedObjectIterator<OwnershipPolicy>::reset() {
+  iterator().reset();
+}
 
-SharedSlice& SharedObjectIterator::sharedSlice() noexcept { return _slice; }
+template <typename OwnershipPolicy>
+auto BasicSharedObjectIterator<OwnershipPolicy>::sharedSlice() noexcept
+    -> SharedSliceType& {
+  return _slice;
+}
 
-SharedSlice const& SharedObjectIterator::sharedSlice() const noexcept {
+template <typename OwnershipPolicy>
+auto BasicSharedObjectIterator<OwnershipPolicy>::sharedSlice() const noexcept
+    -> SharedSliceType const& {
   return _slice;
 }
 
-ObjectIterator& SharedObjectIterator::iterator() noexcept { return _iterator; }
+template <typename OwnershipPolicy>
+ObjectIterator&
+BasicSharedObjectIterator<OwnershipPolicy>::iterator() noexcept {
+  return _iterator;
+}
 
-ObjectIterator const& SharedObjectIterator::iterator() const noexcept {
+template <typename OwnershipPolicy>
+ObjectIterator const& BasicSharedObjectIterator<OwnershipPolicy>::iterator()
+    const noexcept {
   return _iterator;
 }
 
-SharedSlice SharedObjectIterator::alias(Slice slice) const noexcept {
-  return SharedSlice(sharedSlice(), slice);
+template <typename OwnershipPolicy>
+auto BasicSharedObjectIterator<OwnershipPolicy>::alias(
+    Slice slice) const noexcept -> SharedSliceType {
+  return SharedSliceType(sharedSlice(), slice);
+}
+
+template <typename OwnershipPolicy>
+BasicBorrowedArrayIterator<OwnershipPolicy>::BasicBorrowedArrayIterator(
+    SharedSliceType const& slice)
+    : _slice(&slice), _iterator(slice.slice()) {}
+
+template <typename OwnershipPolicy>
+auto BasicBorrowedArrayIterator<OwnershipPolicy>::operator++()
+    -> BasicBorrowedArrayIterator& {
+  _iterator.operator++();
+  return *this;
+}
+
+template <typename OwnershipPolicy>
+auto BasicBorrowedArrayIterator<OwnershipPolicy>::operator++(
+    int) & -> BasicBorrowedArrayIterator {
+  BasicBorrowedArrayIterator result(*this);
+  this->operator++();
+  return result;
+}
+
+template <typename OwnershipPolicy>
+bool BasicBorrowedArrayIterator<OwnershipPolicy>::operator!=(
+    BasicBorrowedArrayIterator const& other) const noexcept {
+  return _iterator != other._iterator;
+}
+
+template <typename OwnershipPolicy>
+auto BasicBorrowedArrayIterator<OwnershipPolicy>::operator*() const
+    -> BorrowedSliceType {
+  return borrow(_iterator.operator*());
+}
+
+template <typename OwnershipPolicy>
+auto BasicBorrowedArrayIterator<OwnershipPolicy>::begin() const
+    -> BasicBorrowedArrayIterator {
+  auto it = BasicBorrowedArrayIterator(*this);
+  it._iterator.begin();
+  return it;
+}
+
+template <typename OwnershipPolicy>
+auto BasicBorrowedArrayIterator<OwnershipPolicy>::end() const
+    -> BasicBorrowedArrayIterator {
+  auto it = BasicBorrowedArrayIterator(*this);
+  it._iterator.end();
+  return it;
+}
+
+template <typename OwnershipPolicy>
+bool BasicBorrowedArrayIterator<OwnershipPolicy>::valid() const noexcept {
+  return _iterator.valid();
+}
+
+template <typename OwnershipPolicy>
+auto BasicBorrowedArrayIterator<OwnershipPolicy>::value() const
+    -> BorrowedSliceType {
+  return operator*();
+}
+
+template <typename OwnershipPolicy>
+void BasicBorrowedArrayIterator<OwnershipPolicy>::next() {
+  operator++();
+}
+
+template <typename OwnershipPolicy>
+ValueLength BasicBorrowedArrayIterator<OwnershipPolicy>::index()
+    const noexcept {
+  return _iterator.index();
+}
+
+template <typename OwnershipPolicy>
+ValueLength BasicBorrowedArrayIterator<OwnershipPolicy>::size() const noexcept {
+  return _iterator.size();
+}
+
+template <typename OwnershipPolicy>
+bool BasicBorrowedArrayIterator<OwnershipPolicy>::isFirst() const noexcept {
+  return _iterator.isFirst();
+}
+
+template <typename OwnershipPolicy>
+bool BasicBorrowedArrayIterator<OwnershipPolicy>::isLast() const noexcept {
+  return _iterator.isLast();
+}
+
+template <typename OwnershipPolicy>
+void BasicBorrowedArrayIterator<OwnershipPolicy>::forward(ValueLength count) {
+  _iterator.forward(count);
+}
+
+template <typename OwnershipPolicy>
+void BasicBorrowedArrayIterator<OwnershipPolicy>::reset() {
+  _iterator.reset();
+}
+
+template <typename OwnershipPolicy>
+auto BasicBorrowedArrayIterator<OwnershipPolicy>::borrow(
+    Slice slice) const noexcept -> BorrowedSliceType {
+  return BorrowedSliceType(*_slice, slice);
+}
+
+template <typename OwnershipPolicy>
+BasicBorrowedObjectIterator<OwnershipPolicy>::ObjectPair::ObjectPair(
+    BorrowedSliceType key, BorrowedSliceType value) noexcept
+    : key(key), value(value) {}
+
+template <typename OwnershipPolicy>
+BasicBorrowedObjectIterator<OwnershipPolicy>::BasicBorrowedObjectIterator(
+    SharedSliceType const& slice, bool useSequentialIteration)
+    : _slice(&slice), _iterator(slice.slice(), useSequentialIteration) {}
+
+template <typename OwnershipPolicy>
+auto BasicBorrowedObjectIterator<OwnershipPolicy>::operator++()
+    -> BasicBorrowedObjectIterator& {
+  _iterator.operator++();
+  return *this;
+}
+
+template <typename OwnershipPolicy>
+auto BasicBorrowedObjectIterator<OwnershipPolicy>::operator++(
+    int) & -> BasicBorrowedObjectIterator {
+  BasicBorrowedObjectIterator result(*this);
+  _iterator.operator++();
+  return result;
+}
+
+template <typename OwnershipPolicy>
+bool BasicBorrowedObjectIterator<OwnershipPolicy>::operator!=(
+    BasicBorrowedObjectIterator const& other) const {
+  return _iterator != other._iterator;
+}
+
+template <typename OwnershipPolicy>
+auto BasicBorrowedObjectIterator<OwnershipPolicy>::operator*() const
+    -> ObjectPair {
+  auto pair = _iterator.operator*();
+  return ObjectPair(borrow(pair.key), borrow(pair.value));
+}
+
+template <typename OwnershipPolicy>
+auto BasicBorrowedObjectIterator<OwnershipPolicy>::begin() const
+    -> BasicBorrowedObjectIterator {
+  auto it = BasicBorrowedObjectIterator(*this);
+  it._iterator.begin();
+  return it;
+}
+
+template <typename OwnershipPolicy>
+auto BasicBorrowedObjectIterator<OwnershipPolicy>::end() const
+    -> BasicBorrowedObjectIterator {
+  auto it = BasicBorrowedObjectIterator(*this);
+  it._iterator.end();
+  return it;
+}
+
+template <typename OwnershipPolicy>
+bool BasicBorrowedObjectIterator<OwnershipPolicy>::valid() const noexcept {
+  return _iterator.valid();
+}
+
+template <typename OwnershipPolicy>
+auto BasicBorrowedObjectIterator<OwnershipPolicy>::key(bool translate) const
+    -> BorrowedSliceType {
+  return borrow(_iterator.key(translate));
+}
+
+template <typename OwnershipPolicy>
+auto BasicBorrowedObjectIterator<OwnershipPolicy>::value() const
+    -> BorrowedSliceType {
+  return borrow(_iterator.value());
+}
+
+template <typename OwnershipPolicy>
+void BasicBorrowedObjectIterator<OwnershipPolicy>::next() {
+  operator++();
+}
+
+template <typename OwnershipPolicy>
+ValueLength BasicBorrowedObjectIterator<OwnershipPolicy>::index()
+    const noexcept {
+  return _iterator.index();
 }
+
+template <typename OwnershipPolicy>
+ValueLength BasicBorrowedObjectIterator<OwnershipPolicy>::size()
+    const noexcept {
+  return _iterator.size();
+}
+
+template <typename OwnershipPolicy>
+bool BasicBorrowedObjectIterator<OwnershipPolicy>::isFirst() const noexcept {
+  return _iterator.isFirst();
+}
+
+template <typename OwnershipPolicy>
+bool BasicBorrowedObjectIterator<OwnershipPolicy>::isLast() const noexcept {
+  return _iterator.isLast();
+}
+
+template <typename OwnershipPolicy>
+void BasicBorrowedObjectIterator<OwnershipPolicy>::reset() {
+  _iterator.reset();
+}
+
+template <typename OwnershipPolicy>
+auto BasicBorrowedObjectIterator<OwnershipPolicy>::borrow(
+    Slice slice) const noexcept -> BorrowedSliceType {
+  return BorrowedSliceType(*_slice, slice);
+}
+
+template class arangodb::velocypack::BasicSharedArrayIterator<
+    SharedPtrOwnership>;
+template class arangodb::velocypack::BasicSharedArrayIterator<
+    IntrusiveOwnership>;
+template class arangodb::velocypack::BasicSharedArrayIterator<LocalOwnership>;
+template class arangodb::velocypack::BasicSharedArrayIterator<EpochOwnership>;
+template class arangodb::velocypack::BasicSharedArrayIterator<ShardedOwnership>;
+
+template class arangodb::velocypack::BasicSharedObjectIterator<
+    SharedPtrOwnership>;
+template class arangodb::velocypack::BasicSharedObjectIterator<
+    IntrusiveOwnership>;
+template class arangodb::velocypack::BasicSharedObjectIterator<LocalOwnership>;
+template class arangodb::velocypack::BasicSharedObjectIterator<EpochOwnership>;
+template class arangodb::velocypack::BasicSharedObjectIterator<
+    ShardedOwnership>;
+
+template class arangodb::velocypack::BasicBorrowedArrayIterator<
+    SharedPtrOwnership>;
+template class arangodb::velocypack::BasicBorrowedArrayIterator<
+    IntrusiveOwnership>;
+template class arangodb::velocypack::BasicBorrowedArrayIterator<LocalOwnership>;
+template class arangodb::velocypack::BasicBorrowedArrayIterator<EpochOwnership>;
+template class arangodb::velocypack::BasicBorrowedArrayIterator<
+    ShardedOwnership>;
+
+template class arangodb::velocypack::BasicBorrowedObjectIterator<
+    SharedPtrOwnership>;
+template class arangodb::velocypack::BasicBorrowedObjectIterator<
+    IntrusiveOwnership>;
+template class arangodb::velocypack::BasicBorrowedObjectIterator<
+    LocalOwnership>;
+template class arangodb::velocypack::BasicBorrowedObjectIterator<
+    EpochOwnership>;
+template class arangodb::velocypack::BasicBorrowedObjectIterator<
+    ShardedOwnership>;
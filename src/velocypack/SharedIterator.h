@@ -23,6 +23,7 @@
 #ifndef SRC_SHAREDITERATOR_H
 #define SRC_SHAREDITERATOR_H
 
+#include "velocypack/BorrowedSlice.h"
 #include "velocypack/SharedSlice.h"
 
 #include <velocypack/Iterator.h>
@@ -31,30 +32,33 @@
 
 namespace arangodb::velocypack {
 
-class SharedArrayIterator {
+template <typename OwnershipPolicy>
+class BasicSharedArrayIterator {
  public:
-  SharedArrayIterator() = delete;
+  using SharedSliceType = BasicSharedSlice<OwnershipPolicy>;
 
-  explicit SharedArrayIterator(SharedSlice&& slice);
-  explicit SharedArrayIterator(SharedSlice const& slice);
+  BasicSharedArrayIterator() = delete;
+
+  explicit BasicSharedArrayIterator(SharedSliceType&& slice);
+  explicit BasicSharedArrayIterator(SharedSliceType const& slice);
 
   // prefix ++
-  SharedArrayIterator& operator++();
+  BasicSharedArrayIterator& operator++();
 
   // postfix ++
-  SharedArrayIterator operator++(int) &;
+  BasicSharedArrayIterator operator++(int) &;
 
-  bool operator!=(SharedArrayIterator const& other) const noexcept;
+  bool operator!=(BasicSharedArrayIterator const& other) const noexcept;
 
-  SharedSlice operator*() const;
+  SharedSliceType operator*() const;
 
-  [[nodiscard]] SharedArrayIterator begin() const;
+  [[nodiscard]] BasicSharedArrayIterator begin() const;
 
-  [[nodiscard]] SharedArrayIterator end() const;
+  [[nodiscard]] BasicSharedArrayIterator end() const;
 
   [[nodiscard]] bool valid() const noexcept;
 
-  [[nodiscard]] SharedSlice value() const;
+  [[nodiscard]] SharedSliceType value() const;
 
   void next();
 
@@ -71,49 +75,54 @@ class SharedArrayIterator {
   void reset();
 
  private:
-  SharedSlice& sharedSlice() noexcept;
-  [[nodiscard]] SharedSlice const& sharedSlice() const noexcept;
+  SharedSliceType& sharedSlice() noexcept;
+  [[nodiscard]] SharedSliceType const& sharedSlice() const noexcept;
   ArrayIterator& iterator() noexcept;
   [[nodiscard]] ArrayIterator const& iterator() const noexcept;
-  [[nodiscard]] SharedSlice alias(Slice slice) const noexcept;
+  [[nodiscard]] SharedSliceType alias(Slice slice) const noexcept;
 
  private:
-  SharedSlice _slice;
+  SharedSliceType _slice;
   ArrayIterator _iterator;
 };
 
-class SharedObjectIterator {
+template <typename OwnershipPolicy>
+class BasicSharedObjectIterator {
  public:
+  using SharedSliceType = BasicSharedSlice<OwnershipPolicy>;
+
   struct ObjectPair {
-    ObjectPair(SharedSlice key, SharedSlice value) noexcept;
-    SharedSlice key;
-    SharedSlice value;
+    ObjectPair(SharedSliceType key, SharedSliceType value) noexcept;
+    SharedSliceType key;
+    SharedSliceType value;
   };
 
-  SharedObjectIterator() = delete;
+  BasicSharedObjectIterator() = delete;
 
-  explicit SharedObjectIterator(SharedSlice&& slice, bool useSequentialIteration = false);
-  explicit SharedObjectIterator(SharedSlice const& slice, bool useSequentialIteration = false);
+  explicit BasicSharedObjectIterator(SharedSliceType&& slice,
+                                     bool useSequentialIteration = false);
+  explicit BasicSharedObjectIterator(SharedSliceType const& slice,
+                                     bool useSequentialIteration = false);
 
   // prefix ++
-  SharedObjectIterator& operator++();
+  BasicSharedObjectIterator& operator++();
 
   // postfix ++
-  SharedObjectIterator operator++(int) &;
+  BasicSharedObjectIterator operator++(int) &;
 
-  [[nodiscard]] bool operator!=(SharedObjectIterator const& other) const;
+  [[nodiscard]] bool operator!=(BasicSharedObjectIterator const& other) const;
 
   [[nodiscard]] ObjectPair operator*() const;
 
-  [[nodiscard]] SharedObjectIterator begin() const;
+  [[nodiscard]] BasicSharedObjectIterator begin() const;
 
-  [[nodiscard]] SharedObjectIterator end() const;
+  [[nodiscard]] BasicSharedObjectIterator end() const;
 
   [[nodiscard]] bool valid() const noexcept;
 
-  [[nodiscard]] SharedSlice key(bool translate = true) const;
+  [[nodiscard]] SharedSliceType key(bool translate = true) const;
 
-  [[nodiscard]] SharedSlice value() const;
+  [[nodiscard]] SharedSliceType value() const;
 
   void next();
 
@@ -128,17 +137,188 @@ class SharedObjectIterator {
   void reset();
 
  private:
-  [[nodiscard]] SharedSlice& sharedSlice() noexcept;
-  [[nodiscard]] SharedSlice const& sharedSlice() const noexcept;
+  [[nodiscard]] SharedSliceType& sharedSlice() noexcept;
+  [[nodiscard]] SharedSliceType const& sharedSlice() const noexcept;
   [[nodiscard]] ObjectIterator& iterator() noexcept;
   [[nodiscard]] ObjectIterator const& iterator() const noexcept;
-  [[nodiscard]] SharedSlice alias(Slice slice) const noexcept;
+  [[nodiscard]] SharedSliceType alias(Slice slice) const noexcept;
+
+ private:
+  SharedSliceType _slice;
+  ObjectIterator _iterator;
+};
+
+// Iterates over an array without touching its refcount. The slices it yields
+// borrow from the SharedSlice passed to the constructor, which must outlive
+// the iterator and all borrowed slices.
+template <typename OwnershipPolicy>
+class BasicBorrowedArrayIterator {
+ public:
+  using SharedSliceType = BasicSharedSlice<OwnershipPolicy>;
+  using BorrowedSliceType = BasicBorrowedSlice<OwnershipPolicy>;
+
+  BasicBorrowedArrayIterator() = delete;
+
+  explicit BasicBorrowedArrayIterator(SharedSliceType const& slice);
+  // The slices would borrow from a temporary
+  explicit BasicBorrowedArrayIterator(SharedSliceType&& slice) = delete;
+
+  // prefix ++
+  BasicBorrowedArrayIterator& operator++();
+
+  // postfix ++
+  BasicBorrowedArrayIterator operator++(int) &;
+
+  bool operator!=(BasicBorrowedArrayIterator const& other) const noexcept;
+
+  BorrowedSliceType operator*() const;
+
+  [[nodiscard]] BasicBorrowedArrayIterator begin() const;
+
+  [[nodiscard]] BasicBorrowedArrayIterator end() const;
+
+  [[nodiscard]] bool valid() const noexcept;
+
+  [[nodiscard]] BorrowedSliceType value() const;
+
+  void next();
+
+  [[nodiscard]] ValueLength index() const noexcept;
+
+  [[nodiscard]] ValueLength size() const noexcept;
+
+  [[nodiscard]] bool isFirst() const noexcept;
+
+  [[nodiscard]] bool isLast() const noexcept;
+
+  void forward(ValueLength count);
+
+  void reset();
+
+ private:
+  [[nodiscard]] BorrowedSliceType borrow(Slice slice) const noexcept;
+
+ private:
+  SharedSliceType const* _slice;
+  ArrayIterator _iterator;
+};
+
+// Iterates over an object without touching its refcount, see
+// BasicBorrowedArrayIterator.
+template <typename OwnershipPolicy>
+class BasicBorrowedObjectIterator {
+ public:
+  using SharedSliceType = BasicSharedSlice<OwnershipPolicy>;
+  using BorrowedSliceType = BasicBorrowedSlice<OwnershipPolicy>;
+
+  struct ObjectPair {
+    ObjectPair(BorrowedSliceType key, BorrowedSliceType value) noexcept;
+    BorrowedSliceType key;
+    BorrowedSliceType value;
+  };
+
+  BasicBorrowedObjectIterator() = delete;
+
+  explicit BasicBorrowedObjectIterator(SharedSliceType const& slice,
+                                       bool useSequentialIteration = false);
+  // The slices would borrow from a temporary
+  explicit BasicBorrowedObjectIterator(
+      SharedSliceType&& slice, bool useSequentialIteration = false) = delete;
+
+  // prefix ++
+  BasicBorrowedObjectIterator& operator++();
+
+  // postfix ++
+  BasicBorrowedObjectIterator operator++(int) &;
+
+  [[nodiscard]] bool operator!=(BasicBorrowedObjectIterator const& other) const;
+
+  [[nodiscard]] ObjectPair operator*() const;
+
+  [[nodiscard]] BasicBorrowedObjectIterator begin() const;
+
+  [[nodiscard]] BasicBorrowedObjectIterator end() const;
+
+  [[nodiscard]] bool valid() const noexcept;
+
+  [[nodiscard]] BorrowedSliceType key(bool translate = true) const;
+
+  [[nodiscard]] BorrowedSliceType value() const;
+
+  void next();
+
+  [[nodiscard]] ValueLength index() const noexcept;
+
+  [[nodiscard]] ValueLength size() const noexcept;
+
+  [[nodiscard]] bool isFirst() const noexcept;
+
+  [[nodiscard]] bool isLast() const noexcept;
+
+  void reset();
+
+ private:
+  [[nodiscard]] BorrowedSliceType borrow(Slice slice) const noexcept;
 
  private:
-  SharedSlice _slice;
+  SharedSliceType const* _slice;
   ObjectIterator _iterator;
 };
 
+using SharedArrayIterator = BasicSharedArrayIterator<SharedPtrOwnership>;
+using IntrusiveSharedArrayIterator =
+    BasicSharedArrayIterator<IntrusiveOwnership>;
+using LocalSharedArrayIterator = BasicSharedArrayIterator<LocalOwnership>;
+using EpochSharedArrayIterator = BasicSharedArrayIterator<EpochOwnership>;
+using ShardedSharedArrayIterator = BasicSharedArrayIterator<ShardedOwnership>;
+
+using SharedObjectIterator = BasicSharedObjectIterator<SharedPtrOwnership>;
+using IntrusiveSharedObjectIterator =
+    BasicSharedObjectIterator<IntrusiveOwnership>;
+using LocalSharedObjectIterator = BasicSharedObjectIterator<LocalOwnership>;
+using EpochSharedObjectIterator = BasicSharedObjectIterator<EpochOwnership>;
+using ShardedSharedObjectIterator = BasicSharedObjectIterator<ShardedOwnership>;
+
+extern template class BasicSharedArrayIterator<SharedPtrOwnership>;
+extern template class BasicSharedArrayIterator<IntrusiveOwnership>;
+extern template class BasicSharedArrayIterator<LocalOwnership>;
+extern template class BasicSharedArrayIterator<EpochOwnership>;
+extern template class BasicSharedArrayIterator<ShardedOwnership>;
+
+extern template class BasicSharedObjectIterator<SharedPtrOwnership>;
+extern template class BasicSharedObjectIterator<IntrusiveOwnership>;
+extern template class BasicSharedObjectIterator<LocalOwnership>;
+extern template class BasicSharedObjectIterator<EpochOwnership>;
+extern template class BasicSharedObjectIterator<ShardedOwnership>;
+
+using BorrowedArrayIterator = BasicBorrowedArrayIterator<SharedPtrOwnership>;
+using IntrusiveBorrowedArrayIterator =
+    BasicBorrowedArrayIterator<IntrusiveOwnership>;
+using LocalBorrowedArrayIterator = BasicBorrowedArrayIterator<LocalOwnership>;
+using EpochBorrowedArrayIterator = BasicBorrowedArrayIterator<EpochOwnership>;
+using ShardedBorrowedArrayIterator =
+    BasicBorrowedArrayIterator<ShardedOwnership>;
+
+using BorrowedObjectIterator = BasicBorrowedObjectIterator<SharedPtrOwnership>;
+using IntrusiveBorrowedObjectIterator =
+    BasicBorrowedObjectIterator<IntrusiveOwnership>;
+using LocalBorrowedObjectIterator = BasicBorrowedObjectIterator<LocalOwnership>;
+using EpochBorrowedObjectIterator = BasicBorrowedObjectIterator<EpochOwnership>;
+using ShardedBorrowedObjectIterator =
+    BasicBorrowedObjectIterator<ShardedOwnership>;
+
+extern template class BasicBorrowedArrayIterator<SharedPtrOwnership>;
+extern template class BasicBorrowedArrayIterator<IntrusiveOwnership>;
+extern template class BasicBorrowedArrayIterator<LocalOwnership>;
+extern template class BasicBorrowedArrayIterator<EpochOwnership>;
+extern template class BasicBorrowedArrayIterator<ShardedOwnership>;
+
+extern template class BasicBorrowedObjectIterator<SharedPtrOwnership>;
+extern template class BasicBorrowedObjectIterator<IntrusiveOwnership>;
+extern template class BasicBorrowedObjectIterator<LocalOwnership>;
+extern template class BasicBorrowedObjectIterator<EpochOwnership>;
+extern template class BasicBorrowedObjectIterator<ShardedOwnership>;
+
 }  // namespace arangodb::velocypack
 
 #endif  // SRC_SHAREDITERATOR_H
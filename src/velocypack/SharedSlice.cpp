@@ -22,381 +22,1218 @@
 
 #include "SharedSlice.h"
 
+#include "AttributeSet.h"
+#include "KeySearch.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Exception.h>
+
+#include <cstring>
+#include <memory>
+
 using namespace arangodb;
 using namespace arangodb::velocypack;
 
 namespace {
-std::shared_ptr<uint8_t const> staticSharedNoneBuffer{Slice::noneSliceData,
-                                                      [](auto) { /* don't delete the pointer */ }};
+// Allocates `extra` bytes right behind the shared_ptr control block, and
+// reports where they start via `tail`. `tail` is only written during the
+// single allocate() call in std::allocate_shared; the copy of the allocator
+// stored in the control block never dereferences it.
+template <typename T>
+class TailAllocator {
+ public:
+  using value_type = T;
+
+  TailAllocator(std::size_t extra, uint8_t** tail) noexcept
+      : _extra(extra), _tail(tail) {}
+  template <typename U>
+  TailAllocator(TailAllocator<U> const&
+                    other) noexcept  // NOLINT(google-explicit-constructor)
+      : _extra(other._extra), _tail(other._tail) {}
+
+  T* allocate(std::size_t n) {
+    auto* block = static_cast<uint8_t*>(::operator new(n * sizeof(T) + _extra));
+    *_tail = block + n * sizeof(T);
+    return reinterpret_cast<T*>(block);
+  }
+
+  void deallocate(T* ptr, std::size_t) noexcept {
+    ::operator delete(static_cast<void*>(ptr));
+  }
+
+  template <typename U>
+  bool operator==(TailAllocator<U> const& other) const noexcept {
+    return _extra == other._extra;
+  }
+  template <typename U>
+  bool operator!=(TailAllocator<U> const& other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  template <typename>
+  friend class TailAllocator;
+
+  std::size_t _extra;
+  uint8_t** _tail;
+};
+}  // namespace
+
+auto SharedPtrOwnership::allocate(std::size_t size) -> pointer<uint8_t> {
+  uint8_t* data = nullptr;
+  auto owner =
+      pointer<uint8_t>(static_cast<uint8_t*>(nullptr), BufferInfo{size},
+                       TailAllocator<uint8_t>(size, &data));
+  return pointer<uint8_t>(std::move(owner), data);
 }
 
-Slice SharedSlice::slice() const noexcept { return Slice(_start.get()); }
+auto SharedPtrOwnership::pinnedBytes(
+    pointer<uint8_t const> const& data) noexcept -> std::optional<std::size_t> {
+  if (data.use_count() == 0) {
+    // Doesn't own anything, e.g. None
+    return 0;
+  }
+  if (auto const* info = std::get_deleter<BufferInfo>(data); info != nullptr) {
+    return info->size;
+  }
+  return std::nullopt;
+}
 
-SharedSlice::SharedSlice(std::shared_ptr<uint8_t const>&& data) noexcept
-    : _start(std::move(data)) {}
+detail::LazyBufferCaches const* SharedPtrOwnership::caches(
+    pointer<uint8_t const> const& data) {
+  if (auto const* info = std::get_deleter<BufferInfo>(data); info != nullptr) {
+    return &info->caches;
+  }
+  return nullptr;
+}
 
-SharedSlice::SharedSlice(std::shared_ptr<uint8_t const> const& data) noexcept
-    : _start(data) {}
+auto SharedPtrOwnership::none() noexcept -> pointer<uint8_t const> {
+  // Points to the static None slice, but doesn't own anything. Unlike a copy
+  // of a static shared_ptr, this doesn't touch a process-wide refcount.
+  return pointer<uint8_t const>(pointer<uint8_t const>(), Slice::noneSliceData);
+}
+
+auto IntrusiveOwnership::none() noexcept -> pointer<uint8_t const> {
+  // Points to the static None slice, but doesn't own anything
+  return pointer<uint8_t const>(pointer<uint8_t const>(), Slice::noneSliceData);
+}
+
+namespace {
+// What a pointer of the policies with a header keeps alive: nothing if
+// header is nullptr, e.g. None, the shared_ptr wrapped by fromShared() if
+// wrapped is set, and otherwise a buffer allocated together with header
+template <typename Header>
+struct PinnedBuffer {
+  Header const* header;
+  std::shared_ptr<uint8_t const> const* wrapped;
+};
+
+// Recognizes the blocks made by fromShared() by their destroy function
+template <typename SharedBlock, typename Header>
+PinnedBuffer<Header> pinnedBuffer(Header const* header) noexcept {
+  if (header != nullptr && header->destroy == &SharedBlock::destroyBlock) {
+    return {header, &static_cast<SharedBlock const*>(header)->value};
+  }
+  return {header, nullptr};
+}
+
+template <typename Header, typename BufferSize>
+std::optional<std::size_t> pinnedBytesOf(PinnedBuffer<Header> pinned,
+                                         BufferSize bufferSize) noexcept {
+  if (pinned.header == nullptr) {
+    return 0;
+  }
+  if (pinned.wrapped != nullptr) {
+    return SharedPtrOwnership::pinnedBytes(*pinned.wrapped);
+  }
+  return bufferSize(pinned.header);
+}
+
+template <typename Header, typename BufferCaches>
+detail::LazyBufferCaches const* cachesOf(PinnedBuffer<Header> pinned,
+                                         BufferCaches bufferCaches) {
+  if (pinned.wrapped != nullptr) {
+    return SharedPtrOwnership::caches(*pinned.wrapped);
+  }
+  return pinned.header == nullptr ? nullptr : bufferCaches(pinned.header);
+}
+
+template <typename RefCount>
+PinnedBuffer<detail::IntrusiveHeader<RefCount>> intrusivePinned(
+    IntrusivePtr<uint8_t const, RefCount> const& data) noexcept {
+  return pinnedBuffer<
+      detail::IntrusiveBlock<std::shared_ptr<uint8_t const>, RefCount>>(
+      data.header());
+}
+
+auto const intrusiveSize = [](auto const* header) noexcept {
+  return intrusiveBufferSize(header);
+};
+auto const intrusiveCaches = [](auto const* header) {
+  return intrusiveBufferCaches(header);
+};
+}  // namespace
+
+detail::LazyBufferCaches const* IntrusiveOwnership::caches(
+    pointer<uint8_t const> const& data) {
+  return cachesOf(intrusivePinned(data), intrusiveCaches);
+}
+
+auto IntrusiveOwnership::pinnedBytes(
+    pointer<uint8_t const> const& data) noexcept -> std::optional<std::size_t> {
+  return pinnedBytesOf(intrusivePinned(data), intrusiveSize);
+}
+
+auto IntrusiveOwnership::fromShared(std::shared_ptr<uint8_t const> data)
+    -> pointer<uint8_t const> {
+  auto const* start = data.get();
+  auto owner = makeIntrusive<std::shared_ptr<uint8_t const>>(std::move(data));
+  owner.header()->base = start;
+  return pointer<uint8_t const>(std::move(owner), start);
+}
+
+auto IntrusiveOwnership::toShared(pointer<uint8_t const>&& data)
+    -> std::shared_ptr<uint8_t const> {
+  auto const* start = data.get();
+  if (data.use_count() == 0) {
+    // Doesn't own anything, e.g. None
+    return std::shared_ptr<uint8_t const>(std::shared_ptr<uint8_t const>(),
+                                          start);
+  }
+  return std::shared_ptr<uint8_t const>(start,
+                                        [owner = std::move(data)](
+                                            auto) mutable { owner.reset(); });
+}
+
+auto LocalOwnership::none() noexcept -> pointer<uint8_t const> {
+  return pointer<uint8_t const>(pointer<uint8_t const>(), Slice::noneSliceData);
+}
+
+auto LocalOwnership::pinnedBytes(pointer<uint8_t const> const& data) noexcept
+    -> std::optional<std::size_t> {
+  return pinnedBytesOf(intrusivePinned(data), intrusiveSize);
+}
+
+detail::LazyBufferCaches const* LocalOwnership::caches(
+    pointer<uint8_t const> const& data) {
+  return cachesOf(intrusivePinned(data), intrusiveCaches);
+}
+
+auto LocalOwnership::fromShared(std::shared_ptr<uint8_t const> data)
+    -> pointer<uint8_t const> {
+  auto const* start = data.get();
+  auto owner =
+      makeIntrusive<std::shared_ptr<uint8_t const>, detail::LocalRefCount>(
+          std::move(data));
+  owner.header()->base = start;
+  return pointer<uint8_t const>(std::move(owner), start);
+}
+
+auto LocalOwnership::toShared(pointer<uint8_t const>&& data)
+    -> std::shared_ptr<uint8_t const> {
+  if (data.use_count() > 1) {
+    throw Exception(
+        Exception::InternalError,
+        "LocalSharedSlice is still referenced and cannot be shared");
+  }
+  auto const* start = data.get();
+  if (data.use_count() == 0) {
+    // Doesn't own anything, e.g. None
+    return std::shared_ptr<uint8_t const>(std::shared_ptr<uint8_t const>(),
+                                          start);
+  }
+  // From here on, the deleter holds the only reference to the local refcount,
+  // and the shared_ptr's control block guards the deleter.
+  return std::shared_ptr<uint8_t const>(start,
+                                        [owner = std::move(data)](
+                                            auto) mutable { owner.reset(); });
+}
+
+auto InlineOwnership::fromShared(std::shared_ptr<uint8_t const> data)
+    -> pointer<uint8_t const> {
+  // Same rule as allocate(), so a value is inline no matter how it was built
+  auto const slice = Slice(data.get());
+  if (slice.byteSize() <= pointer<uint8_t const>::inlineCapacity) {
+    return pointer<uint8_t const>::copyOf(slice.start(), slice.byteSize());
+  }
+  return pointer<uint8_t const>(std::move(data));
+}
+
+auto InlineOwnership::toShared(pointer<uint8_t const>&& data)
+    -> std::shared_ptr<uint8_t const> {
+  if (!data.isInline()) {
+    return data.shared();
+  }
+  auto const slice = Slice(data.get());
+  auto const size = static_cast<std::size_t>(slice.byteSize());
+  auto copy = SharedPtrOwnership::allocate(size);
+  std::memcpy(copy.get(), slice.start(), size);
+  return copy;
+}
+
+auto InlineOwnership::allocate(std::size_t size) -> pointer<uint8_t> {
+  if (size <= pointer<uint8_t>::inlineCapacity) {
+    return pointer<uint8_t>::makeInline();
+  }
+  return pointer<uint8_t>(SharedPtrOwnership::allocate(size));
+}
+
+auto EpochOwnership::none() noexcept -> pointer<uint8_t const> {
+  return pointer<uint8_t const>(nullptr, Slice::noneSliceData);
+}
+
+namespace {
+// The owner of data, retired right away. The calling thread's critical
+// section keeps it alive.
+detail::EpochOwner const* retiredEpochOwner(
+    std::shared_ptr<uint8_t const> data) {
+  if (!inEpoch()) {
+    throw Exception(Exception::InternalError,
+                    "EpochSharedSlice must be created inside an EpochGuard");
+  }
+  auto owner = std::make_unique<detail::EpochOwner const>(
+      detail::EpochOwner{std::move(data)});
+  detail::reserveRetired();
+  detail::retire(owner.get());
+  return owner.release();
+}
+}  // namespace
+
+auto EpochOwnership::fromShared(std::shared_ptr<uint8_t const> data)
+    -> pointer<uint8_t const> {
+  auto const* start = data.get();
+  return pointer<uint8_t const>(retiredEpochOwner(std::move(data)), start);
+}
+
+auto EpochOwnership::toShared(pointer<uint8_t const>&& data) noexcept
+    -> std::shared_ptr<uint8_t const> {
+  if (data.owner() == nullptr) {
+    // Doesn't own anything, e.g. None
+    return std::shared_ptr<uint8_t const>(std::shared_ptr<uint8_t const>(),
+                                          data.get());
+  }
+  return std::shared_ptr<uint8_t const>(data.owner()->data, data.get());
+}
+
+auto EpochOwnership::allocate(std::size_t size) -> pointer<uint8_t> {
+  auto data = SharedPtrOwnership::allocate(size);
+  auto* start = data.get();
+  return pointer<uint8_t>(retiredEpochOwner(std::move(data)), start);
+}
+
+namespace {
+// Epoch owners always wrap a shared_ptr
+PinnedBuffer<detail::EpochOwner> epochPinned(
+    EpochOwnership::pointer<uint8_t const> const& data) noexcept {
+  auto const* owner = data.owner();
+  return {owner, owner == nullptr ? nullptr : &owner->data};
+}
+
+auto const noBuffer = [](detail::EpochOwner const*) noexcept {
+  return std::optional<std::size_t>();
+};
+auto const noCaches = [](detail::EpochOwner const*) {
+  return static_cast<detail::LazyBufferCaches const*>(nullptr);
+};
+}  // namespace
+
+auto EpochOwnership::pinnedBytes(pointer<uint8_t const> const& data) noexcept
+    -> std::optional<std::size_t> {
+  return pinnedBytesOf(epochPinned(data), noBuffer);
+}
+
+detail::LazyBufferCaches const* EpochOwnership::caches(
+    pointer<uint8_t const> const& data) {
+  return cachesOf(epochPinned(data), noCaches);
+}
+
+auto ShardedOwnership::none() noexcept -> pointer<uint8_t const> {
+  // Points to the static None slice, but doesn't own anything
+  return pointer<uint8_t const>(pointer<uint8_t const>(), Slice::noneSliceData);
+}
+
+namespace {
+PinnedBuffer<detail::ShardedHeader> shardedPinned(
+    ShardedOwnership::pointer<uint8_t const> const& data) noexcept {
+  return pinnedBuffer<detail::ShardedBlock<std::shared_ptr<uint8_t const>>>(
+      data.header());
+}
+}  // namespace
+
+auto ShardedOwnership::pinnedBytes(pointer<uint8_t const> const& data) noexcept
+    -> std::optional<std::size_t> {
+  return pinnedBytesOf(shardedPinned(data), shardedBufferSize);
+}
+
+detail::LazyBufferCaches const* ShardedOwnership::caches(
+    pointer<uint8_t const> const& data) {
+  return cachesOf(shardedPinned(data), shardedBufferCaches);
+}
 
-SharedSlice::SharedSlice(std::shared_ptr<Buffer<uint8_t> const>&& buffer) noexcept
-    : _start(std::move(buffer), buffer->data()) {}
+auto ShardedOwnership::fromShared(std::shared_ptr<uint8_t const> data)
+    -> pointer<uint8_t const> {
+  auto const* start = data.get();
+  auto owner = makeSharded<std::shared_ptr<uint8_t const>>(std::move(data));
+  return pointer<uint8_t const>(std::move(owner), start);
+}
+
+auto ShardedOwnership::toShared(pointer<uint8_t const>&& data)
+    -> std::shared_ptr<uint8_t const> {
+  auto const* start = data.get();
+  if (data.use_count() == 0) {
+    // Doesn't own anything, e.g. None
+    return std::shared_ptr<uint8_t const>(std::shared_ptr<uint8_t const>(),
+                                          start);
+  }
+  return std::shared_ptr<uint8_t const>(start,
+                                        [owner = std::move(data)](
+                                            auto) mutable { owner.reset(); });
+}
+
+template <typename OwnershipPolicy>
+Slice BasicSharedSlice<OwnershipPolicy>::slice() const noexcept {
+  return Slice(_start.get());
+}
 
-SharedSlice::SharedSlice(std::shared_ptr<Buffer<uint8_t> const> const& buffer) noexcept
-    : _start(buffer, buffer->data()) {}
+template <typename OwnershipPolicy>
+BasicSharedSlice<OwnershipPolicy>::BasicSharedSlice(
+    pointer<uint8_t const>&& data) noexcept
+    : _start(std::move(data)) {}
+
+template <typename OwnershipPolicy>
+BasicSharedSlice<OwnershipPolicy>::BasicSharedSlice(
+    pointer<uint8_t const> const& data) noexcept
+    : _start(data) {}
 
-SharedSlice::SharedSlice(SharedSlice&& sharedPtr, Slice slice) noexcept
+template <typename OwnershipPolicy>
+BasicSharedSlice<OwnershipPolicy>::BasicSharedSlice(
+    std::shared_ptr<Buffer<uint8_t> const>&& buffer) noexcept(nothrowFromShared)
+    : _start(OwnershipPolicy::fromShared(
+          std::shared_ptr<uint8_t const>(std::move(buffer), buffer->data()))) {}
+
+template <typename OwnershipPolicy>
+BasicSharedSlice<OwnershipPolicy>::BasicSharedSlice(
+    std::shared_ptr<Buffer<uint8_t> const> const&
+        buffer) noexcept(nothrowFromShared)
+    : _start(OwnershipPolicy::fromShared(
+          std::shared_ptr<uint8_t const>(buffer, buffer->data()))) {}
+
+template <typename OwnershipPolicy>
+BasicSharedSlice<OwnershipPolicy>::BasicSharedSlice(
+    BasicSharedSlice&& sharedPtr, Slice slice) noexcept
     : _start(sharedPtr._start, slice.start()) {}
 
-SharedSlice::SharedSlice(SharedSlice const& sharedPtr, Slice slice) noexcept
+template <typename OwnershipPolicy>
+BasicSharedSlice<OwnershipPolicy>::BasicSharedSlice(
+    BasicSharedSlice const& sharedPtr, Slice slice) noexcept
     : _start(sharedPtr._start, slice.start()) {}
 
-SharedSlice::SharedSlice() noexcept : _start(staticSharedNoneBuffer) {}
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::copyOf(Slice slice)
+    -> BasicSharedSlice {
+  auto const size = static_cast<std::size_t>(slice.byteSize());
+  auto data = OwnershipPolicy::allocate(size);
+  std::memcpy(data.get(), slice.start(), size);
+  return BasicSharedSlice(pointer<uint8_t const>(std::move(data)));
+}
+
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::fromBuilder(Builder&& builder)
+    -> BasicSharedSlice {
+  if (!builder.isClosed()) {
+    throw Exception(Exception::BuilderNotSealed);
+  }
+  auto result = copyOf(builder.slice());
+  builder.clear();
+  return result;
+}
+
+template <typename OwnershipPolicy>
+BasicSharedSlice<OwnershipPolicy>::BasicSharedSlice() noexcept
+    : _start(OwnershipPolicy::none()) {}
+
+template <typename OwnershipPolicy>
+std::optional<std::size_t> BasicSharedSlice<OwnershipPolicy>::pinnedBytes()
+    const noexcept {
+  return OwnershipPolicy::pinnedBytes(_start);
+}
+
+template <typename OwnershipPolicy>
+std::size_t BasicSharedSlice<OwnershipPolicy>::referencedBytes() const {
+  return static_cast<std::size_t>(slice().byteSize());
+}
+
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::compact() const -> BasicSharedSlice {
+  auto const pinned = pinnedBytes();
+  if (pinned == 0 || pinned == referencedBytes()) {
+    // Owns nothing, or is already alone in its buffer
+    return *this;
+  }
+  return copyOf(slice());
+}
+
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::retain(RetentionPolicy policy) const
+    -> BasicSharedSlice {
+  auto const pinned = pinnedBytes();
+  auto const referenced = referencedBytes();
+  if (pinned.has_value() && *pinned > referenced &&
+      *pinned - referenced >= policy.minWastedBytes &&
+      static_cast<double>(*pinned) >
+          policy.maxWasteRatio * static_cast<double>(referenced)) {
+    return copyOf(slice());
+  }
+  return *this;
+}
+
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::enableKeyIndex() const {
+  auto const* caches = OwnershipPolicy::caches(_start);
+  if (caches == nullptr) {
+    return false;
+  }
+  caches->get().enableKeyIndex();
+  return true;
+}
+
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::enableHashCache() const {
+  auto const* caches = OwnershipPolicy::caches(_start);
+  if (caches == nullptr) {
+    return false;
+  }
+  caches->get().enableHashCache();
+  return true;
+}
 
-SharedSlice SharedSlice::value() const noexcept {
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::enableOffsetTables(
+    ValueLength stride) const {
+  auto const* caches = OwnershipPolicy::caches(_start);
+  if (caches == nullptr) {
+    return false;
+  }
+  caches->get().enableOffsetTables(stride);
+  return true;
+}
+
+template <typename OwnershipPolicy>
+SharedSlice BasicSharedSlice<OwnershipPolicy>::share() && {
+  // toShared() leaves _start untouched if it throws
+  auto data = OwnershipPolicy::toShared(std::move(_start));
+  _start = OwnershipPolicy::none();
+  return SharedSlice(std::move(data));
+}
+
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::value() const noexcept
+    -> BasicSharedSlice {
   return alias(slice().value());
 }
 
-uint64_t SharedSlice::getFirstTag() const { return slice().getFirstTag(); }
+template <typename OwnershipPolicy>
+uint64_t BasicSharedSlice<OwnershipPolicy>::getFirstTag() const {
+  return slice().getFirstTag();
+}
 
-std::vector<uint64_t> SharedSlice::getTags() const { return slice().getTags(); }
+template <typename OwnershipPolicy>
+std::vector<uint64_t> BasicSharedSlice<OwnershipPolicy>::getTags() const {
+  return slice().getTags();
+}
 
-bool SharedSlice::hasTag(uint64_t tagId) const { return slice().hasTag(tagId); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::hasTag(uint64_t tagId) const {
+  return slice().hasTag(tagId);
+}
 
-std::shared_ptr<uint8_t const> SharedSlice::valueStart() const noexcept {
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::valueStart() const noexcept
+    -> pointer<uint8_t const> {
   return aliasPtr(slice().valueStart());
 }
 
-std::shared_ptr<uint8_t const> SharedSlice::start() const noexcept { return aliasPtr(slice().start()); }
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::start() const noexcept
+    -> pointer<uint8_t const> {
+  return aliasPtr(slice().start());
+}
 
-uint8_t SharedSlice::head() const noexcept { return slice().head(); }
+template <typename OwnershipPolicy>
+uint8_t BasicSharedSlice<OwnershipPolicy>::head() const noexcept {
+  return slice().head();
+}
 
-std::shared_ptr<uint8_t const> SharedSlice::begin() const noexcept { return aliasPtr(slice().begin()); }
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::begin() const noexcept
+    -> pointer<uint8_t const> {
+  return aliasPtr(slice().begin());
+}
 
-std::shared_ptr<uint8_t const> SharedSlice::end() const { return aliasPtr(slice().end()); }
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::end() const -> pointer<uint8_t const> {
+  return aliasPtr(slice().end());
+}
 
-ValueType SharedSlice::type() const noexcept { return slice().type(); }
+template <typename OwnershipPolicy>
+ValueType BasicSharedSlice<OwnershipPolicy>::type() const noexcept {
+  return slice().type();
+}
 
-char const* SharedSlice::typeName() const { return slice().typeName(); }
+template <typename OwnershipPolicy>
+char const* BasicSharedSlice<OwnershipPolicy>::typeName() const {
+  return slice().typeName();
+}
 
-uint64_t SharedSlice::hash(uint64_t seed) const { return slice().hash(seed); }
+template <typename OwnershipPolicy>
+uint64_t BasicSharedSlice<OwnershipPolicy>::hash(uint64_t seed) const {
+  return memoizedHash(BufferCaches::HashKind::hash, seed,
+                      [&](Slice slice) { return slice.hash(seed); });
+}
 
-uint32_t SharedSlice::hash32(uint32_t seed) const {
-  return slice().hash32(seed);
+template <typename OwnershipPolicy>
+uint32_t BasicSharedSlice<OwnershipPolicy>::hash32(uint32_t seed) const {
+  return static_cast<uint32_t>(
+      memoizedHash(BufferCaches::HashKind::hash32, seed,
+                   [&](Slice slice) { return slice.hash32(seed); }));
 }
 
-uint64_t SharedSlice::hashSlow(uint64_t seed) const {
-  return slice().hashSlow(seed);
+template <typename OwnershipPolicy>
+uint64_t BasicSharedSlice<OwnershipPolicy>::hashSlow(uint64_t seed) const {
+  return memoizedHash(BufferCaches::HashKind::hashSlow, seed,
+                      [&](Slice slice) { return slice.hashSlow(seed); });
 }
 
-uint64_t SharedSlice::normalizedHash(uint64_t seed) const {
-  return slice().normalizedHash(seed);
+template <typename OwnershipPolicy>
+uint64_t BasicSharedSlice<OwnershipPolicy>::normalizedHash(
+    uint64_t seed) const {
+  return memoizedHash(BufferCaches::HashKind::normalizedHash, seed,
+                      [&](Slice slice) { return slice.normalizedHash(seed); });
 }
 
-uint32_t SharedSlice::normalizedHash32(uint32_t seed) const {
-  return slice().normalizedHash32(seed);
+template <typename OwnershipPolicy>
+uint32_t BasicSharedSlice<OwnershipPolicy>::normalizedHash32(
+    uint32_t seed) const {
+  return static_cast<uint32_t>(
+      memoizedHash(BufferCaches::HashKind::normalizedHash32, seed,
+                   [&](Slice slice) { return slice.normalizedHash32(seed); }));
 }
 
-uint64_t SharedSlice::hashString(uint64_t seed) const noexcept {
+template <typename OwnershipPolicy>
+uint64_t BasicSharedSlice<OwnershipPolicy>::hashString(
+    uint64_t seed) const noexcept {
   return slice().hashString(seed);
 }
 
-uint32_t SharedSlice::hashString32(uint32_t seed) const noexcept {
+template <typename OwnershipPolicy>
+uint32_t BasicSharedSlice<OwnershipPolicy>::hashString32(
+    uint32_t seed) const noexcept {
   return slice().hashString32(seed);
 }
 
-bool SharedSlice::isType(ValueType t) const { return slice().isType(t); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isType(ValueType t) const {
+  return slice().isType(t);
+}
 
-bool SharedSlice::isNone() const noexcept { return slice().isNone(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isNone() const noexcept {
+  return slice().isNone();
+}
 
-bool SharedSlice::isIllegal() const noexcept { return slice().isIllegal(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isIllegal() const noexcept {
+  return slice().isIllegal();
+}
 
-bool SharedSlice::isNull() const noexcept { return slice().isNull(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isNull() const noexcept {
+  return slice().isNull();
+}
 
-bool SharedSlice::isBool() const noexcept { return slice().isBool(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isBool() const noexcept {
+  return slice().isBool();
+}
 
-bool SharedSlice::isBoolean() const noexcept { return slice().isBoolean(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isBoolean() const noexcept {
+  return slice().isBoolean();
+}
 
-bool SharedSlice::isTrue() const noexcept { return slice().isTrue(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isTrue() const noexcept {
+  return slice().isTrue();
+}
 
-bool SharedSlice::isFalse() const noexcept { return slice().isFalse(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isFalse() const noexcept {
+  return slice().isFalse();
+}
 
-bool SharedSlice::isArray() const noexcept { return slice().isArray(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isArray() const noexcept {
+  return slice().isArray();
+}
 
-bool SharedSlice::isObject() const noexcept { return slice().isObject(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isObject() const noexcept {
+  return slice().isObject();
+}
 
-bool SharedSlice::isDouble() const noexcept { return slice().isDouble(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isDouble() const noexcept {
+  return slice().isDouble();
+}
 
-bool SharedSlice::isUTCDate() const noexcept { return slice().isUTCDate(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isUTCDate() const noexcept {
+  return slice().isUTCDate();
+}
 
-bool SharedSlice::isExternal() const noexcept { return slice().isExternal(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isExternal() const noexcept {
+  return slice().isExternal();
+}
 
-bool SharedSlice::isMinKey() const noexcept { return slice().isMinKey(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isMinKey() const noexcept {
+  return slice().isMinKey();
+}
 
-bool SharedSlice::isMaxKey() const noexcept { return slice().isMaxKey(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isMaxKey() const noexcept {
+  return slice().isMaxKey();
+}
 
-bool SharedSlice::isInt() const noexcept { return slice().isInt(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isInt() const noexcept {
+  return slice().isInt();
+}
 
-bool SharedSlice::isUInt() const noexcept { return slice().isUInt(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isUInt() const noexcept {
+  return slice().isUInt();
+}
 
-bool SharedSlice::isSmallInt() const noexcept { return slice().isSmallInt(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isSmallInt() const noexcept {
+  return slice().isSmallInt();
+}
 
-bool SharedSlice::isString() const noexcept { return slice().isString(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isString() const noexcept {
+  return slice().isString();
+}
 
-bool SharedSlice::isBinary() const noexcept { return slice().isBinary(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isBinary() const noexcept {
+  return slice().isBinary();
+}
 
-bool SharedSlice::isBCD() const noexcept { return slice().isBCD(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isBCD() const noexcept {
+  return slice().isBCD();
+}
 
-bool SharedSlice::isCustom() const noexcept { return slice().isCustom(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isCustom() const noexcept {
+  return slice().isCustom();
+}
 
-bool SharedSlice::isTagged() const noexcept { return slice().isTagged(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isTagged() const noexcept {
+  return slice().isTagged();
+}
 
-bool SharedSlice::isInteger() const noexcept { return slice().isInteger(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isInteger() const noexcept {
+  return slice().isInteger();
+}
 
-bool SharedSlice::isNumber() const noexcept { return slice().isNumber(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isNumber() const noexcept {
+  return slice().isNumber();
+}
 
-bool SharedSlice::isSorted() const noexcept { return slice().isSorted(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isSorted() const noexcept {
+  return slice().isSorted();
+}
 
-bool SharedSlice::getBool() const { return slice().getBool(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::getBool() const {
+  return slice().getBool();
+}
 
-bool SharedSlice::getBoolean() const { return slice().getBoolean(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::getBoolean() const {
+  return slice().getBoolean();
+}
 
-double SharedSlice::getDouble() const { return slice().getDouble(); }
+template <typename OwnershipPolicy>
+double BasicSharedSlice<OwnershipPolicy>::getDouble() const {
+  return slice().getDouble();
+}
 
-SharedSlice SharedSlice::at(ValueLength index) const {
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::at(ValueLength index) const
+    -> BasicSharedSlice {
+  if (slice().isArray()) {
+    if (auto const member = compactMember(index); member.has_value()) {
+      return alias(*member);
+    }
+  }
   return alias(slice().at(index));
 }
 
-SharedSlice SharedSlice::operator[](ValueLength index) const {
-  return alias(slice().operator[](index));
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::operator[](ValueLength index) const
+    -> BasicSharedSlice {
+  return at(index);
 }
 
-ValueLength SharedSlice::length() const { return slice().length(); }
+template <typename OwnershipPolicy>
+ValueLength BasicSharedSlice<OwnershipPolicy>::length() const {
+  return slice().length();
+}
 
-SharedSlice SharedSlice::keyAt(ValueLength index, bool translate) const {
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::keyAt(ValueLength index,
+                                              bool translate) const
+    -> BasicSharedSlice {
+  if (slice().isObject()) {
+    if (auto const key = compactMember(index); key.has_value()) {
+      return alias(translate ? key->makeKey() : *key);
+    }
+  }
   return alias(slice().keyAt(index, translate));
 }
 
-SharedSlice SharedSlice::valueAt(ValueLength index) const {
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::valueAt(ValueLength index) const
+    -> BasicSharedSlice {
+  if (slice().isObject()) {
+    if (auto const key = compactMember(index); key.has_value()) {
+      return alias(Slice(key->start() + key->byteSize()));
+    }
+  }
   return alias(slice().valueAt(index));
 }
 
-SharedSlice SharedSlice::getNthValue(ValueLength index) const {
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::getNthValue(ValueLength index) const
+    -> BasicSharedSlice {
+  if (slice().isObject()) {
+    if (auto const key = compactMember(index); key.has_value()) {
+      return alias(Slice(key->start() + key->byteSize()));
+    }
+  }
   return alias(slice().getNthValue(index));
 }
 
-SharedSlice SharedSlice::get(StringRef const& attribute) const {
-  return alias(slice().get(attribute));
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::get(StringRef const& attribute) const
+    -> BasicSharedSlice {
+  return alias(lookup(attribute));
+}
+
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::get(std::string const& attribute) const
+    -> BasicSharedSlice {
+  return alias(lookup(StringRef(attribute)));
 }
 
-SharedSlice SharedSlice::get(std::string const& attribute) const {
-  return alias(slice().get(attribute));
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::get(char const* attribute) const
+    -> BasicSharedSlice {
+  return alias(lookup(StringRef(attribute)));
 }
 
-SharedSlice SharedSlice::get(char const* attribute) const {
-  return alias(slice().get(attribute));
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::get(char const* attribute,
+                                            std::size_t length) const
+    -> BasicSharedSlice {
+  return alias(lookup(StringRef(attribute, length)));
 }
 
-SharedSlice SharedSlice::get(char const* attribute, std::size_t length) const {
-  return alias(slice().get(attribute, length));
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::operator[](
+    StringRef const& attribute) const -> BasicSharedSlice {
+  return get(attribute);
 }
 
-SharedSlice SharedSlice::operator[](StringRef const& attribute) const {
-  return alias(slice().operator[](attribute));
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::operator[](
+    std::string const& attribute) const -> BasicSharedSlice {
+  return get(attribute);
 }
 
-SharedSlice SharedSlice::operator[](std::string const& attribute) const {
-  return alias(slice().operator[](attribute));
+template <typename OwnershipPolicy>
+void BasicSharedSlice<OwnershipPolicy>::getMany(
+    AttributeSet const& attributes, BasicSharedSlice* results) const {
+  attributes.getMany(slice(), results,
+                     [this](Slice value) { return alias(value); });
 }
 
-bool SharedSlice::hasKey(StringRef const& attribute) const {
-  return slice().hasKey(attribute);
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::hasKey(
+    StringRef const& attribute) const {
+  return !lookup(attribute).isNone();
 }
 
-bool SharedSlice::hasKey(std::string const& attribute) const {
-  return slice().hasKey(attribute);
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::hasKey(
+    std::string const& attribute) const {
+  return !lookup(StringRef(attribute)).isNone();
 }
 
-bool SharedSlice::hasKey(char const* attribute) const {
-  return slice().hasKey(attribute);
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::hasKey(char const* attribute) const {
+  return !lookup(StringRef(attribute)).isNone();
 }
 
-bool SharedSlice::hasKey(char const* attribute, std::size_t length) const {
-  return slice().hasKey(attribute, length);
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::hasKey(char const* attribute,
+                                               std::size_t length) const {
+  return !lookup(StringRef(attribute, length)).isNone();
 }
 
-bool SharedSlice::hasKey(std::vector<std::string> const& attributes) const {
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::hasKey(
+    std::vector<std::string> const& attributes) const {
   return slice().hasKey(attributes);
 }
 
-std::shared_ptr<char const> SharedSlice::getExternal() const {
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::getExternal() const
+    -> pointer<char const> {
   return aliasPtr(slice().getExternal());
 }
 
-SharedSlice SharedSlice::resolveExternal() const {
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::resolveExternal() const
+    -> BasicSharedSlice {
   return alias(slice().resolveExternal());
 }
 
-SharedSlice SharedSlice::resolveExternals() const {
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::resolveExternals() const
+    -> BasicSharedSlice {
   return alias(slice().resolveExternals());
 }
 
-bool SharedSlice::isEmptyArray() const { return slice().isEmptyArray(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isEmptyArray() const {
+  return slice().isEmptyArray();
+}
 
-bool SharedSlice::isEmptyObject() const { return slice().isEmptyObject(); }
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isEmptyObject() const {
+  return slice().isEmptyObject();
+}
 
-SharedSlice SharedSlice::translate() const {
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::translate() const -> BasicSharedSlice {
   return alias(slice().translate());
 }
 
-int64_t SharedSlice::getInt() const { return slice().getInt(); }
+template <typename OwnershipPolicy>
+int64_t BasicSharedSlice<OwnershipPolicy>::getInt() const {
+  return slice().getInt();
+}
 
-uint64_t SharedSlice::getUInt() const { return slice().getUInt(); }
+template <typename OwnershipPolicy>
+uint64_t BasicSharedSlice<OwnershipPolicy>::getUInt() const {
+  return slice().getUInt();
+}
 
-int64_t SharedSlice::getSmallInt() const { return slice().getSmallInt(); }
+template <typename OwnershipPolicy>
+int64_t BasicSharedSlice<OwnershipPolicy>::getSmallInt() const {
+  return slice().getSmallInt();
+}
 
-int64_t SharedSlice::getUTCDate() const { return slice().getUTCDate(); }
+template <typename OwnershipPolicy>
+int64_t BasicSharedSlice<OwnershipPolicy>::getUTCDate() const {
+  return slice().getUTCDate();
+}
 
-std::shared_ptr<char const> SharedSlice::getString(ValueLength& length) const {
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::getString(ValueLength& length) const
+    -> pointer<char const> {
   return aliasPtr(slice().getString(length));
 }
 
-std::shared_ptr<char const> SharedSlice::getStringUnchecked(ValueLength& length) const noexcept {
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::getStringUnchecked(
+    ValueLength& length) const noexcept -> pointer<char const> {
   return aliasPtr(slice().getStringUnchecked(length));
 }
 
-ValueLength SharedSlice::getStringLength() const {
+template <typename OwnershipPolicy>
+ValueLength BasicSharedSlice<OwnershipPolicy>::getStringLength() const {
   return slice().getStringLength();
 }
 
-std::string SharedSlice::copyString() const { return slice().copyString(); }
+template <typename OwnershipPolicy>
+std::string BasicSharedSlice<OwnershipPolicy>::copyString() const {
+  return slice().copyString();
+}
 
-StringRef SharedSlice::stringRef() const { return slice().stringRef(); }
+template <typename OwnershipPolicy>
+StringRef BasicSharedSlice<OwnershipPolicy>::stringRef() const {
+  return slice().stringRef();
+}
 
 #ifdef VELOCYPACK_HAS_STRING_VIEW
-std::string_view SharedSlice::stringView() const {
+template <typename OwnershipPolicy>
+std::string_view BasicSharedSlice<OwnershipPolicy>::stringView() const {
   return slice().stringView();
 }
 
 #endif
 
-std::shared_ptr<uint8_t const> SharedSlice::getBinary(ValueLength& length) const {
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::getBinary(ValueLength& length) const
+    -> pointer<uint8_t const> {
   return aliasPtr(slice().getBinary(length));
 }
 
-ValueLength SharedSlice::getBinaryLength() const {
+template <typename OwnershipPolicy>
+ValueLength BasicSharedSlice<OwnershipPolicy>::getBinaryLength() const {
   return slice().getBinaryLength();
 }
 
-std::vector<uint8_t> SharedSlice::copyBinary() const {
+template <typename OwnershipPolicy>
+std::vector<uint8_t> BasicSharedSlice<OwnershipPolicy>::copyBinary() const {
   return slice().copyBinary();
 }
 
-ValueLength SharedSlice::byteSize() const { return slice().byteSize(); }
+template <typename OwnershipPolicy>
+ValueLength BasicSharedSlice<OwnershipPolicy>::byteSize() const {
+  return slice().byteSize();
+}
 
-ValueLength SharedSlice::valueByteSize() const {
+template <typename OwnershipPolicy>
+ValueLength BasicSharedSlice<OwnershipPolicy>::valueByteSize() const {
   return slice().valueByteSize();
 }
 
-ValueLength SharedSlice::findDataOffset(uint8_t head) const noexcept {
+template <typename OwnershipPolicy>
+ValueLength BasicSharedSlice<OwnershipPolicy>::findDataOffset(
+    uint8_t head) const noexcept {
   return slice().findDataOffset(head);
 }
 
-ValueLength SharedSlice::getNthOffset(ValueLength index) const {
+template <typename OwnershipPolicy>
+ValueLength BasicSharedSlice<OwnershipPolicy>::getNthOffset(
+    ValueLength index) const {
   return slice().getNthOffset(index);
 }
 
-SharedSlice SharedSlice::makeKey() const { return alias(slice().makeKey()); }
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::makeKey() const -> BasicSharedSlice {
+  return alias(slice().makeKey());
+}
 
-int SharedSlice::compareString(StringRef const& value) const {
+template <typename OwnershipPolicy>
+int BasicSharedSlice<OwnershipPolicy>::compareString(
+    StringRef const& value) const {
   return slice().compareString(value);
 }
 
-int SharedSlice::compareString(std::string const& value) const {
+template <typename OwnershipPolicy>
+int BasicSharedSlice<OwnershipPolicy>::compareString(
+    std::string const& value) const {
   return slice().compareString(value);
 }
 
-int SharedSlice::compareString(char const* value, std::size_t length) const {
+template <typename OwnershipPolicy>
+int BasicSharedSlice<OwnershipPolicy>::compareString(char const* value,
+                                                     std::size_t length) const {
   return slice().compareString(value, length);
 }
 
-int SharedSlice::compareStringUnchecked(StringRef const& value) const noexcept {
+template <typename OwnershipPolicy>
+int BasicSharedSlice<OwnershipPolicy>::compareStringUnchecked(
+    StringRef const& value) const noexcept {
   return slice().compareStringUnchecked(value);
 }
 
-int SharedSlice::compareStringUnchecked(std::string const& value) const noexcept {
+template <typename OwnershipPolicy>
+int BasicSharedSlice<OwnershipPolicy>::compareStringUnchecked(
+    std::string const& value) const noexcept {
   return slice().compareStringUnchecked(value);
 }
 
-int SharedSlice::compareStringUnchecked(char const* value, std::size_t length) const noexcept {
+template <typename OwnershipPolicy>
+int BasicSharedSlice<OwnershipPolicy>::compareStringUnchecked(
+    char const* value, std::size_t length) const noexcept {
   return slice().compareStringUnchecked(value, length);
 }
 
-bool SharedSlice::isEqualString(StringRef const& attribute) const {
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isEqualString(
+    StringRef const& attribute) const {
   return slice().isEqualString(attribute);
 }
 
-bool SharedSlice::isEqualString(std::string const& attribute) const {
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isEqualString(
+    std::string const& attribute) const {
   return slice().isEqualString(attribute);
 }
 
-bool SharedSlice::isEqualStringUnchecked(StringRef const& attribute) const noexcept {
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isEqualStringUnchecked(
+    StringRef const& attribute) const noexcept {
   return slice().isEqualStringUnchecked(attribute);
 }
 
-bool SharedSlice::isEqualStringUnchecked(std::string const& attribute) const noexcept {
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::isEqualStringUnchecked(
+    std::string const& attribute) const noexcept {
   return slice().isEqualStringUnchecked(attribute);
 }
 
-bool SharedSlice::binaryEquals(Slice const& other) const {
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::binaryEquals(Slice const& other) const {
   return slice().binaryEquals(other);
 }
 
-bool SharedSlice::binaryEquals(SharedSlice const& other) const {
+template <typename OwnershipPolicy>
+bool BasicSharedSlice<OwnershipPolicy>::binaryEquals(
+    BasicSharedSlice const& other) const {
   return slice().binaryEquals(other.slice());
 }
 
-std::string SharedSlice::toHex() const { return slice().toHex(); }
+template <typename OwnershipPolicy>
+std::string BasicSharedSlice<OwnershipPolicy>::toHex() const {
+  return slice().toHex();
+}
 
-std::string SharedSlice::toJson(Options const* options) const {
+template <typename OwnershipPolicy>
+std::string BasicSharedSlice<OwnershipPolicy>::toJson(
+    Options const* options) const {
   return slice().toJson(options);
 }
 
-std::string SharedSlice::toString(Options const* options) const {
+template <typename OwnershipPolicy>
+std::string BasicSharedSlice<OwnershipPolicy>::toString(
+    Options const* options) const {
   return slice().toString(options);
 }
 
-std::string SharedSlice::hexType() const { return slice().hexType(); }
+template <typename OwnershipPolicy>
+std::string BasicSharedSlice<OwnershipPolicy>::hexType() const {
+  return slice().hexType();
+}
 
-int64_t SharedSlice::getIntUnchecked() const noexcept {
+template <typename OwnershipPolicy>
+int64_t BasicSharedSlice<OwnershipPolicy>::getIntUnchecked() const noexcept {
   return slice().getIntUnchecked();
 }
 
-uint64_t SharedSlice::getUIntUnchecked() const noexcept {
+template <typename OwnershipPolicy>
+uint64_t BasicSharedSlice<OwnershipPolicy>::getUIntUnchecked() const noexcept {
   return slice().getUIntUnchecked();
 }
 
-int64_t SharedSlice::getSmallIntUnchecked() const noexcept {
+template <typename OwnershipPolicy>
+int64_t BasicSharedSlice<OwnershipPolicy>::getSmallIntUnchecked()
+    const noexcept {
   return slice().getSmallIntUnchecked();
 }
 
-std::shared_ptr<uint8_t const> SharedSlice::getBCD(int8_t& sign, int32_t& exponent,
-                                                   ValueLength& mantissaLength) const {
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::getBCD(
+    int8_t& sign, int32_t& exponent, ValueLength& mantissaLength) const
+    -> pointer<uint8_t const> {
   return aliasPtr(slice().getBCD(sign, exponent, mantissaLength));
 }
 
-SharedSlice SharedSlice::alias(Slice slice) const noexcept {
-  return SharedSlice(*this, slice);
+template <typename OwnershipPolicy>
+Slice BasicSharedSlice<OwnershipPolicy>::lookup(StringRef attribute) const {
+  auto const object = slice();
+  if (object.isObject() && object.length() >= KeyIndex::minObjectLength) {
+    if (auto* caches = detail::peekCaches(OwnershipPolicy::caches(_start));
+        caches != nullptr && caches->keyIndexEnabled()) {
+      if (auto const* index = caches->keyIndex(object); index != nullptr) {
+        return index->get(object, attribute);
+      }
+    }
+  }
+  if (needsLinearKeySearch(object)) {
+    return findKeyLinear(object, attribute);
+  }
+  return object.get(attribute);
+}
+
+template <typename OwnershipPolicy>
+std::optional<Slice> BasicSharedSlice<OwnershipPolicy>::compactMember(
+    ValueLength index) const {
+  auto const compact = slice();
+  if (!OffsetTable::isCompact(compact) ||
+      compact.length() < OffsetTable::minLength) {
+    return std::nullopt;
+  }
+  auto* caches = detail::peekCaches(OwnershipPolicy::caches(_start));
+  if (caches == nullptr || caches->offsetTableStride() == 0) {
+    return std::nullopt;
+  }
+  if (auto const* table = caches->offsetTable(compact); table != nullptr) {
+    return table->member(compact, index);
+  }
+  return std::nullopt;
 }
 
-SharedSlice::SharedSlice(SharedSlice&& other) noexcept {
+template <typename OwnershipPolicy>
+template <typename F>
+uint64_t BasicSharedSlice<OwnershipPolicy>::memoizedHash(
+    BufferCaches::HashKind kind, uint64_t seed, F&& compute) const {
+  auto const value = slice();
+  if (value.byteSize() < BufferCaches::minMemoizedHashBytes) {
+    return compute(value);
+  }
+  auto* caches = detail::peekCaches(OwnershipPolicy::caches(_start));
+  if (caches == nullptr || !caches->hashCacheEnabled()) {
+    return compute(value);
+  }
+  if (auto const cached = caches->cachedHash(value, kind, seed);
+      cached.has_value()) {
+    return *cached;
+  }
+  auto const hash = compute(value);
+  caches->storeHash(value, kind, seed, hash);
+  return hash;
+}
+
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::alias(Slice slice) const noexcept
+    -> BasicSharedSlice {
+  return BasicSharedSlice(*this, slice);
+}
+
+template <typename OwnershipPolicy>
+BasicSharedSlice<OwnershipPolicy>::BasicSharedSlice(
+    BasicSharedSlice&& other) noexcept {
   _start = std::move(other._start);
   // Set other to point to None
-  other._start = staticSharedNoneBuffer;
+  other._start = OwnershipPolicy::none();
 }
 
-SharedSlice& SharedSlice::operator=(SharedSlice&& other) noexcept {
+template <typename OwnershipPolicy>
+auto BasicSharedSlice<OwnershipPolicy>::operator=(
+    BasicSharedSlice&& other) noexcept -> BasicSharedSlice& {
   _start = std::move(other._start);
   // Set other to point to None
-  other._start = staticSharedNoneBuffer;
+  other._start = OwnershipPolicy::none();
   return *this;
 }
+
+template class arangodb::velocypack::BasicSharedSlice<SharedPtrOwnership>;
+template class arangodb::velocypack::BasicSharedSlice<IntrusiveOwnership>;
+template class arangodb::velocypack::BasicSharedSlice<LocalOwnership>;
+template class arangodb::velocypack::BasicSharedSlice<InlineOwnership>;
+template class arangodb::velocypack::BasicSharedSlice<EpochOwnership>;
+template class arangodb::velocypack::BasicSharedSlice<ShardedOwnership>;
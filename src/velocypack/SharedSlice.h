@@ -23,40 +23,378 @@
 #ifndef SRC_SHAREDSLICE_H
 #define SRC_SHAREDSLICE_H
 
+#include "velocypack/BufferCaches.h"
+#include "velocypack/EpochPtr.h"
+#include "velocypack/InlinePtr.h"
+#include "velocypack/IntrusivePtr.h"
+#include "velocypack/ShardedPtr.h"
+
 #include <velocypack/Buffer.h>
 #include <velocypack/Slice.h>
 
+#include <cstddef>
+#include <iterator>
 #include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
 
 namespace arangodb::velocypack {
 
-class SharedSlice {
+class AttributeSet;
+class Builder;
+
+// The deleter of every std::shared_ptr owning a buffer this library
+// allocated, e.g. by SharedSlice::copyOf() or mapFile(). Found via
+// std::get_deleter, it tells how many bytes the buffer keeps alive, and holds
+// the buffer's caches.
+struct BufferInfo {
+  void operator()(void const*) const noexcept {
+    if (free != nullptr) {
+      free(data, size);
+    }
+  }
+
+  std::size_t size = 0;
+  // Releases data, if set. Otherwise the buffer is part of the control
+  // block's allocation.
+  void (*free)(void* data, std::size_t size) noexcept = nullptr;
+  void* data = nullptr;
+  detail::LazyBufferCaches caches{};
+};
+
+// An ownership policy decides how a BasicSharedSlice keeps its buffer alive.
+// It provides a shared_ptr-like `pointer<T>` (which must support aliasing
+// construction, get() and use_count()), the pointer a None slice holds,
+// conversions from and to a (thread-safe) std::shared_ptr, allocate(),
+// which returns `size` writable bytes owned together with their refcount in
+// a single allocation, pinnedBytes(), the size of the buffer a pointer
+// keeps alive if known, caches(), the (lazily created) BufferCaches of that
+// buffer if it can have any, and adopt(), which moves an arbitrary owner of a
+// buffer into a single allocation with the refcount and points to
+// locate(owner).
+struct SharedPtrOwnership {
+  template <typename T>
+  using pointer = std::shared_ptr<T>;
+
+  [[nodiscard]] static pointer<uint8_t const> none() noexcept;
+  // Places the control block and the data in one allocation
+  [[nodiscard]] static pointer<uint8_t> allocate(std::size_t size);
+  // Known for buffers owned via a BufferInfo
+  [[nodiscard]] static std::optional<std::size_t> pinnedBytes(
+      pointer<uint8_t const> const& data) noexcept;
+  // Available for buffers owned via a BufferInfo
+  [[nodiscard]] static detail::LazyBufferCaches const* caches(
+      pointer<uint8_t const> const& data);
+  [[nodiscard]] static pointer<uint8_t const> fromShared(
+      std::shared_ptr<uint8_t const> data) noexcept {
+    return data;
+  }
+  [[nodiscard]] static std::shared_ptr<uint8_t const> toShared(
+      pointer<uint8_t const>&& data) noexcept {
+    return std::move(data);
+  }
+  template <typename Owner, typename Locate>
+  [[nodiscard]] static pointer<uint8_t const> adopt(Owner&& owner,
+                                                    Locate&& locate) {
+    auto block =
+        std::make_shared<std::decay_t<Owner>>(std::forward<Owner>(owner));
+    auto const* start = locate(std::as_const(*block));
+    return pointer<uint8_t const>(std::move(block), start);
+  }
+};
+
+// Keeps the refcount in a header allocated right before the data, see
+// IntrusivePtr. Saves the separate control block allocation of shared_ptr.
+struct IntrusiveOwnership {
+  template <typename T>
+  using pointer = IntrusivePtr<T>;
+
+  [[nodiscard]] static pointer<uint8_t const> none() noexcept;
+  // Wraps the shared_ptr into an intrusively refcounted allocation.
+  [[nodiscard]] static pointer<uint8_t const> fromShared(
+      std::shared_ptr<uint8_t const> data);
+  [[nodiscard]] static std::shared_ptr<uint8_t const> toShared(
+      pointer<uint8_t const>&& data);
+  [[nodiscard]] static pointer<uint8_t> allocate(std::size_t size) {
+    return allocateIntrusiveBuffer(size);
+  }
+  [[nodiscard]] static std::optional<std::size_t> pinnedBytes(
+      pointer<uint8_t const> const& data) noexcept;
+  [[nodiscard]] static detail::LazyBufferCaches const* caches(
+      pointer<uint8_t const> const& data);
+  template <typename Owner, typename Locate>
+  [[nodiscard]] static pointer<uint8_t const> adopt(Owner&& owner,
+                                                    Locate&& locate) {
+    auto block = makeIntrusive<std::decay_t<Owner>>(std::forward<Owner>(owner));
+    auto const* start = locate(std::as_const(*block));
+    block.header()->base = start;
+    return pointer<uint8_t const>(std::move(block), start);
+  }
+};
+
+// Like IntrusiveOwnership, but with a plain integer refcount. A slice using
+// this policy, and all its aliases, must stay on the thread that created it;
+// use share() to hand it to other threads.
+struct LocalOwnership {
+  template <typename T>
+  using pointer = IntrusivePtr<T, detail::LocalRefCount>;
+
+  [[nodiscard]] static pointer<uint8_t const> none() noexcept;
+  [[nodiscard]] static pointer<uint8_t const> fromShared(
+      std::shared_ptr<uint8_t const> data);
+  // Throws if data is not the only reference to its buffer: the remaining
+  // references would keep updating the plain refcount on this thread.
+  [[nodiscard]] static std::shared_ptr<uint8_t const> toShared(
+      pointer<uint8_t const>&& data);
+  [[nodiscard]] static pointer<uint8_t> allocate(std::size_t size) {
+    return allocateIntrusiveBuffer<detail::LocalRefCount>(size);
+  }
+  [[nodiscard]] static std::optional<std::size_t> pinnedBytes(
+      pointer<uint8_t const> const& data) noexcept;
+  [[nodiscard]] static detail::LazyBufferCaches const* caches(
+      pointer<uint8_t const> const& data);
+  template <typename Owner, typename Locate>
+  [[nodiscard]] static pointer<uint8_t const> adopt(Owner&& owner,
+                                                    Locate&& locate) {
+    auto block = makeIntrusive<std::decay_t<Owner>, detail::LocalRefCount>(
+        std::forward<Owner>(owner));
+    auto const* start = locate(std::as_const(*block));
+    block.header()->base = start;
+    return pointer<uint8_t const>(std::move(block), start);
+  }
+};
+
+// Stores values of up to InlinePtr::inlineCapacity bytes in the slice
+// itself, bigger ones like SharedPtrOwnership. Copying an inline value
+// touches no refcount. Raw pointers and Slices into an inline value are only
+// valid as long as the slice they were taken from lives, unmoved. For the
+// same reason there are no shared iterators for this policy.
+struct InlineOwnership {
+  template <typename T>
+  using pointer = InlinePtr<T>;
+
+  [[nodiscard]] static pointer<uint8_t const> none() noexcept {
+    return pointer<uint8_t const>(SharedPtrOwnership::none());
+  }
+  // Copies small values inline
+  [[nodiscard]] static pointer<uint8_t const> fromShared(
+      std::shared_ptr<uint8_t const> data);
+  [[nodiscard]] static std::shared_ptr<uint8_t const> toShared(
+      pointer<uint8_t const>&& data);
+  [[nodiscard]] static pointer<uint8_t> allocate(std::size_t size);
+  // Zero for inline values
+  [[nodiscard]] static std::optional<std::size_t> pinnedBytes(
+      pointer<uint8_t const> const& data) noexcept {
+    return SharedPtrOwnership::pinnedBytes(data.shared());
+  }
+  // None for inline values
+  [[nodiscard]] static detail::LazyBufferCaches const* caches(
+      pointer<uint8_t const> const& data) {
+    return SharedPtrOwnership::caches(data.shared());
+  }
+  // Copies small values inline, and releases owner right away then
+  template <typename Owner, typename Locate>
+  [[nodiscard]] static pointer<uint8_t const> adopt(Owner&& owner,
+                                                    Locate&& locate) {
+    return fromShared(SharedPtrOwnership::adopt(std::forward<Owner>(owner),
+                                                std::forward<Locate>(locate)));
+  }
+};
+
+// Borrows the buffer instead of counting references to it, see EpochPtr:
+// copies and aliases touch no refcount, but are only valid in the
+// EpochGuard they were created in, and on its thread. Creating a slice from
+// a buffer (including copyOf()) throws outside of an EpochGuard; use share()
+// to keep one beyond it.
+struct EpochOwnership {
+  template <typename T>
+  using pointer = EpochPtr<T>;
+
+  [[nodiscard]] static pointer<uint8_t const> none() noexcept;
+  // Retires an owner of data right away, which the current critical section
+  // keeps alive
+  [[nodiscard]] static pointer<uint8_t const> fromShared(
+      std::shared_ptr<uint8_t const> data);
+  [[nodiscard]] static std::shared_ptr<uint8_t const> toShared(
+      pointer<uint8_t const>&& data) noexcept;
+  [[nodiscard]] static pointer<uint8_t> allocate(std::size_t size);
+  [[nodiscard]] static std::optional<std::size_t> pinnedBytes(
+      pointer<uint8_t const> const& data) noexcept;
+  [[nodiscard]] static detail::LazyBufferCaches const* caches(
+      pointer<uint8_t const> const& data);
+  template <typename Owner, typename Locate>
+  [[nodiscard]] static pointer<uint8_t const> adopt(Owner&& owner,
+                                                    Locate&& locate) {
+    return fromShared(SharedPtrOwnership::adopt(std::forward<Owner>(owner),
+                                                std::forward<Locate>(locate)));
+  }
+};
+
+// Like IntrusiveOwnership, but with a refcount sharded per thread, see
+// ShardedPtr. For a few hot buffers that many threads copy at once; every
+// buffer carries a cache line per shard.
+struct ShardedOwnership {
+  template <typename T>
+  using pointer = ShardedPtr<T>;
+
+  [[nodiscard]] static pointer<uint8_t const> none() noexcept;
+  // Wraps the shared_ptr into an allocation with a sharded refcount.
+  [[nodiscard]] static pointer<uint8_t const> fromShared(
+      std::shared_ptr<uint8_t const> data);
+  [[nodiscard]] static std::shared_ptr<uint8_t const> toShared(
+      pointer<uint8_t const>&& data);
+  [[nodiscard]] static pointer<uint8_t> allocate(std::size_t size) {
+    return allocateShardedBuffer(size);
+  }
+  [[nodiscard]] static std::optional<std::size_t> pinnedBytes(
+      pointer<uint8_t const> const& data) noexcept;
+  [[nodiscard]] static detail::LazyBufferCaches const* caches(
+      pointer<uint8_t const> const& data);
+  template <typename Owner, typename Locate>
+  [[nodiscard]] static pointer<uint8_t const> adopt(Owner&& owner,
+                                                    Locate&& locate) {
+    auto block = makeSharded<std::decay_t<Owner>>(std::forward<Owner>(owner));
+    auto const* start = locate(std::as_const(*block));
+    return pointer<uint8_t const>(std::move(block), start);
+  }
+};
+
+// When to compact a slice on BasicSharedSlice::retain(): once it keeps more
+// than maxWasteRatio times its own size alive, and at least minWastedBytes
+// that it doesn't reference.
+struct RetentionPolicy {
+  double maxWasteRatio = 4.0;
+  std::size_t minWastedBytes = 4096;
+};
+
+template <typename OwnershipPolicy>
+class BasicSharedSlice;
+
+using SharedSlice = BasicSharedSlice<SharedPtrOwnership>;
+using IntrusiveSharedSlice = BasicSharedSlice<IntrusiveOwnership>;
+using LocalSharedSlice = BasicSharedSlice<LocalOwnership>;
+using InlineSharedSlice = BasicSharedSlice<InlineOwnership>;
+using EpochSharedSlice = BasicSharedSlice<EpochOwnership>;
+using ShardedSharedSlice = BasicSharedSlice<ShardedOwnership>;
+
+template <typename OwnershipPolicy>
+class BasicSharedSlice {
  public:
-  explicit SharedSlice(std::shared_ptr<uint8_t const>&& data) noexcept;
-  explicit SharedSlice(std::shared_ptr<uint8_t const> const& data) noexcept;
-  explicit SharedSlice(std::shared_ptr<Buffer<uint8_t> const>&& buffer) noexcept;
-  explicit SharedSlice(std::shared_ptr<Buffer<uint8_t> const> const& buffer) noexcept;
+  using OwnershipPolicyType = OwnershipPolicy;
+  template <typename T>
+  using pointer = typename OwnershipPolicy::template pointer<T>;
+
+  static constexpr bool nothrowFromShared =
+      noexcept(OwnershipPolicy::fromShared(
+          std::declval<std::shared_ptr<uint8_t const>>()));
+
+  explicit BasicSharedSlice(pointer<uint8_t const>&& data) noexcept;
+  explicit BasicSharedSlice(pointer<uint8_t const> const& data) noexcept;
+  explicit BasicSharedSlice(std::shared_ptr<Buffer<uint8_t> const>&&
+                                buffer) noexcept(nothrowFromShared);
+  explicit BasicSharedSlice(std::shared_ptr<Buffer<uint8_t> const> const&
+                                buffer) noexcept(nothrowFromShared);
 
   // Aliasing constructor
-  explicit SharedSlice(SharedSlice&& sharedPtr, Slice slice) noexcept;
-  explicit SharedSlice(SharedSlice const& sharedPtr, Slice slice) noexcept;
+  explicit BasicSharedSlice(BasicSharedSlice&& sharedPtr, Slice slice) noexcept;
+  explicit BasicSharedSlice(BasicSharedSlice const& sharedPtr,
+                            Slice slice) noexcept;
+
+  // Copies slice into a single right-sized allocation, which holds the
+  // refcount as well.
+  [[nodiscard]] static BasicSharedSlice copyOf(Slice slice);
+  // Like copyOf(builder.slice()), but clears the builder afterwards. The
+  // builder must be closed.
+  [[nodiscard]] static BasicSharedSlice fromBuilder(Builder&& builder);
+
+  // Takes ownership of owner without copying its bytes, e.g. of a
+  // std::vector<uint8_t>, a network frame, or a smart pointer to a buffer
+  // with a refcount of its own. owner is moved next to the refcount, in a
+  // single allocation, and locate(owner) is called there to return the
+  // slice: bytes stored inside owner itself (like a short std::string's)
+  // move with it. Adopted buffers have no caches, and unknown pinnedBytes().
+  template <typename Owner, typename Locate>
+  [[nodiscard]] static BasicSharedSlice adopt(Owner&& owner, Locate&& locate) {
+    static_assert(!std::is_lvalue_reference_v<Owner>,
+                  "adopt() takes ownership, move the owner in");
+    return BasicSharedSlice(
+        OwnershipPolicy::adopt(std::move(owner),
+                               [&](std::decay_t<Owner> const& adopted) {
+                                 return Slice(locate(adopted)).start();
+                               }));
+  }
+  // Like adopt(owner, locate), with the slice starting at owner's data(),
+  // e.g. of a std::string or std::vector<uint8_t>
+  template <typename Owner>
+  [[nodiscard]] static BasicSharedSlice adopt(Owner&& owner) {
+    return adopt(std::forward<Owner>(owner),
+                 [](std::decay_t<Owner> const& adopted) {
+                   return Slice(
+                       reinterpret_cast<uint8_t const*>(std::data(adopted)));
+                 });
+  }
 
   // Default constructor, points to a (static) None slice
-  SharedSlice() noexcept;
+  BasicSharedSlice() noexcept;
 
   // Copy & move constructor & assignment
-  SharedSlice(SharedSlice const&) = default;
-  SharedSlice(SharedSlice&&) noexcept;
-  SharedSlice& operator=(SharedSlice const&) = default;
-  SharedSlice& operator=(SharedSlice&&) noexcept;
-  ~SharedSlice() = default;
+  BasicSharedSlice(BasicSharedSlice const&) = default;
+  BasicSharedSlice(BasicSharedSlice&&) noexcept;
+  BasicSharedSlice& operator=(BasicSharedSlice const&) = default;
+  BasicSharedSlice& operator=(BasicSharedSlice&&) noexcept;
+  ~BasicSharedSlice() = default;
 
   // Accessor of the SharedSlice's buffer
-  [[nodiscard]] std::shared_ptr<uint8_t const> const& buffer() const noexcept { return _start; }
+  [[nodiscard]] pointer<uint8_t const> const& buffer() const noexcept {
+    return _start;
+  }
 
   // Access the buffer as a Slice
   [[nodiscard]] Slice slice() const noexcept;
 
+  // Size of the buffer this slice keeps alive, if known. Buffers wrapped from
+  // a Buffer<uint8_t> are unknown; buffers allocated by this library, e.g. by
+  // copyOf(), are known. Zero for a (static) None slice.
+  [[nodiscard]] std::optional<std::size_t> pinnedBytes() const noexcept;
+
+  // Size of the value this slice references, i.e. byteSize()
+  [[nodiscard]] std::size_t referencedBytes() const;
+
+  // Returns a copy in its own right-sized buffer, see copyOf(). Returns this
+  // slice if it already is the only value in its buffer.
+  [[nodiscard]] BasicSharedSlice compact() const;
+
+  // To be called before storing the slice for a long time: returns
+  // compact() if this slice pins more than the policy allows, and this slice
+  // otherwise. Slices whose pinned bytes are unknown are kept as they are.
+  // BasicRetainedSlice calls it on every slice stored into it.
+  [[nodiscard]] BasicSharedSlice retain(RetentionPolicy policy = {}) const;
+
+  // Makes get() and hasKey() on large objects anywhere in this slice's buffer
+  // use a hash index of their keys, built on the first lookup in each object
+  // and shared by all slices into the buffer. Returns false if the buffer
+  // has no caches, i.e. wasn't allocated by this library.
+  bool enableKeyIndex() const;
+
+  // Makes hash(), hash32(), hashSlow(), normalizedHash() and
+  // normalizedHash32() of larger values anywhere in this slice's buffer
+  // remember their results, shared by all slices into the buffer. Returns
+  // false if the buffer has no caches.
+  bool enableHashCache() const;
+
+  // Makes at(), keyAt(), valueAt() and getNthValue() on large compact arrays
+  // and objects anywhere in this slice's buffer use an OffsetTable recording
+  // every stride-th member, built on the first access to each. Returns false
+  // if the buffer has no caches.
+  bool enableOffsetTables(ValueLength stride = 16) const;
+
+  // Converts into a SharedSlice, which may be passed between threads. Leaves
+  // this slice pointing to None.
+  // For a LocalSharedSlice, this must be the last reference to its buffer
+  // (including aliases), otherwise an Exception is thrown.
+  [[nodiscard]] SharedSlice share() &&;
+
   /**************************************
    * Everything else delegates to Slice
    **************************************/
@@ -65,7 +403,7 @@ class SharedSlice {
   static constexpr auto defaultSeed32 = Slice::defaultSeed32;
   static constexpr auto defaultSeed64 = Slice::defaultSeed64;
 
-  [[nodiscard]] SharedSlice value() const noexcept;
+  [[nodiscard]] BasicSharedSlice value() const noexcept;
 
   [[nodiscard]] uint64_t getFirstTag() const;
 
@@ -73,20 +411,20 @@ class SharedSlice {
 
   [[nodiscard]] bool hasTag(uint64_t tagId) const;
 
-  [[nodiscard]] std::shared_ptr<uint8_t const> valueStart() const noexcept;
+  [[nodiscard]] pointer<uint8_t const> valueStart() const noexcept;
 
-  [[nodiscard]] std::shared_ptr<uint8_t const> start() const noexcept;
+  [[nodiscard]] pointer<uint8_t const> start() const noexcept;
 
   template <typename T>
-  [[nodiscard]] std::shared_ptr<T const> startAs() const {
-    return aliasPtr(slice().startAs<T>());
+  [[nodiscard]] pointer<T const> startAs() const {
+    return aliasPtr(slice().template startAs<T>());
   }
 
   [[nodiscard]] uint8_t head() const noexcept;
 
-  [[nodiscard]] std::shared_ptr<uint8_t const> begin() const noexcept;
+  [[nodiscard]] pointer<uint8_t const> begin() const noexcept;
 
-  [[nodiscard]] std::shared_ptr<uint8_t const> end() const;
+  [[nodiscard]] pointer<uint8_t const> end() const;
 
   [[nodiscard]] ValueType type() const noexcept;
 
@@ -161,7 +499,7 @@ class SharedSlice {
 
   template <typename T>
   [[nodiscard]] bool isNumber() const noexcept {
-    return slice().isNumber<T>();
+    return slice().template isNumber<T>();
   }
 
   [[nodiscard]] bool isSorted() const noexcept;
@@ -172,34 +510,42 @@ class SharedSlice {
 
   [[nodiscard]] double getDouble() const;
 
-  [[nodiscard]] SharedSlice at(ValueLength index) const;
+  [[nodiscard]] BasicSharedSlice at(ValueLength index) const;
 
-  [[nodiscard]] SharedSlice operator[](ValueLength index) const;
+  [[nodiscard]] BasicSharedSlice operator[](ValueLength index) const;
 
   [[nodiscard]] ValueLength length() const;
 
-  [[nodiscard]] SharedSlice keyAt(ValueLength index, bool translate = true) const;
+  [[nodiscard]] BasicSharedSlice keyAt(ValueLength index,
+                                       bool translate = true) const;
 
-  [[nodiscard]] SharedSlice valueAt(ValueLength index) const;
+  [[nodiscard]] BasicSharedSlice valueAt(ValueLength index) const;
 
-  [[nodiscard]] SharedSlice getNthValue(ValueLength index) const;
+  [[nodiscard]] BasicSharedSlice getNthValue(ValueLength index) const;
 
   template <typename T>
-  [[nodiscard]] SharedSlice get(std::vector<T> const& attributes, bool resolveExternals = false) const {
+  [[nodiscard]] BasicSharedSlice get(std::vector<T> const& attributes,
+                                     bool resolveExternals = false) const {
     return alias(slice().get(attributes, resolveExternals));
   }
 
-  [[nodiscard]] SharedSlice get(StringRef const& attribute) const;
+  [[nodiscard]] BasicSharedSlice get(StringRef const& attribute) const;
+
+  [[nodiscard]] BasicSharedSlice get(std::string const& attribute) const;
 
-  [[nodiscard]] SharedSlice get(std::string const& attribute) const;
+  [[nodiscard]] BasicSharedSlice get(char const* attribute) const;
 
-  [[nodiscard]] SharedSlice get(char const* attribute) const;
+  [[nodiscard]] BasicSharedSlice get(char const* attribute,
+                                     std::size_t length) const;
 
-  [[nodiscard]] SharedSlice get(char const* attribute, std::size_t length) const;
+  [[nodiscard]] BasicSharedSlice operator[](StringRef const& attribute) const;
 
-  [[nodiscard]] SharedSlice operator[](StringRef const& attribute) const;
+  [[nodiscard]] BasicSharedSlice operator[](std::string const& attribute) const;
 
-  [[nodiscard]] SharedSlice operator[](std::string const& attribute) const;
+  // Looks up all attributes in a single pass over this object. Writes the
+  // value of attributes[i] to results[i], or None if there is no such
+  // attribute.
+  void getMany(AttributeSet const& attributes, BasicSharedSlice* results) const;
 
   [[nodiscard]] bool hasKey(StringRef const& attribute) const;
 
@@ -211,17 +557,17 @@ class SharedSlice {
 
   [[nodiscard]] bool hasKey(std::vector<std::string> const& attributes) const;
 
-  [[nodiscard]] std::shared_ptr<char const> getExternal() const;
+  [[nodiscard]] pointer<char const> getExternal() const;
 
-  [[nodiscard]] SharedSlice resolveExternal() const;
+  [[nodiscard]] BasicSharedSlice resolveExternal() const;
 
-  [[nodiscard]] SharedSlice resolveExternals() const;
+  [[nodiscard]] BasicSharedSlice resolveExternals() const;
 
   [[nodiscard]] bool isEmptyArray() const;
 
   [[nodiscard]] bool isEmptyObject() const;
 
-  [[nodiscard]] SharedSlice translate() const;
+  [[nodiscard]] BasicSharedSlice translate() const;
 
   [[nodiscard]] int64_t getInt() const;
 
@@ -231,19 +577,20 @@ class SharedSlice {
 
   template <typename T>
   [[nodiscard]] T getNumber() const {
-    return slice().getNumber<T>();
+    return slice().template getNumber<T>();
   }
 
   template <typename T>
   [[nodiscard]] T getNumericValue() const {
-    return slice().getNumericValue<T>();
+    return slice().template getNumericValue<T>();
   }
 
   [[nodiscard]] int64_t getUTCDate() const;
 
-  [[nodiscard]] std::shared_ptr<char const> getString(ValueLength& length) const;
+  [[nodiscard]] pointer<char const> getString(ValueLength& length) const;
 
-  [[nodiscard]] std::shared_ptr<char const> getStringUnchecked(ValueLength& length) const noexcept;
+  [[nodiscard]] pointer<char const> getStringUnchecked(
+      ValueLength& length) const noexcept;
 
   [[nodiscard]] ValueLength getStringLength() const;
 
@@ -254,7 +601,7 @@ class SharedSlice {
   [[nodiscard]] std::string_view stringView() const;
 #endif
 
-  [[nodiscard]] std::shared_ptr<uint8_t const> getBinary(ValueLength& length) const;
+  [[nodiscard]] pointer<uint8_t const> getBinary(ValueLength& length) const;
 
   [[nodiscard]] ValueLength getBinaryLength() const;
 
@@ -268,7 +615,7 @@ class SharedSlice {
 
   [[nodiscard]] ValueLength getNthOffset(ValueLength index) const;
 
-  [[nodiscard]] SharedSlice makeKey() const;
+  [[nodiscard]] BasicSharedSlice makeKey() const;
 
   [[nodiscard]] int compareString(StringRef const& value) const;
 
@@ -291,10 +638,10 @@ class SharedSlice {
   [[nodiscard]] bool isEqualStringUnchecked(std::string const& attribute) const noexcept;
 
   [[nodiscard]] bool binaryEquals(Slice const& other) const;
-  [[nodiscard]] bool binaryEquals(SharedSlice const& other) const;
+  [[nodiscard]] bool binaryEquals(BasicSharedSlice const& other) const;
 
-  bool operator==(SharedSlice const& other) const = delete;
-  bool operator!=(SharedSlice const& other) const = delete;
+  bool operator==(BasicSharedSlice const& other) const = delete;
+  bool operator!=(BasicSharedSlice const& other) const = delete;
 
   [[nodiscard]] std::string toHex() const;
   [[nodiscard]] std::string toJson(Options const* options = &Options::Defaults) const;
@@ -307,21 +654,40 @@ class SharedSlice {
 
   [[nodiscard]] int64_t getSmallIntUnchecked() const noexcept;
 
-  [[nodiscard]] std::shared_ptr<uint8_t const> getBCD(int8_t& sign, int32_t& exponent,
-                                        ValueLength& mantissaLength) const;
+  [[nodiscard]] pointer<uint8_t const> getBCD(
+      int8_t& sign, int32_t& exponent, ValueLength& mantissaLength) const;
 
  private:
-  [[nodiscard]] SharedSlice alias(Slice slice) const noexcept;
+  [[nodiscard]] BasicSharedSlice alias(Slice slice) const noexcept;
+
+  // Slice::get(), via the key index if enabled
+  [[nodiscard]] Slice lookup(StringRef attribute) const;
+
+  // The index-th member of this compact array or object via its offset
+  // table, if enabled, and std::nullopt otherwise
+  [[nodiscard]] std::optional<Slice> compactMember(ValueLength index) const;
+
+  // compute(slice()), via the hash cache if enabled
+  template <typename F>
+  [[nodiscard]] uint64_t memoizedHash(BufferCaches::HashKind kind,
+                                      uint64_t seed, F&& compute) const;
 
   template <typename T>
-  [[nodiscard]] std::shared_ptr<T> aliasPtr(T* t) const noexcept {
-    return std::shared_ptr<T>(_start, t);
+  [[nodiscard]] pointer<T> aliasPtr(T* t) const noexcept {
+    return pointer<T>(_start, t);
   }
 
  private:
-  std::shared_ptr<uint8_t const> _start;
+  pointer<uint8_t const> _start;
 };
 
+extern template class BasicSharedSlice<SharedPtrOwnership>;
+extern template class BasicSharedSlice<IntrusiveOwnership>;
+extern template class BasicSharedSlice<LocalOwnership>;
+extern template class BasicSharedSlice<InlineOwnership>;
+extern template class BasicSharedSlice<EpochOwnership>;
+extern template class BasicSharedSlice<ShardedOwnership>;
+
 }  // namespace arangodb::velocypack
 
 #endif  // SRC_SHAREDSLICE_H
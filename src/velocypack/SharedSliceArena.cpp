@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SharedSliceArena.h"
+
+#include <cstring>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+SharedSliceArena::SharedSliceArena(std::size_t chunkSize)
+    : _chunkSize(chunkSize) {}
+
+SharedSlice SharedSliceArena::copyOf(Slice slice) {
+  auto const size = static_cast<std::size_t>(slice.byteSize());
+  if (size > _chunkSize / 4) {
+    return SharedSlice::copyOf(slice);
+  }
+
+  auto* data = tryAllocate(size);
+  if (data == nullptr) {
+    // Never reuses the full chunk in place, even if no slice into it seems to
+    // be left: use_count() ignores weak_ptrs, which could still lock() it
+    // while it is overwritten. Its caches would also outlive its documents.
+    _chunk = SharedPtrOwnership::allocate(_chunkSize);
+    _used = 0;
+    data = tryAllocate(size);
+  }
+
+  std::memcpy(data, slice.start(), size);
+  return SharedSlice(SharedPtrOwnership::pointer<uint8_t const>(_chunk, data));
+}
+
+void SharedSliceArena::release() noexcept {
+  _chunk.reset();
+  _used = 0;
+}
+
+uint8_t* SharedSliceArena::tryAllocate(std::size_t size) noexcept {
+  if (_chunk == nullptr || _chunkSize - _used < size) {
+    return nullptr;
+  }
+  auto* data = _chunk.get() + _used;
+  _used += size;
+  return data;
+}
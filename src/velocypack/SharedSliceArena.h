@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_SHAREDSLICEARENA_H
+#define SRC_SHAREDSLICEARENA_H
+
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Slice.h>
+
+#include <cstddef>
+
+namespace arangodb::velocypack {
+
+/**
+ * @brief Bump-allocates the bytes of many SharedSlices out of large chunks.
+ *
+ *        All slices allocated from one chunk share its refcount, so the chunk
+ *        is freed when the arena has moved on and the last slice into it is
+ *        gone. Slices handed out are ordinary SharedSlices and can be aliased
+ *        and shared between threads as usual. The bytes of a chunk are never
+ *        overwritten once handed out, so a full chunk is never reused.
+ *
+ *        Values larger than a quarter of the chunk size get their own
+ *        allocation, see SharedSlice::copyOf().
+ *
+ *        The arena itself is not thread-safe.
+ */
+class SharedSliceArena {
+ public:
+  static constexpr std::size_t defaultChunkSize = 64 * 1024;
+
+  explicit SharedSliceArena(std::size_t chunkSize = defaultChunkSize);
+
+  SharedSliceArena(SharedSliceArena const&) = delete;
+  SharedSliceArena(SharedSliceArena&&) noexcept = default;
+  SharedSliceArena& operator=(SharedSliceArena const&) = delete;
+  SharedSliceArena& operator=(SharedSliceArena&&) noexcept = default;
+  ~SharedSliceArena() = default;
+
+  // Copies slice into the current chunk
+  [[nodiscard]] SharedSlice copyOf(Slice slice);
+
+  [[nodiscard]] std::size_t chunkSize() const noexcept { return _chunkSize; }
+
+  // Drops the arena's reference to the current chunk. It is freed as soon as
+  // the slices allocated from it are gone.
+  void release() noexcept;
+
+ private:
+  // Returns size bytes in the current chunk, or nullptr if they don't fit
+  [[nodiscard]] uint8_t* tryAllocate(std::size_t size) noexcept;
+
+ private:
+  std::size_t _chunkSize;
+  std::size_t _used = 0;
+  SharedPtrOwnership::pointer<uint8_t> _chunk;
+};
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_SHAREDSLICEARENA_H
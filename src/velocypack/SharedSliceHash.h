@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_SHAREDSLICEHASH_H
+#define SRC_SHAREDSLICEHASH_H
+
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Compare.h>
+#include <velocypack/Slice.h>
+
+#include <cstddef>
+
+namespace arangodb::velocypack {
+
+namespace detail {
+[[nodiscard]] inline Slice sliceOf(Slice slice) noexcept { return slice; }
+template <typename OwnershipPolicy>
+[[nodiscard]] Slice sliceOf(
+    BasicSharedSlice<OwnershipPolicy> const& sharedSlice) noexcept {
+  return sharedSlice.slice();
+}
+}  // namespace detail
+
+// Hash and equality of SharedSlices (of any ownership policy) and Slices by
+// their binary content, e.g. for std::unordered_map. Mixing them in one
+// lookup is fine, all overloads agree.
+struct SharedSliceHash {
+  using is_transparent = void;
+
+  [[nodiscard]] std::size_t operator()(Slice slice) const {
+    return static_cast<std::size_t>(slice.hash());
+  }
+  // Uses the buffer's hash cache, if enabled
+  template <typename OwnershipPolicy>
+  [[nodiscard]] std::size_t operator()(
+      BasicSharedSlice<OwnershipPolicy> const& sharedSlice) const {
+    return static_cast<std::size_t>(sharedSlice.hash());
+  }
+};
+
+struct SharedSliceEqual {
+  using is_transparent = void;
+
+  template <typename Left, typename Right>
+  [[nodiscard]] bool operator()(Left const& left, Right const& right) const {
+    return detail::sliceOf(left).binaryEquals(detail::sliceOf(right));
+  }
+};
+
+// Same, but by normalized content: e.g. numbers of different types but equal
+// value are equal, as are objects with the same attributes in another order.
+struct SharedSliceNormalizedHash {
+  using is_transparent = void;
+
+  [[nodiscard]] std::size_t operator()(Slice slice) const {
+    return static_cast<std::size_t>(slice.normalizedHash());
+  }
+  // Uses the buffer's hash cache, if enabled
+  template <typename OwnershipPolicy>
+  [[nodiscard]] std::size_t operator()(
+      BasicSharedSlice<OwnershipPolicy> const& sharedSlice) const {
+    return static_cast<std::size_t>(sharedSlice.normalizedHash());
+  }
+};
+
+struct SharedSliceNormalizedEqual {
+  using is_transparent = void;
+
+  template <typename Left, typename Right>
+  [[nodiscard]] bool operator()(Left const& left, Right const& right) const {
+    return NormalizedCompare::equals(detail::sliceOf(left),
+                                     detail::sliceOf(right));
+  }
+};
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_SHAREDSLICEHASH_H
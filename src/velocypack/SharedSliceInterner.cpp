@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SharedSliceInterner.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+struct SharedSliceInterner::Registration {
+  std::shared_ptr<Shard> shard;
+  uint64_t hash;
+  SharedSlice value;
+  // Set once the entry is in the shard. Until then unregister() must not
+  // lock the shard, whose mutex intern() holds.
+  bool registered = false;
+};
+
+SharedSliceInterner::SharedSliceInterner() {
+  for (auto& shard : _shards) {
+    shard = std::make_shared<Shard>();
+  }
+}
+
+SharedSlice SharedSliceInterner::intern(SharedSlice value) {
+  _lookups.fetch_add(1, std::memory_order_relaxed);
+  if (value.buffer().use_count() == 0) {
+    // None, or some other slice nobody owns
+    return value;
+  }
+  auto const hash = value.hash();
+  auto const& shardPtr = shardFor(hash);
+  auto& shard = *shardPtr;
+  // Released after the lock: dropping the last reference to a value runs
+  // unregister(), which locks the shard
+  auto misses = std::vector<SharedSlice>();
+  auto lock = std::lock_guard(shard.mutex);
+
+  auto [begin, end] = shard.entries.equal_range(hash);
+  for (auto it = begin; it != end; ++it) {
+    // Entries of freed values are already gone, or waiting for this lock in
+    // unregister()
+    if (auto canonical = it->second.value.lock(); canonical != nullptr) {
+      auto interned = SharedSlice(std::move(canonical));
+      if (interned.binaryEquals(value.slice())) {
+        _hits.fetch_add(1, std::memory_order_relaxed);
+        _bytesSaved.fetch_add(value.byteSize(), std::memory_order_relaxed);
+        return interned;
+      }
+      misses.emplace_back(std::move(interned));
+    }
+  }
+
+  // Only interns values alone in their buffer: otherwise the entry would pin
+  // the rest of the buffer, e.g. an arena or reader chunk, and only expire
+  // with all of it
+  auto canonical = value.compact();
+  auto const* start = canonical.slice().start();
+  auto const size = canonical.byteSize();
+  auto* registration = new Registration{shardPtr, hash, std::move(canonical)};
+  auto owner =
+      std::shared_ptr<uint8_t const>(start, BufferInfo{size, &unregister,
+                                                       registration});
+  shard.entries.emplace(hash, Entry{start, owner});
+  registration->registered = true;
+  return SharedSlice(std::move(owner));
+}
+
+void SharedSliceInterner::unregister(void* data, std::size_t) noexcept {
+  auto* registration = static_cast<Registration*>(data);
+  if (registration->registered) {
+    auto& shard = *registration->shard;
+    auto lock = std::lock_guard(shard.mutex);
+    auto const* start = registration->value.slice().start();
+    auto [begin, end] = shard.entries.equal_range(registration->hash);
+    auto it = std::find_if(begin, end, [&](auto const& entry) {
+      return entry.second.start == start;
+    });
+    if (it != end) {
+      shard.entries.erase(it);
+    }
+  }
+  delete registration;
+}
+
+InternerStats SharedSliceInterner::stats() const {
+  auto stats = InternerStats();
+  stats.lookups = _lookups.load(std::memory_order_relaxed);
+  stats.hits = _hits.load(std::memory_order_relaxed);
+  stats.bytesSaved = _bytesSaved.load(std::memory_order_relaxed);
+  for (auto& shard : _shards) {
+    auto lock = std::lock_guard(shard->mutex);
+    stats.entries += shard->entries.size();
+  }
+  return stats;
+}
+
+auto SharedSliceInterner::shardFor(uint64_t hash) const noexcept
+    -> std::shared_ptr<Shard> const& {
+  // The low bits pick the bucket inside the shard
+  return _shards[(hash >> 56) % shardCount];
+}
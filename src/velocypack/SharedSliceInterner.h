@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_SHAREDSLICEINTERNER_H
+#define SRC_SHAREDSLICEINTERNER_H
+
+#include "velocypack/SharedSlice.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace arangodb::velocypack {
+
+struct InternerStats {
+  // Calls to intern()
+  uint64_t lookups = 0;
+  // Calls to intern() that returned an equal, already interned slice
+  uint64_t hits = 0;
+  // Sum of the byte sizes of the values passed to those calls, whose buffers
+  // the callers could release
+  uint64_t bytesSaved = 0;
+  // Values currently interned
+  uint64_t entries = 0;
+
+  [[nodiscard]] double dedupRatio() const noexcept {
+    return lookups == 0
+               ? 0.0
+               : static_cast<double>(hits) / static_cast<double>(lookups);
+  }
+};
+
+/**
+ * @brief Maps values to one canonical SharedSlice per distinct binary
+ *        content, so byte-identical duplicates can share one buffer.
+ *
+ *        Entries are held weakly: an interned value is freed once no slice
+ *        references it any more, and its entry is removed right then by
+ *        the deleter of its buffer. The value's bytes are not part of the
+ *        control block the entry keeps allocated.
+ *
+ *        Thread-safe. The entries are split into shards by hash, each with
+ *        its own mutex.
+ */
+class SharedSliceInterner {
+ public:
+  SharedSliceInterner();
+
+  SharedSliceInterner(SharedSliceInterner const&) = delete;
+  SharedSliceInterner& operator=(SharedSliceInterner const&) = delete;
+
+  // Returns the interned slice with the same binary content as value,
+  // interning value first if there is none. A value sharing its buffer with
+  // others, e.g. one from a SharedSliceArena, is interned as a compact()
+  // copy. None is returned as is.
+  [[nodiscard]] SharedSlice intern(SharedSlice value);
+
+  [[nodiscard]] InternerStats stats() const;
+
+ private:
+  static constexpr std::size_t shardCount = 16;
+
+  struct Entry {
+    uint8_t const* start;
+    std::weak_ptr<uint8_t const> value;
+  };
+
+  // Shared with the deleters of the interned values, which may outlive the
+  // interner
+  struct Shard {
+    mutable std::mutex mutex;
+    std::unordered_multimap<uint64_t, Entry> entries;
+  };
+
+  // Owns an interned value, and unregisters it when its last reference is
+  // gone
+  struct Registration;
+  static void unregister(void* registration, std::size_t) noexcept;
+
+  [[nodiscard]] std::shared_ptr<Shard> const& shardFor(
+      uint64_t hash) const noexcept;
+
+ private:
+  std::array<std::shared_ptr<Shard>, shardCount> _shards;
+  std::atomic<uint64_t> _lookups{0};
+  std::atomic<uint64_t> _hits{0};
+  std::atomic<uint64_t> _bytesSaved{0};
+};
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_SHAREDSLICEINTERNER_H
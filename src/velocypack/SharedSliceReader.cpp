@@ -0,0 +1,229 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SharedSliceReader.h"
+
+#include <velocypack/Exception.h>
+#include <velocypack/Slice.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+// Returns how many bytes of the value starting at data are needed to compute
+// its byteSize(), given that `available` bytes are there. Returns more than
+// `available` if they don't suffice.
+std::size_t headerBytesNeeded(uint8_t const* data,
+                              std::size_t available) noexcept {
+  if (available == 0) {
+    return 1;
+  }
+  auto const head = data[0];
+  if (head >= 0x02 && head <= 0x09) {
+    // array or object with a byte length of 1, 2, 4 or 8 bytes
+    return 1 + (std::size_t{1} << ((head - 0x02) % 4));
+  }
+  if (head >= 0x0b && head <= 0x12) {
+    return 1 + (std::size_t{1} << ((head - 0x0b) % 4));
+  }
+  if (head == 0x13 || head == 0x14) {
+    // compact array or object, the byte length is a varint
+    for (std::size_t i = 1; i < available; ++i) {
+      if ((data[i] & 0x80) == 0) {
+        return i + 1;
+      }
+    }
+    return available + 1;
+  }
+  if (head == 0xbf) {
+    // long string
+    return 1 + 8;
+  }
+  if (head >= 0xc0 && head <= 0xc7) {
+    // binary
+    return 1 + (head - 0xbf);
+  }
+  if (head >= 0xc8 && head <= 0xcf) {
+    // positive BCD
+    return 1 + (head - 0xc7);
+  }
+  if (head >= 0xd0 && head <= 0xd7) {
+    // negative BCD
+    return 1 + (head - 0xcf);
+  }
+  if (head == 0xee || head == 0xef) {
+    // tagged value, followed by the value itself
+    std::size_t const offset = head == 0xee ? 1 + 1 : 1 + 8;
+    if (available < offset) {
+      return offset;
+    }
+    return offset + headerBytesNeeded(data + offset, available - offset);
+  }
+  if (head >= 0xf4) {
+    // custom type with a byte length of 1 (0xf4 - 0xf6), 2 (0xf7 - 0xf9),
+    // 4 (0xfa - 0xfc) or 8 (0xfd - 0xff) bytes
+    return 1 + (std::size_t{1} << ((head - 0xf4) / 3));
+  }
+  // the head alone determines the size
+  return 1;
+}
+
+// Released chunks beyond this many are freed
+constexpr std::size_t maxFreeChunks = 4;
+}  // namespace
+
+struct SharedSliceReader::ChunkPool {
+  // In front of the bytes of each chunk
+  struct Header {
+    std::shared_ptr<ChunkPool> pool;
+  };
+
+  static constexpr std::size_t headerSize = detail::payloadOffset<Header>;
+
+  static void freeChunk(void* block) noexcept {
+    static_cast<Header*>(block)->~Header();
+    ::operator delete(block);
+  }
+
+  explicit ChunkPool(std::size_t chunkSize) : chunkSize(chunkSize) {
+    free.reserve(maxFreeChunks);
+  }
+  ~ChunkPool() {
+    for (auto* block : free) {
+      freeChunk(block);
+    }
+  }
+
+  // The deleter of every chunk. Runs when the last shared_ptr is gone, so no
+  // weak_ptr can lock() the chunk any more.
+  static void recycle(void* block, std::size_t capacity) noexcept {
+    auto pool = std::move(static_cast<Header*>(block)->pool);
+    if (capacity == pool->chunkSize) {
+      auto lock = std::lock_guard(pool->mutex);
+      if (pool->free.size() < maxFreeChunks) {
+        pool->free.emplace_back(block);
+        return;
+      }
+    }
+    freeChunk(block);
+  }
+
+  std::size_t const chunkSize;
+  std::mutex mutex;
+  std::vector<void*> free;
+};
+
+SharedSliceReader::SharedSliceReader(int fd, std::size_t chunkSize)
+    : _fd(fd),
+      _chunkSize(chunkSize),
+      _pool(std::make_shared<ChunkPool>(chunkSize)) {}
+
+std::optional<SharedSlice> SharedSliceReader::next() {
+  while (true) {
+    auto const available = _end - _begin;
+    auto* start = _chunk.get() + _begin;
+    auto needed = headerBytesNeeded(start, available);
+    if (needed <= available) {
+      auto const size = static_cast<std::size_t>(Slice(start).byteSize());
+      if (size <= available) {
+        _begin += size;
+        return SharedSlice(
+            SharedPtrOwnership::pointer<uint8_t const>(_chunk, start));
+      }
+      needed = size;
+    }
+
+    if (_capacity - _begin < needed) {
+      makeRoom(needed);
+    }
+    if (!fill()) {
+      if (_end == _begin) {
+        return std::nullopt;
+      }
+      throw Exception(Exception::ValidatorInvalidLength,
+                      "stream ends in the middle of a value");
+    }
+  }
+}
+
+void SharedSliceReader::makeRoom(std::size_t needed) {
+  // Always moves to another chunk, even if no slice into the current one
+  // seems to be left: use_count() ignores weak_ptrs, which could still
+  // lock() it while it is overwritten. It is recycled once really released.
+  auto const available = _end - _begin;
+  auto const capacity = std::max(_chunkSize, needed);
+  auto chunk = takeChunk(capacity);
+  if (available > 0) {
+    std::memcpy(chunk.get(), _chunk.get() + _begin, available);
+  }
+  _chunk = std::move(chunk);
+  _capacity = capacity;
+  _begin = 0;
+  _end = available;
+}
+
+bool SharedSliceReader::fill() {
+  while (true) {
+    auto const result = ::read(_fd, _chunk.get() + _end, _capacity - _end);
+    if (result > 0) {
+      _end += static_cast<std::size_t>(result);
+      return true;
+    }
+    if (result == 0) {
+      return false;
+    }
+    if (errno != EINTR) {
+      throw std::system_error(errno, std::generic_category(), "cannot read");
+    }
+  }
+}
+
+auto SharedSliceReader::takeChunk(std::size_t capacity)
+    -> SharedPtrOwnership::pointer<uint8_t> {
+  void* block = nullptr;
+  if (capacity == _chunkSize) {
+    auto lock = std::lock_guard(_pool->mutex);
+    if (!_pool->free.empty()) {
+      block = _pool->free.back();
+      _pool->free.pop_back();
+    }
+  }
+  if (block == nullptr) {
+    block = ::operator new(ChunkPool::headerSize + capacity);
+    new (block) ChunkPool::Header();
+  }
+  static_cast<ChunkPool::Header*>(block)->pool = _pool;
+  auto* data = static_cast<uint8_t*>(block) + ChunkPool::headerSize;
+  // A fresh BufferInfo each time, so no caches of earlier values survive
+  return SharedPtrOwnership::pointer<uint8_t>(
+      data, BufferInfo{capacity, &ChunkPool::recycle, block});
+}
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_SHAREDSLICEREADER_H
+#define SRC_SHAREDSLICEREADER_H
+
+#include "velocypack/SharedSlice.h"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+namespace arangodb::velocypack {
+
+/**
+ * @brief Reads back-to-back VPack values from a file descriptor, e.g. a pipe
+ *        or a file, and returns them as SharedSlices.
+ *
+ *        Data is read in large chunks and the slices alias into the chunk
+ *        they were read into, so values are not copied. The only exception
+ *        is a value crossing the end of a chunk: its beginning is copied
+ *        once to the start of the next chunk. Values larger than a chunk
+ *        get a chunk of their own.
+ *
+ *        Once the last slice into a chunk is gone, the chunk's deleter puts
+ *        it on a free list for the reader to fill again. A weak_ptr cannot
+ *        lock() it any more by then, so bytes handed out are never
+ *        overwritten while something can see them.
+ *
+ *        The reader does not own the file descriptor, and is not
+ *        thread-safe. The slices it returns are ordinary SharedSlices.
+ */
+class SharedSliceReader {
+ public:
+  static constexpr std::size_t defaultChunkSize = 1024 * 1024;
+
+  explicit SharedSliceReader(int fd, std::size_t chunkSize = defaultChunkSize);
+
+  SharedSliceReader(SharedSliceReader const&) = delete;
+  SharedSliceReader(SharedSliceReader&&) noexcept = default;
+  SharedSliceReader& operator=(SharedSliceReader const&) = delete;
+  SharedSliceReader& operator=(SharedSliceReader&&) noexcept = default;
+  ~SharedSliceReader() = default;
+
+  // Returns the next value, or std::nullopt at the end of the stream.
+  // Throws std::system_error if reading fails, and an Exception if the stream
+  // ends in the middle of a value.
+  [[nodiscard]] std::optional<SharedSlice> next();
+
+ private:
+  // Makes sure `needed` bytes starting at the current value fit into the
+  // chunk, moving the current value's bytes to the start of a chunk.
+  void makeRoom(std::size_t needed);
+  // Reads as much as fits into the chunk. Returns false at the end of the
+  // stream.
+  [[nodiscard]] bool fill();
+  // Returns a recycled chunk if capacity is the chunk size and there is one,
+  // and a new one otherwise
+  [[nodiscard]] SharedPtrOwnership::pointer<uint8_t> takeChunk(
+      std::size_t capacity);
+
+ private:
+  // Shared by the reader and its chunks, which may outlive it
+  struct ChunkPool;
+
+  int _fd;
+  std::size_t _chunkSize;
+  std::shared_ptr<ChunkPool> _pool;
+  SharedPtrOwnership::pointer<uint8_t> _chunk;
+  std::size_t _capacity = 0;
+  // Start of the next value
+  std::size_t _begin = 0;
+  // End of the data read so far
+  std::size_t _end = 0;
+};
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_SHAREDSLICEREADER_H
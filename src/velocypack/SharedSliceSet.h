@@ -0,0 +1,301 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_SHAREDSLICESET_H
+#define SRC_SHAREDSLICESET_H
+
+#include "velocypack/SharedSlice.h"
+#include "velocypack/SharedSliceHash.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace arangodb::velocypack {
+
+namespace detail {
+/**
+ * @brief Open addressing hash table with linear probing, backing
+ *        SharedSliceSet and SharedSliceMap.
+ *
+ *        All slots live in one array. Each stores the full hash next to the
+ *        key, so probing compares hashes and only touches the keys' buffers
+ *        on a hash match, and growing never rehashes a key. Erasing shifts
+ *        the following entries back instead of leaving tombstones.
+ *
+ *        Slot needs the members hash, which is 0 in empty slots, and key, as
+ *        well as emplace() and reset().
+ */
+template <typename Slot, typename Hash, typename Equal>
+class FlatSharedSliceTable {
+ public:
+  [[nodiscard]] std::size_t size() const noexcept { return _size; }
+  [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+  // The number of slots
+  [[nodiscard]] std::size_t capacity() const noexcept { return _slots.size(); }
+
+  void clear() noexcept {
+    _slots.clear();
+    _size = 0;
+    _mask = 0;
+  }
+
+  // Makes room for count entries without growing
+  void reserve(std::size_t count) {
+    auto capacity = minCapacity;
+    while (capacity * maxLoadNumerator < count * maxLoadDenominator) {
+      capacity *= 2;
+    }
+    if (capacity > _slots.size()) {
+      rehash(capacity);
+    }
+  }
+
+  // Returns true if an equal key was found and erased
+  template <typename K>
+  bool erase(K const& key) {
+    auto* slot = findSlot(key);
+    if (slot == nullptr) {
+      return false;
+    }
+    eraseSlot(static_cast<std::size_t>(slot - _slots.data()));
+    return true;
+  }
+
+  template <typename K>
+  [[nodiscard]] bool contains(K const& key) const {
+    return findSlot(key) != nullptr;
+  }
+
+ protected:
+  template <typename K>
+  [[nodiscard]] Slot* findSlot(K const& key) const {
+    if (_size == 0) {
+      return nullptr;
+    }
+    auto const hash = storedHash(Hash{}(key));
+    for (auto i = hash & _mask;; i = (i + 1) & _mask) {
+      auto& slot = _slots[i];
+      if (slot.hash == 0) {
+        return nullptr;
+      }
+      if (slot.hash == hash && Equal{}(slot.key, key)) {
+        return &slot;
+      }
+    }
+  }
+
+  // Returns the slot of key, and whether it was newly inserted
+  template <typename Key, typename... Args>
+  std::pair<Slot*, bool> emplaceSlot(Key&& key, Args&&... args) {
+    if ((_size + 1) * maxLoadDenominator > _slots.size() * maxLoadNumerator) {
+      rehash(_slots.empty() ? minCapacity : 2 * _slots.size());
+    }
+    auto const hash = storedHash(Hash{}(key));
+    for (auto i = hash & _mask;; i = (i + 1) & _mask) {
+      auto& slot = _slots[i];
+      if (slot.hash == 0) {
+        slot.emplace(hash, std::forward<Key>(key), std::forward<Args>(args)...);
+        ++_size;
+        return {&slot, true};
+      }
+      if (slot.hash == hash && Equal{}(slot.key, key)) {
+        return {&slot, false};
+      }
+    }
+  }
+
+  template <typename F>
+  void forEachSlot(F&& f) const {
+    for (auto& slot : _slots) {
+      if (slot.hash != 0) {
+        f(slot);
+      }
+    }
+  }
+
+ private:
+  static constexpr std::size_t minCapacity = 16;
+  // Grow beyond 3/4 full
+  static constexpr std::size_t maxLoadNumerator = 3;
+  static constexpr std::size_t maxLoadDenominator = 4;
+
+  // 0 marks empty slots
+  [[nodiscard]] static uint64_t storedHash(std::size_t hash) noexcept {
+    return hash == 0 ? 1 : static_cast<uint64_t>(hash);
+  }
+
+  void rehash(std::size_t capacity) {
+    auto slots = std::vector<Slot>(capacity);
+    auto const mask = capacity - 1;
+    for (auto& slot : _slots) {
+      if (slot.hash != 0) {
+        auto i = slot.hash & mask;
+        while (slots[i].hash != 0) {
+          i = (i + 1) & mask;
+        }
+        slots[i] = std::move(slot);
+      }
+    }
+    _slots = std::move(slots);
+    _mask = mask;
+  }
+
+  void eraseSlot(std::size_t index) {
+    // Move back every following entry of the probe sequence that may live at
+    // index, i.e. whose home slot isn't between index and its position
+    for (auto i = (index + 1) & _mask; _slots[i].hash != 0;
+         i = (i + 1) & _mask) {
+      auto const home = _slots[i].hash & _mask;
+      if (((i - home) & _mask) >= ((i - index) & _mask)) {
+        _slots[index] = std::move(_slots[i]);
+        index = i;
+      }
+    }
+    _slots[index].reset();
+    --_size;
+  }
+
+  // Mutable so const lookups can hand out slots, const-ness is up to the
+  // derived class
+  mutable std::vector<Slot> _slots;
+  std::size_t _size = 0;
+  std::size_t _mask = 0;
+};
+
+template <typename Key>
+struct SetSlot {
+  void emplace(uint64_t newHash, Key newKey) {
+    hash = newHash;
+    key = std::move(newKey);
+  }
+  void reset() noexcept {
+    hash = 0;
+    key = Key();
+  }
+
+  uint64_t hash = 0;
+  Key key;
+};
+
+template <typename Key, typename T>
+struct MapSlot {
+  template <typename... Args>
+  void emplace(uint64_t newHash, Key newKey, Args&&... args) {
+    value = T(std::forward<Args>(args)...);
+    key = std::move(newKey);
+    hash = newHash;
+  }
+  void reset() {
+    hash = 0;
+    key = Key();
+    value = T();
+  }
+
+  uint64_t hash = 0;
+  Key key;
+  T value;
+};
+}  // namespace detail
+
+/**
+ * @brief A flat hash set of SharedSlices, by default compared by binary
+ *        content. Use SharedSliceNormalizedHash and SharedSliceNormalizedEqual
+ *        to compare by normalized content.
+ *
+ *        Lookups accept a Slice as well as a Key. Inserting and erasing
+ *        invalidate pointers returned by find().
+ */
+template <typename Hash = SharedSliceHash, typename Equal = SharedSliceEqual,
+          typename Key = SharedSlice>
+class SharedSliceSet
+    : public detail::FlatSharedSliceTable<detail::SetSlot<Key>, Hash, Equal> {
+ public:
+  // Returns true if key was inserted, false if an equal key already existed
+  bool insert(Key key) { return this->emplaceSlot(std::move(key)).second; }
+
+  // Returns the key equal to key, or nullptr
+  template <typename K>
+  [[nodiscard]] Key const* find(K const& key) const {
+    auto* slot = this->findSlot(key);
+    return slot == nullptr ? nullptr : &slot->key;
+  }
+
+  // Calls f(key) for every key
+  template <typename F>
+  void forEach(F&& f) const {
+    this->forEachSlot(
+        [&](auto& slot) { f(static_cast<Key const&>(slot.key)); });
+  }
+};
+
+/**
+ * @brief A flat hash map with SharedSlice keys, see SharedSliceSet. T must be
+ *        default constructible and movable.
+ */
+template <typename T, typename Hash = SharedSliceHash,
+          typename Equal = SharedSliceEqual, typename Key = SharedSlice>
+class SharedSliceMap
+    : public detail::FlatSharedSliceTable<detail::MapSlot<Key, T>, Hash,
+                                          Equal> {
+ public:
+  // Inserts T(args...) if there is no key equal to key yet. Returns the value
+  // of key, and whether it was inserted.
+  template <typename... Args>
+  std::pair<T*, bool> tryEmplace(Key key, Args&&... args) {
+    auto [slot, inserted] =
+        this->emplaceSlot(std::move(key), std::forward<Args>(args)...);
+    return {&slot->value, inserted};
+  }
+
+  T& operator[](Key key) { return *tryEmplace(std::move(key)).first; }
+
+  // Returns the value of the key equal to key, or nullptr
+  template <typename K>
+  [[nodiscard]] T* find(K const& key) {
+    auto* slot = this->findSlot(key);
+    return slot == nullptr ? nullptr : &slot->value;
+  }
+  template <typename K>
+  [[nodiscard]] T const* find(K const& key) const {
+    auto* slot = this->findSlot(key);
+    return slot == nullptr ? nullptr : &slot->value;
+  }
+
+  // Calls f(key, value) for every entry
+  template <typename F>
+  void forEach(F&& f) {
+    this->forEachSlot(
+        [&](auto& slot) { f(static_cast<Key const&>(slot.key), slot.value); });
+  }
+  template <typename F>
+  void forEach(F&& f) const {
+    this->forEachSlot([&](auto& slot) {
+      f(static_cast<Key const&>(slot.key), static_cast<T const&>(slot.value));
+    });
+  }
+};
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_SHAREDSLICESET_H
@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+// The pool the current thread is a worker of, if any, and its queue
+thread_local WorkStealingPool const* currentPool = nullptr;
+thread_local std::size_t currentPoolQueue = 0;
+}  // namespace
+
+WorkStealingPool::WorkStealingPool(std::size_t threads) {
+  for (std::size_t i = 0; i < threads + 1; ++i) {
+    _queues.emplace_back(std::make_unique<Queue>());
+  }
+  _threads.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    _threads.emplace_back([this, i] { work(i); });
+  }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    auto lock = std::lock_guard(_sleepMutex);
+    _stopping = true;
+  }
+  _wakeup.notify_all();
+  for (auto& thread : _threads) {
+    thread.join();
+  }
+}
+
+void WorkStealingPool::run(std::size_t count,
+                           std::function<void(std::size_t)> const& task) {
+  if (count == 0) {
+    return;
+  }
+  auto job = Job(task, count);
+  auto const queue = currentQueue();
+  push(queue, Range{&job, 0, count});
+
+  while (true) {
+    auto range = Range();
+    // Help with this or any other job until this one is done
+    if (job.remaining.load(std::memory_order_acquire) != 0 &&
+        (tryPop(queue, range) || trySteal(queue, range))) {
+      execute(queue, range);
+      continue;
+    }
+    // The last calls are running elsewhere, or there is work that was queued
+    // too late to be seen. Check again shortly.
+    auto lock = std::unique_lock(job.mutex);
+    if (job.finished.wait_for(lock, std::chrono::microseconds(100),
+                              [&] { return job.done; })) {
+      break;
+    }
+  }
+
+  if (job.exception != nullptr) {
+    std::rethrow_exception(job.exception);
+  }
+}
+
+WorkStealingPool& WorkStealingPool::global() {
+  static auto pool =
+      WorkStealingPool(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+  return pool;
+}
+
+void WorkStealingPool::Job::call(std::size_t index) noexcept {
+  if (!failed.load(std::memory_order_relaxed)) {
+    try {
+      task(index);
+    } catch (...) {
+      auto lock = std::lock_guard(mutex);
+      if (exception == nullptr) {
+        exception = std::current_exception();
+      }
+      failed.store(true, std::memory_order_relaxed);
+    }
+  }
+  if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    // Notify under the lock, run() destroys the job as soon as it sees done
+    auto lock = std::lock_guard(mutex);
+    done = true;
+    finished.notify_all();
+  }
+}
+
+void WorkStealingPool::work(std::size_t queue) {
+  currentPool = this;
+  currentPoolQueue = queue;
+  while (true) {
+    auto range = Range();
+    if (tryPop(queue, range) || trySteal(queue, range)) {
+      execute(queue, range);
+      continue;
+    }
+    auto lock = std::unique_lock(_sleepMutex);
+    _wakeup.wait(lock, [&] {
+      return _stopping || _queued.load(std::memory_order_acquire) > 0;
+    });
+    if (_stopping) {
+      return;
+    }
+  }
+}
+
+void WorkStealingPool::execute(std::size_t queue, Range range) {
+  while (range.end - range.begin > 1) {
+    auto const middle = range.begin + (range.end - range.begin) / 2;
+    push(queue, Range{range.job, middle, range.end});
+    range.end = middle;
+  }
+  range.job->call(range.begin);
+}
+
+void WorkStealingPool::push(std::size_t queue, Range range) {
+  {
+    auto lock = std::lock_guard(_queues[queue]->mutex);
+    _queues[queue]->ranges.push_back(range);
+    // Before the range can be popped, whose fetch_sub would wrap otherwise
+    _queued.fetch_add(1, std::memory_order_release);
+  }
+  if (!_threads.empty()) {
+    // Taking the lock makes sure a worker that is about to sleep sees the
+    // new range
+    { auto lock = std::lock_guard(_sleepMutex); }
+    _wakeup.notify_one();
+  }
+}
+
+bool WorkStealingPool::tryPop(std::size_t queue, Range& range) {
+  auto lock = std::lock_guard(_queues[queue]->mutex);
+  auto& ranges = _queues[queue]->ranges;
+  if (ranges.empty()) {
+    return false;
+  }
+  range = ranges.back();
+  ranges.pop_back();
+  _queued.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool WorkStealingPool::trySteal(std::size_t thief, Range& range) {
+  if (_queued.load(std::memory_order_acquire) == 0) {
+    return false;
+  }
+  for (std::size_t i = 1; i < _queues.size(); ++i) {
+    auto& victim = *_queues[(thief + i) % _queues.size()];
+    auto lock = std::lock_guard(victim.mutex);
+    if (!victim.ranges.empty()) {
+      range = victim.ranges.front();
+      victim.ranges.pop_front();
+      _queued.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+std::size_t WorkStealingPool::currentQueue() const noexcept {
+  return currentPool == this ? currentPoolQueue : _queues.size() - 1;
+}
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SRC_WORKSTEALINGPOOL_H
+#define SRC_WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace arangodb::velocypack {
+
+/**
+ * @brief A fixed set of worker threads, each with its own queue of index
+ *        ranges. A worker splits the range it is working on in halves,
+ *        queueing one half, until a single index is left; idle workers steal
+ *        the oldest, i.e. largest, ranges from the other queues.
+ *
+ *        Thread-safe. run() may be called from within a task.
+ */
+class WorkStealingPool {
+ public:
+  // threads may be 0, then run() does all the work on the calling thread
+  explicit WorkStealingPool(std::size_t threads);
+
+  WorkStealingPool(WorkStealingPool const&) = delete;
+  WorkStealingPool& operator=(WorkStealingPool const&) = delete;
+
+  // Must not be called while run() is
+  ~WorkStealingPool();
+
+  [[nodiscard]] std::size_t size() const noexcept { return _threads.size(); }
+
+  // Calls task(i) for every i in [0, count), spread over the workers and the
+  // calling thread, and returns when all calls are done. If a call throws,
+  // the calls that haven't started yet are skipped and the first exception
+  // is rethrown.
+  void run(std::size_t count, std::function<void(std::size_t)> const& task);
+
+  // A pool with one worker less than there are hardware threads, as the
+  // thread calling run() helps. Created on first use.
+  [[nodiscard]] static WorkStealingPool& global();
+
+ private:
+  struct Job {
+    explicit Job(std::function<void(std::size_t)> const& task,
+                 std::size_t count) noexcept
+        : task(task), remaining(count) {}
+
+    void call(std::size_t index) noexcept;
+
+    std::function<void(std::size_t)> const& task;
+    std::atomic<std::size_t> remaining;
+    std::atomic<bool> failed{false};
+    std::exception_ptr exception;
+    std::mutex mutex;
+    std::condition_variable finished;
+    // Set under mutex once remaining dropped to 0
+    bool done = false;
+  };
+
+  struct Range {
+    Job* job;
+    std::size_t begin;
+    std::size_t end;
+  };
+
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Range> ranges;
+  };
+
+  void work(std::size_t queue);
+  // Splits range down to its first index and calls that, queueing the rest
+  // on queue
+  void execute(std::size_t queue, Range range);
+  void push(std::size_t queue, Range range);
+  // Takes the newest range from queue
+  [[nodiscard]] bool tryPop(std::size_t queue, Range& range);
+  // Takes the oldest range from any other queue
+  [[nodiscard]] bool trySteal(std::size_t thief, Range& range);
+  // The queue of the calling thread: its own for workers, a shared one for
+  // all other threads
+  [[nodiscard]] std::size_t currentQueue() const noexcept;
+
+ private:
+  // One per worker, and the last one for threads outside of the pool
+  std::vector<std::unique_ptr<Queue>> _queues;
+  std::atomic<std::size_t> _queued{0};
+  std::mutex _sleepMutex;
+  std::condition_variable _wakeup;
+  bool _stopping = false;
+  std::vector<std::thread> _threads;
+};
+
+}  // namespace arangodb::velocypack
+
+#endif  // SRC_WORKSTEALINGPOOL_H
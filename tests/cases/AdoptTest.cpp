@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+Builder makeObject() {
+  Builder builder;
+  builder.openObject();
+  builder.add("foo", Value(42));
+  builder.add("bar", Value("baz"));
+  builder.close();
+  return builder;
+}
+
+// A network frame with a header in front of the VelocyPack payload
+struct Frame {
+  Frame(Slice payload, int& destroyed)
+      : bytes(headerSize + payload.byteSize()), destroyed(&destroyed) {
+    std::memcpy(bytes.data() + headerSize, payload.start(), payload.byteSize());
+  }
+  Frame(Frame&& other) noexcept
+      : bytes(std::move(other.bytes)),
+        destroyed(std::exchange(other.destroyed, nullptr)) {}
+  Frame& operator=(Frame&&) = delete;
+  ~Frame() {
+    if (destroyed != nullptr) {
+      ++*destroyed;
+    }
+  }
+
+  static constexpr std::size_t headerSize = 8;
+  std::vector<uint8_t> bytes;
+  int* destroyed;
+};
+}  // namespace
+
+template <typename T>
+class AdoptTest : public ::testing::Test {};
+
+using AdoptTypes = ::testing::Types<SharedSlice, IntrusiveSharedSlice,
+                                    LocalSharedSlice, ShardedSharedSlice>;
+TYPED_TEST_SUITE(AdoptTest, AdoptTypes);
+
+TYPED_TEST(AdoptTest, vector) {
+  auto const builder = makeObject();
+  auto bytes = std::vector<uint8_t>(builder.slice().start(),
+                                    builder.slice().start() +
+                                        builder.slice().byteSize());
+  auto const* data = bytes.data();
+
+  auto sharedSlice = TypeParam::adopt(std::move(bytes));
+  // Not copied
+  ASSERT_EQ(data, sharedSlice.slice().start());
+  ASSERT_EQ(1, sharedSlice.buffer().use_count());
+  ASSERT_EQ(42, sharedSlice.get("foo").getInt());
+  ASSERT_FALSE(sharedSlice.enableKeyIndex());
+}
+
+TYPED_TEST(AdoptTest, shortString) {
+  auto const value =
+      Slice(reinterpret_cast<uint8_t const*>("\x31"));  // SmallInt 1
+  auto bytes = std::string(reinterpret_cast<char const*>(value.start()),
+                           value.byteSize());
+
+  // The bytes are stored inside the string, and move with it
+  auto sharedSlice = TypeParam::adopt(std::move(bytes));
+  ASSERT_EQ(1, sharedSlice.getInt());
+}
+
+TYPED_TEST(AdoptTest, ownerLivesAsLongAsAliases) {
+  auto destroyed = 0;
+  auto frame = Frame(makeObject().slice(), destroyed);
+  auto const* payload = frame.bytes.data() + Frame::headerSize;
+
+  auto value = [&] {
+    auto sharedSlice =
+        TypeParam::adopt(std::move(frame), [](Frame const& adopted) {
+          return Slice(adopted.bytes.data() + Frame::headerSize);
+        });
+    EXPECT_EQ(payload, sharedSlice.slice().start());
+    return sharedSlice.get("bar");
+  }();
+  ASSERT_EQ(0, destroyed);
+  ASSERT_TRUE(value.isEqualString(std::string("baz")));
+
+  value = TypeParam();
+  ASSERT_EQ(1, destroyed);
+}
+
+TYPED_TEST(AdoptTest, sharedOwner) {
+  auto const builder = makeObject();
+  auto buffer = std::make_shared<std::string>(reinterpret_cast<char const*>(
+                                                  builder.slice().start()),
+                                              builder.slice().byteSize());
+  auto const* data = reinterpret_cast<uint8_t const*>(buffer->data());
+  auto observer = std::weak_ptr<std::string>(buffer);
+
+  auto sharedSlice =
+      TypeParam::adopt(std::move(buffer), [](auto const& adopted) {
+        return Slice(reinterpret_cast<uint8_t const*>(adopted->data()));
+      });
+  ASSERT_EQ(data, sharedSlice.slice().start());
+  ASSERT_FALSE(observer.expired());
+  sharedSlice = TypeParam();
+  ASSERT_TRUE(observer.expired());
+}
+
+TEST(AdoptTest, inlineCopiesSmallValues) {
+  auto destroyed = 0;
+  auto frame =
+      Frame(Slice(reinterpret_cast<uint8_t const*>("\x31")), destroyed);
+  auto sharedSlice =
+      InlineSharedSlice::adopt(std::move(frame), [](Frame const& adopted) {
+        return Slice(adopted.bytes.data() + Frame::headerSize);
+      });
+  ASSERT_EQ(1, destroyed);
+  ASSERT_EQ(1, sharedSlice.getInt());
+}
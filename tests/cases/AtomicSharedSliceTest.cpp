@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/AtomicSharedSlice.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+template <typename T>
+T makeVersion(int64_t version) {
+  Builder builder;
+  builder.openObject();
+  builder.add("version", Value(version));
+  builder.add("payload", Value("some configuration payload"));
+  builder.close();
+  return T::copyOf(builder.slice());
+}
+}  // namespace
+
+template <typename T>
+class AtomicSharedSliceTest : public ::testing::Test {};
+
+using AtomicSharedSliceTypes =
+    ::testing::Types<AtomicSharedSlice, IntrusiveAtomicSharedSlice>;
+TYPED_TEST_SUITE(AtomicSharedSliceTest, AtomicSharedSliceTypes);
+
+TYPED_TEST(AtomicSharedSliceTest, defaultIsNone) {
+  auto atomic = TypeParam();
+  ASSERT_TRUE(atomic.load().isNone());
+  ASSERT_TRUE(atomic.guard().slice().isNone());
+}
+
+TYPED_TEST(AtomicSharedSliceTest, storeAndLoad) {
+  using SharedSliceType = typename TypeParam::SharedSliceType;
+  auto first = makeVersion<SharedSliceType>(1);
+  auto atomic = TypeParam(first);
+  ASSERT_EQ(2, first.buffer().use_count());
+  ASSERT_EQ(first.slice().start(), atomic.load().slice().start());
+
+  atomic.store(makeVersion<SharedSliceType>(2));
+  // The replaced slice isn't guarded, so it has been released right away
+  ASSERT_EQ(1, first.buffer().use_count());
+  ASSERT_EQ(2, atomic.load().get("version").getInt());
+}
+
+TYPED_TEST(AtomicSharedSliceTest, guardDoesNotTouchRefCount) {
+  using SharedSliceType = typename TypeParam::SharedSliceType;
+  auto first = makeVersion<SharedSliceType>(1);
+  auto atomic = TypeParam(first);
+  {
+    auto guard = atomic.guard();
+    ASSERT_EQ(2, first.buffer().use_count());
+    ASSERT_EQ(1, guard->get("version").getInt());
+    ASSERT_EQ(first.slice().start(), guard.get().slice().start());
+  }
+  ASSERT_EQ(2, first.buffer().use_count());
+}
+
+TYPED_TEST(AtomicSharedSliceTest, guardDelaysReclamation) {
+  using SharedSliceType = typename TypeParam::SharedSliceType;
+  auto first = makeVersion<SharedSliceType>(1);
+  auto atomic = TypeParam(first);
+  {
+    auto guard = atomic.guard();
+    atomic.store(makeVersion<SharedSliceType>(2));
+    ASSERT_EQ(2, first.buffer().use_count());
+    ASSERT_EQ(1, guard->get("version").getInt());
+    ASSERT_EQ(2, atomic.load().get("version").getInt());
+
+    // Moving the guard keeps the protection
+    auto moved = std::move(guard);
+    atomic.store(makeVersion<SharedSliceType>(3));
+    ASSERT_EQ(2, first.buffer().use_count());
+    ASSERT_EQ(1, moved->get("version").getInt());
+  }
+  // Reclaimed by the next writer
+  atomic.store(makeVersion<SharedSliceType>(4));
+  ASSERT_EQ(1, first.buffer().use_count());
+}
+
+TYPED_TEST(AtomicSharedSliceTest, nestedGuards) {
+  using SharedSliceType = typename TypeParam::SharedSliceType;
+  auto atomic = TypeParam(makeVersion<SharedSliceType>(1));
+  auto outer = atomic.guard();
+  atomic.store(makeVersion<SharedSliceType>(2));
+  auto inner = atomic.guard();
+  atomic.store(makeVersion<SharedSliceType>(3));
+  ASSERT_EQ(1, outer->get("version").getInt());
+  ASSERT_EQ(2, inner->get("version").getInt());
+}
+
+TYPED_TEST(AtomicSharedSliceTest, exchange) {
+  using SharedSliceType = typename TypeParam::SharedSliceType;
+  auto atomic = TypeParam(makeVersion<SharedSliceType>(1));
+  auto previous = atomic.exchange(makeVersion<SharedSliceType>(2));
+  ASSERT_EQ(1, previous.get("version").getInt());
+  ASSERT_EQ(1, previous.buffer().use_count());
+  ASSERT_EQ(2, atomic.load().get("version").getInt());
+}
+
+TYPED_TEST(AtomicSharedSliceTest, compareExchange) {
+  using SharedSliceType = typename TypeParam::SharedSliceType;
+  auto atomic = TypeParam(makeVersion<SharedSliceType>(1));
+  auto expected = atomic.load();
+
+  ASSERT_TRUE(
+      atomic.compareExchange(expected, makeVersion<SharedSliceType>(2)));
+  ASSERT_EQ(1, expected.get("version").getInt());
+
+  // expected is stale now, and is updated to the current slice
+  ASSERT_FALSE(
+      atomic.compareExchange(expected, makeVersion<SharedSliceType>(3)));
+  ASSERT_EQ(2, expected.get("version").getInt());
+  ASSERT_EQ(2, atomic.load().get("version").getInt());
+
+  // An equal copy is a different slice
+  auto copy = makeVersion<SharedSliceType>(2);
+  ASSERT_FALSE(atomic.compareExchange(copy, makeVersion<SharedSliceType>(3)));
+
+  ASSERT_TRUE(
+      atomic.compareExchange(expected, makeVersion<SharedSliceType>(3)));
+  ASSERT_EQ(3, atomic.load().get("version").getInt());
+}
+
+TYPED_TEST(AtomicSharedSliceTest, concurrentReadersSeeMonotonicVersions) {
+  using SharedSliceType = typename TypeParam::SharedSliceType;
+  constexpr int64_t versions = 2000;
+  auto atomic = TypeParam(makeVersion<SharedSliceType>(0));
+  auto failures = std::atomic<int>(0);
+
+  auto readers = std::vector<std::thread>();
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&, i] {
+      auto last = int64_t{0};
+      while (last < versions) {
+        auto version = int64_t{0};
+        if (i % 2 == 0) {
+          auto guard = atomic.guard();
+          version = guard->get("version").getInt();
+          if (!guard->get("payload").isString()) {
+            ++failures;
+          }
+        } else {
+          version = atomic.load().get("version").getInt();
+        }
+        if (version < last) {
+          ++failures;
+        }
+        last = version;
+      }
+    });
+  }
+
+  // One writer storing, one incrementing via compareExchange
+  auto writer = std::thread([&] {
+    for (int64_t version = 1; version <= versions / 2; ++version) {
+      atomic.store(makeVersion<SharedSliceType>(2 * version - 1));
+      auto expected = atomic.load();
+      while (!atomic.compareExchange(
+          expected,
+          makeVersion<SharedSliceType>(expected.get("version").getInt() + 1))) {
+      }
+    }
+  });
+
+  writer.join();
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  ASSERT_EQ(0, failures.load());
+  ASSERT_EQ(versions, atomic.load().get("version").getInt());
+}
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/SharedIterator.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+
+#include <memory>
+#include <string>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+SharedSlice makeArray() {
+  Builder builder;
+  builder.openArray();
+  for (int i = 0; i < 10; ++i) {
+    builder.add(Value(i));
+  }
+  builder.close();
+  return SharedSlice(builder.buffer());
+}
+
+SharedSlice makeObject() {
+  Builder builder;
+  builder.openObject();
+  builder.add("foo", Value(42));
+  builder.add("bar", Value("baz"));
+  builder.close();
+  return SharedSlice(builder.buffer());
+}
+}  // namespace
+
+TEST(BorrowedIteratorTest, arrayIterationKeepsUseCount) {
+  auto sharedSlice = makeArray();
+  auto const useCount = sharedSlice.buffer().use_count();
+
+  auto it = ArrayIterator(sharedSlice.slice());
+  for (auto borrowed : BorrowedArrayIterator(sharedSlice)) {
+    ASSERT_EQ(useCount, sharedSlice.buffer().use_count());
+    ASSERT_TRUE(it.valid());
+    ASSERT_EQ((*it).start(), borrowed.slice().start());
+    ASSERT_EQ((*it).getInt(), borrowed->getInt());
+    it.next();
+  }
+  ASSERT_FALSE(it.valid());
+  ASSERT_EQ(useCount, sharedSlice.buffer().use_count());
+}
+
+TEST(BorrowedIteratorTest, arrayOwnTakesReference) {
+  auto sharedSlice = makeArray();
+  auto const useCount = sharedSlice.buffer().use_count();
+
+  auto it = BorrowedArrayIterator(sharedSlice);
+  it.forward(3);
+  ASSERT_EQ(3, it.index());
+  auto owned = it.value().own();
+  ASSERT_EQ(useCount + 1, sharedSlice.buffer().use_count());
+  ASSERT_EQ(3, owned.getInt());
+  ASSERT_FALSE(owned.buffer().owner_before(sharedSlice.buffer()));
+  ASSERT_FALSE(sharedSlice.buffer().owner_before(owned.buffer()));
+}
+
+TEST(BorrowedIteratorTest, objectIterationKeepsUseCount) {
+  auto sharedSlice = makeObject();
+  auto const useCount = sharedSlice.buffer().use_count();
+
+  auto it = ObjectIterator(sharedSlice.slice());
+  for (auto pair : BorrowedObjectIterator(sharedSlice)) {
+    ASSERT_EQ(useCount, sharedSlice.buffer().use_count());
+    ASSERT_TRUE(it.valid());
+    ASSERT_EQ(it.key().start(), pair.key.slice().start());
+    ASSERT_EQ(it.value().start(), pair.value.slice().start());
+    it.next();
+  }
+  ASSERT_FALSE(it.valid());
+
+  auto borrowed = BorrowedObjectIterator(sharedSlice);
+  auto key = borrowed.key().own();
+  ASSERT_EQ(useCount + 1, sharedSlice.buffer().use_count());
+  ASSERT_TRUE(key.isString());
+}
+
+TEST(BorrowedIteratorTest, localArrayIteration) {
+  Builder builder;
+  builder.openArray();
+  builder.add(Value(1));
+  builder.add(Value(2));
+  builder.close();
+  auto sharedSlice = LocalSharedSlice(builder.buffer());
+  ASSERT_EQ(1, sharedSlice.buffer().use_count());
+
+  int64_t sum = 0;
+  for (auto borrowed : LocalBorrowedArrayIterator(sharedSlice)) {
+    ASSERT_EQ(1, sharedSlice.buffer().use_count());
+    sum += borrowed->getInt();
+  }
+  ASSERT_EQ(3, sum);
+}
@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/CompiledPath.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Exception.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+Builder makeUser(std::string const& city) {
+  Builder builder;
+  builder.openObject();
+  builder.add("name", Value("someone"));
+  builder.add("user", Value(ValueType::Object));
+  builder.add("address", Value(ValueType::Object));
+  builder.add("city", Value(city));
+  builder.close();
+  builder.close();
+  builder.close();
+  return builder;
+}
+}  // namespace
+
+TEST(CompiledPathTest, matchesVectorGet) {
+  auto const builder = makeUser("Cologne");
+  auto const attributes = std::vector<std::string>{"user", "address", "city"};
+  auto const path = CompiledPath(attributes);
+  ASSERT_EQ(3, path.size());
+  ASSERT_EQ(builder.slice().get(attributes).start(),
+            path.get(builder.slice()).start());
+}
+
+TEST(CompiledPathTest, parse) {
+  auto const builder = makeUser("Cologne");
+  auto const path = CompiledPath::parse(StringRef("user.address.city"));
+  ASSERT_EQ(3, path.size());
+  ASSERT_TRUE(path.get(builder.slice()).isEqualString(std::string("Cologne")));
+}
+
+TEST(CompiledPathTest, missingAttributesYieldNone) {
+  auto const builder = makeUser("Cologne");
+  ASSERT_TRUE(CompiledPath::parse(StringRef("user.phone"))
+                  .get(builder.slice())
+                  .isNone());
+  ASSERT_TRUE(CompiledPath::parse(StringRef("name.first"))
+                  .get(builder.slice())
+                  .isNone());
+  ASSERT_TRUE(
+      CompiledPath::parse(StringRef("user")).get(Slice::nullSlice()).isNone());
+}
+
+TEST(CompiledPathTest, emptyPathThrows) {
+  ASSERT_THROW(CompiledPath(std::vector<std::string>{}), Exception);
+}
+
+TEST(CompiledPathTest, sharedSliceAliases) {
+  auto const path = CompiledPath::parse(StringRef("user.address.city"));
+  auto document = SharedSlice::copyOf(makeUser("Cologne").slice());
+
+  auto city = path.get(document);
+  ASSERT_TRUE(city.isEqualString(std::string("Cologne")));
+  ASSERT_EQ(2, document.buffer().use_count());
+
+  auto borrowed = path.borrow(document);
+  ASSERT_EQ(city.slice().start(), borrowed.slice().start());
+  ASSERT_EQ(2, document.buffer().use_count());
+}
+
+TEST(CompiledPathTest, usesKeyIndex) {
+  Builder builder;
+  builder.openObject(true);
+  for (int i = 0; i < 100; ++i) {
+    builder.add("key" + std::to_string(i), Value(ValueType::Object));
+    builder.add("value", Value(i));
+    builder.close();
+  }
+  builder.close();
+  auto document = SharedSlice::copyOf(builder.slice());
+  ASSERT_TRUE(document.enableKeyIndex());
+  ASSERT_EQ(
+      42, CompiledPath::parse(StringRef("key42.value")).get(document).getInt());
+}
+
+TEST(CompiledPathTest, batch) {
+  auto const path = CompiledPath::parse(StringRef("user.address.city"));
+  auto documents = std::vector<SharedSlice>();
+  for (auto const* city : {"Cologne", "Berlin", "Munich"}) {
+    documents.emplace_back(SharedSlice::copyOf(makeUser(city).slice()));
+  }
+  documents.emplace_back(SharedSlice::copyOf(Slice::emptyObjectSlice()));
+
+  auto results = std::vector<SharedSlice>(documents.size());
+  path.get(documents.data(), documents.size(), results.data());
+  ASSERT_TRUE(results[0].isEqualString(std::string("Cologne")));
+  ASSERT_TRUE(results[1].isEqualString(std::string("Berlin")));
+  ASSERT_TRUE(results[2].isEqualString(std::string("Munich")));
+  ASSERT_TRUE(results[3].isNone());
+}
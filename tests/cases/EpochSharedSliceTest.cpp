@@ -0,0 +1,193 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/AtomicSharedSlice.h"
+#include "velocypack/EpochPtr.h"
+#include "velocypack/SharedIterator.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Exception.h>
+#include <velocypack/Slice.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+SharedSlice makeObject(int64_t version = 0) {
+  Builder builder;
+  builder.openObject();
+  builder.add("version", Value(version));
+  builder.add("bar", Value("baz"));
+  builder.add("array", Value(ValueType::Array));
+  for (int64_t i = 0; i < 3; ++i) {
+    builder.add(Value(i));
+  }
+  builder.close();
+  builder.close();
+  return SharedSlice::copyOf(builder.slice());
+}
+
+EpochSharedSlice viewOf(SharedSlice const& slice) {
+  return EpochSharedSlice(EpochOwnership::fromShared(slice.buffer()));
+}
+}  // namespace
+
+TEST(EpochSharedSliceTest, defaultIsNone) {
+  auto sharedSlice = EpochSharedSlice();
+  ASSERT_TRUE(sharedSlice.isNone());
+  ASSERT_EQ(0, sharedSlice.buffer().use_count());
+  ASSERT_EQ(0, sharedSlice.pinnedBytes());
+}
+
+TEST(EpochSharedSliceTest, requiresGuard) {
+  ASSERT_FALSE(inEpoch());
+  ASSERT_THROW(std::ignore = EpochSharedSlice::copyOf(makeObject().slice()),
+               Exception);
+  ASSERT_THROW(std::ignore = viewOf(makeObject()), Exception);
+
+  EpochGuard guard;
+  ASSERT_TRUE(inEpoch());
+  {
+    EpochGuard nested;
+    ASSERT_TRUE(inEpoch());
+  }
+  ASSERT_TRUE(inEpoch());
+  ASSERT_NO_THROW(std::ignore = EpochSharedSlice::copyOf(makeObject().slice()));
+}
+
+TEST(EpochSharedSliceTest, copiesAndAliasesDontTouchRefCount) {
+  auto const object = makeObject();
+  {
+    EpochGuard guard;
+    auto view = viewOf(object);
+    // The retired owner holds one reference
+    ASSERT_EQ(2, object.buffer().use_count());
+    ASSERT_EQ(object.slice().start(), view.slice().start());
+
+    auto copy = view;
+    auto bar = view.get("bar");
+    auto element = view.get("array").at(1);
+    ASSERT_EQ(2, object.buffer().use_count());
+    ASSERT_TRUE(bar.isEqualString(std::string("baz")));
+    ASSERT_EQ(1, element.getInt());
+    ASSERT_EQ(2, copy.buffer().use_count());
+  }
+  reclaimEpochs();
+  ASSERT_EQ(1, object.buffer().use_count());
+}
+
+TEST(EpochSharedSliceTest, iterators) {
+  auto const object = makeObject();
+  EpochGuard guard;
+  auto const array = viewOf(object).get("array");
+  auto expected = int64_t{0};
+  for (auto it = EpochSharedArrayIterator(array); it.valid(); it.next()) {
+    ASSERT_EQ(expected++, it.value().getInt());
+  }
+  ASSERT_EQ(3, expected);
+
+  auto const view = viewOf(object);
+  auto keys = std::vector<std::string>();
+  for (auto pair : EpochBorrowedObjectIterator(view)) {
+    keys.emplace_back(pair.key->copyString());
+  }
+  std::sort(keys.begin(), keys.end());
+  ASSERT_EQ((std::vector<std::string>{"array", "bar", "version"}), keys);
+}
+
+TEST(EpochSharedSliceTest, shareOutlivesGuard) {
+  auto shared = SharedSlice();
+  {
+    EpochGuard guard;
+    shared = viewOf(makeObject()).get("bar").share();
+  }
+  reclaimEpochs();
+  ASSERT_EQ(1, shared.buffer().use_count());
+  ASSERT_TRUE(shared.isEqualString(std::string("baz")));
+}
+
+TEST(EpochSharedSliceTest, copyOfHasCaches) {
+  EpochGuard guard;
+  auto sharedSlice = EpochSharedSlice::copyOf(makeObject().slice());
+  ASSERT_TRUE(sharedSlice.enableKeyIndex());
+  ASSERT_EQ(sharedSlice.referencedBytes(), sharedSlice.pinnedBytes());
+  ASSERT_EQ(0, sharedSlice.get("version").getInt());
+}
+
+TEST(EpochAtomicSharedSliceTest, storeAndLoad) {
+  auto const first = makeObject(1);
+  auto atomic = EpochAtomicSharedSlice(first);
+  {
+    EpochGuard guard;
+    auto view = atomic.load(guard);
+    ASSERT_EQ(first.slice().start(), view.slice().start());
+
+    atomic.store(makeObject(2));
+    // Still guarded
+    reclaimEpochs();
+    ASSERT_EQ(2, first.buffer().use_count());
+    ASSERT_EQ(1, view.get("version").getInt());
+    ASSERT_EQ(2, atomic.load(guard).get("version").getInt());
+  }
+  reclaimEpochs();
+  ASSERT_EQ(1, first.buffer().use_count());
+}
+
+TEST(EpochAtomicSharedSliceTest, concurrentReadersSeeMonotonicVersions) {
+  constexpr int64_t versions = 2000;
+  auto atomic = EpochAtomicSharedSlice(makeObject(0));
+  auto failures = std::atomic<int>(0);
+
+  auto readers = std::vector<std::thread>();
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&] {
+      auto last = int64_t{0};
+      while (last < versions) {
+        EpochGuard guard;
+        auto const view = atomic.load(guard);
+        auto const version = view.get("version").getInt();
+        if (version < last || view.get("array").length() != 3) {
+          ++failures;
+        }
+        last = version;
+      }
+    });
+  }
+
+  for (int64_t version = 1; version <= versions; ++version) {
+    atomic.store(makeObject(version));
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  ASSERT_EQ(0, failures.load());
+}
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/AttributeSet.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Exception.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+Builder makeObject(bool unindexed) {
+  Builder builder;
+  builder.openObject(unindexed);
+  for (int i = 0; i < 50; ++i) {
+    builder.add("attribute" + std::to_string(i), Value(i));
+  }
+  builder.close();
+  return builder;
+}
+}  // namespace
+
+TEST(AttributeSetTest, find) {
+  auto const attributes = AttributeSet({"foo", "bar", "baz"});
+  ASSERT_EQ(3, attributes.size());
+  ASSERT_EQ(0, attributes.find("foo"));
+  ASSERT_EQ(1, attributes.find("bar"));
+  ASSERT_EQ(2, attributes.find("baz"));
+  ASSERT_EQ(AttributeSet::npos, attributes.find("qux"));
+  ASSERT_EQ(AttributeSet::npos, attributes.find(""));
+  ASSERT_EQ("bar", attributes[1]);
+}
+
+TEST(AttributeSetTest, duplicateNameThrows) {
+  ASSERT_THROW(AttributeSet({"foo", "bar", "foo"}), Exception);
+}
+
+TEST(AttributeSetTest, getManyMatchesGet) {
+  for (bool unindexed : {false, true}) {
+    auto const builder = makeObject(unindexed);
+    auto const names =
+        std::vector<std::string>{"attribute17", "attribute0", "missing",
+                                 "attribute49", "attribute3"};
+    auto const attributes = AttributeSet(names);
+    auto results = std::vector<Slice>(attributes.size());
+    attributes.getMany(builder.slice(), results.data());
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      auto const expected = builder.slice().get(names[i]);
+      ASSERT_EQ(expected.start(), results[i].start()) << names[i];
+    }
+    ASSERT_TRUE(results[2].isNone());
+  }
+}
+
+TEST(AttributeSetTest, firstDuplicateKeyWins) {
+  Builder builder;
+  builder.openObject(true);
+  builder.add("foo", Value(1));
+  builder.add("foo", Value(2));
+  builder.close();
+  auto const attributes = AttributeSet({"foo"});
+  auto result = Slice();
+  attributes.getMany(builder.slice(), &result);
+  ASSERT_EQ(1, result.getInt());
+}
+
+TEST(AttributeSetTest, emptyObject) {
+  Builder builder;
+  builder.openObject();
+  builder.close();
+  auto const attributes = AttributeSet({"foo", "bar"});
+  Slice results[2];
+  attributes.getMany(builder.slice(), results);
+  ASSERT_TRUE(results[0].isNone());
+  ASSERT_TRUE(results[1].isNone());
+}
+
+TEST(AttributeSetTest, sharedSliceGetMany) {
+  auto const sharedSlice = SharedSlice::copyOf(makeObject(false).slice());
+  auto const attributes =
+      AttributeSet({"attribute5", "missing", "attribute23"});
+  auto results = std::vector<SharedSlice>(attributes.size());
+  sharedSlice.getMany(attributes, results.data());
+  ASSERT_EQ(5, results[0].getInt());
+  ASSERT_TRUE(results[1].isNone());
+  ASSERT_EQ(23, results[2].getInt());
+  // Found values alias the object's buffer, the missing one owns nothing
+  ASSERT_EQ(3, sharedSlice.buffer().use_count());
+  ASSERT_EQ(0, results[1].buffer().use_count());
+}
@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/BufferCaches.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+Builder makeDocument(int size = 100) {
+  Builder builder;
+  builder.openObject();
+  for (int i = 0; i < size; ++i) {
+    builder.add("key" + std::to_string(i), Value(i));
+  }
+  builder.close();
+  return builder;
+}
+
+BufferCaches& cachesOf(SharedSlice const& sharedSlice) {
+  return SharedPtrOwnership::caches(sharedSlice.buffer())->get();
+}
+
+bool isCached(SharedSlice const& sharedSlice, BufferCaches::HashKind kind,
+              uint64_t seed = Slice::defaultSeed64) {
+  return cachesOf(sharedSlice)
+      .cachedHash(sharedSlice.slice(), kind, seed)
+      .has_value();
+}
+}  // namespace
+
+TEST(HashCacheTest, hashesMatchSlice) {
+  auto const builder = makeDocument();
+  auto const sharedSlice = SharedSlice::copyOf(builder.slice());
+  ASSERT_TRUE(sharedSlice.enableHashCache());
+  // Twice, computed and then cached
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_EQ(builder.slice().hash(), sharedSlice.hash());
+    ASSERT_EQ(builder.slice().hash(17), sharedSlice.hash(17));
+    ASSERT_EQ(builder.slice().hash32(), sharedSlice.hash32());
+    ASSERT_EQ(builder.slice().hashSlow(), sharedSlice.hashSlow());
+    ASSERT_EQ(builder.slice().normalizedHash(), sharedSlice.normalizedHash());
+    ASSERT_EQ(builder.slice().normalizedHash32(),
+              sharedSlice.normalizedHash32());
+  }
+}
+
+TEST(HashCacheTest, sharedByCopies) {
+  auto const sharedSlice = SharedSlice::copyOf(makeDocument().slice());
+  auto const copy = sharedSlice;
+  ASSERT_TRUE(sharedSlice.enableHashCache());
+  ASSERT_FALSE(isCached(copy, BufferCaches::HashKind::hash, 42));
+
+  auto const hash = copy.hash(42);
+  auto& caches = cachesOf(sharedSlice);
+  ASSERT_EQ(hash, caches.cachedHash(sharedSlice.slice(),
+                                    BufferCaches::HashKind::hash, 42));
+  // Other seeds and kinds are cached separately
+  ASSERT_FALSE(isCached(sharedSlice, BufferCaches::HashKind::hash, 43));
+  ASSERT_FALSE(
+      isCached(sharedSlice, BufferCaches::HashKind::normalizedHash, 42));
+}
+
+TEST(HashCacheTest, disabledByDefault) {
+  auto const sharedSlice = SharedSlice::copyOf(makeDocument().slice());
+  std::ignore = sharedSlice.hash();
+  ASSERT_FALSE(isCached(sharedSlice, BufferCaches::HashKind::hash));
+}
+
+TEST(HashCacheTest, nothingAllocatedUntilEnabled) {
+  auto const sharedSlice = SharedSlice::copyOf(makeDocument().slice());
+  auto const* caches = SharedPtrOwnership::caches(sharedSlice.buffer());
+  ASSERT_NE(nullptr, caches);
+  std::ignore = sharedSlice.hash();
+  std::ignore = sharedSlice.get("key1");
+  ASSERT_EQ(nullptr, caches->peek());
+
+  ASSERT_TRUE(sharedSlice.enableHashCache());
+  ASSERT_NE(nullptr, caches->peek());
+}
+
+TEST(HashCacheTest, smallValuesAreNotCached) {
+  auto const sharedSlice = SharedSlice::copyOf(makeDocument().slice());
+  ASSERT_TRUE(sharedSlice.enableHashCache());
+  auto const value = sharedSlice.get("key1");
+  ASSERT_EQ(value.slice().hash(), value.hash());
+  ASSERT_FALSE(isCached(value, BufferCaches::HashKind::hash));
+}
+
+TEST(HashCacheTest, wrappedBufferHasNoCaches) {
+  auto const builder = makeDocument();
+  auto const sharedSlice = SharedSlice(builder.buffer());
+  ASSERT_FALSE(sharedSlice.enableHashCache());
+  ASSERT_EQ(sharedSlice.slice().hash(), sharedSlice.hash());
+}
+
+TEST(HashCacheTest, concurrentHashing) {
+  auto const builder = makeDocument(1000);
+  auto const sharedSlice = SharedSlice::copyOf(builder.slice());
+  ASSERT_TRUE(sharedSlice.enableHashCache());
+  auto const expected = builder.slice().hash();
+
+  auto threads = std::vector<std::thread>();
+  auto results = std::vector<uint64_t>(8);
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back(
+        [&, i, copy = sharedSlice] { results[i] = copy.hash(); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto result : results) {
+    ASSERT_EQ(expected, result);
+  }
+}
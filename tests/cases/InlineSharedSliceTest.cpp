@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/InlinePtr.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <memory>
+#include <string>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+bool isInside(InlineSharedSlice const& sharedSlice) {
+  auto const* start = sharedSlice.slice().start();
+  auto const* handle = reinterpret_cast<uint8_t const*>(&sharedSlice);
+  return start >= handle && start < handle + sizeof(sharedSlice);
+}
+}  // namespace
+
+TEST(InlinePtrTest, inlineCopiesBytes) {
+  uint8_t const bytes[] = {1, 2, 3, 4};
+  auto ptr = InlinePtr<uint8_t const>::copyOf(bytes, sizeof(bytes));
+  ASSERT_TRUE(ptr.isInline());
+  ASSERT_EQ(0, ptr.use_count());
+
+  auto alias = InlinePtr<uint8_t const>(ptr, ptr.get() + 2);
+  ASSERT_TRUE(alias.isInline());
+  ASSERT_NE(ptr.get() + 2, alias.get());
+  ASSERT_EQ(3, *alias.get());
+
+  auto moved = InlinePtr<uint8_t const>(std::move(alias));
+  ASSERT_EQ(3, *moved.get());
+}
+
+TEST(InlinePtrTest, sharedBehavesLikeSharedPtr) {
+  auto shared = std::make_shared<uint8_t const>(42);
+  auto ptr = InlinePtr<uint8_t const>(shared);
+  ASSERT_FALSE(ptr.isInline());
+  ASSERT_EQ(2, ptr.use_count());
+  auto copy = ptr;
+  ASSERT_EQ(3, shared.use_count());
+  ASSERT_EQ(shared.get(), copy.get());
+}
+
+TEST(InlineSharedSliceTest, smallValuesAreInline) {
+  Builder builder;
+  builder.add(Value("short"));
+  auto sharedSlice = InlineSharedSlice::copyOf(builder.slice());
+  ASSERT_TRUE(sharedSlice.buffer().isInline());
+  ASSERT_TRUE(isInside(sharedSlice));
+  ASSERT_EQ(0, sharedSlice.buffer().use_count());
+  ASSERT_EQ(0, sharedSlice.pinnedBytes());
+  ASSERT_TRUE(sharedSlice.isEqualString(std::string("short")));
+
+  auto copy = sharedSlice;
+  ASSERT_TRUE(isInside(copy));
+  ASSERT_TRUE(copy.binaryEquals(builder.slice()));
+
+  auto moved = std::move(copy);
+  ASSERT_TRUE(isInside(moved));
+  ASSERT_TRUE(moved.binaryEquals(builder.slice()));
+}
+
+TEST(InlineSharedSliceTest, wrappedSmallValuesAreInline) {
+  Builder builder;
+  builder.add(Value(3.14));
+  auto sharedSlice = InlineSharedSlice(builder.buffer());
+  ASSERT_TRUE(sharedSlice.buffer().isInline());
+  ASSERT_EQ(3.14, sharedSlice.getDouble());
+}
+
+TEST(InlineSharedSliceTest, smallArraysAreInlineEitherWay) {
+  Builder builder;
+  builder.openArray();
+  builder.add(Value(1));
+  builder.add(Value(2));
+  builder.close();
+  auto const copied = InlineSharedSlice::copyOf(builder.slice());
+  auto const wrapped = InlineSharedSlice(builder.buffer());
+  ASSERT_TRUE(copied.buffer().isInline());
+  ASSERT_TRUE(wrapped.buffer().isInline());
+  ASSERT_EQ(copied.pinnedBytes(), wrapped.pinnedBytes());
+  ASSERT_EQ(2, wrapped.at(1).getInt());
+}
+
+TEST(InlineSharedSliceTest, largeValuesAreShared) {
+  Builder builder;
+  builder.add(Value(std::string(64, 'x')));
+  auto sharedSlice = InlineSharedSlice::copyOf(builder.slice());
+  ASSERT_FALSE(sharedSlice.buffer().isInline());
+  ASSERT_FALSE(isInside(sharedSlice));
+  ASSERT_EQ(1, sharedSlice.buffer().use_count());
+  ASSERT_TRUE(sharedSlice.binaryEquals(builder.slice()));
+}
+
+TEST(InlineSharedSliceTest, compactMakesAliasesInline) {
+  Builder builder;
+  builder.openObject();
+  builder.add("name", Value("tiny"));
+  builder.add("padding", Value(std::string(64, 'x')));
+  builder.close();
+  auto sharedSlice = InlineSharedSlice::copyOf(builder.slice());
+
+  auto name = sharedSlice.get("name");
+  ASSERT_FALSE(name.buffer().isInline());
+  ASSERT_EQ(2, sharedSlice.buffer().use_count());
+
+  auto compacted = name.compact();
+  ASSERT_TRUE(compacted.buffer().isInline());
+  ASSERT_TRUE(compacted.isEqualString(std::string("tiny")));
+}
+
+TEST(InlineSharedSliceTest, shareCopiesInlineValue) {
+  Builder builder;
+  builder.add(Value(42));
+  auto sharedSlice = InlineSharedSlice::copyOf(builder.slice());
+  auto shared = std::move(sharedSlice).share();
+  // NOLINTNEXTLINE(bugprone-use-after-move,hicpp-invalid-access-moved)
+  ASSERT_TRUE(sharedSlice.isNone());
+  ASSERT_EQ(1, shared.buffer().use_count());
+  ASSERT_EQ(42, shared.getInt());
+}
@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/IntrusivePtr.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+IntrusiveSharedSlice intrusiveCopyOf(Slice slice) {
+  auto buffer = allocateIntrusiveBuffer(slice.byteSize());
+  std::memcpy(buffer.get(), slice.start(), slice.byteSize());
+  return IntrusiveSharedSlice(IntrusivePtr<uint8_t const>(std::move(buffer)));
+}
+
+Builder makeObject() {
+  Builder builder;
+  builder.openObject();
+  builder.add("foo", Value(42));
+  builder.add("bar", Value("baz"));
+  builder.close();
+  return builder;
+}
+
+struct DestructionCounter {
+  explicit DestructionCounter(int& counter) : counter(counter) {}
+  ~DestructionCounter() { ++counter; }
+  int& counter;
+};
+}  // namespace
+
+TEST(IntrusivePtrTest, allocateIntrusiveBuffer) {
+  auto ptr = allocateIntrusiveBuffer(16);
+  ASSERT_NE(nullptr, ptr.get());
+  ASSERT_EQ(1, ptr.use_count());
+  {
+    auto copy = ptr;
+    ASSERT_EQ(2, ptr.use_count());
+    ASSERT_EQ(ptr, copy);
+  }
+  ASSERT_EQ(1, ptr.use_count());
+}
+
+TEST(IntrusivePtrTest, aliasingSharesOwnership) {
+  auto ptr = allocateIntrusiveBuffer(16);
+  auto alias = IntrusivePtr<uint8_t>(ptr, ptr.get() + 8);
+  ASSERT_EQ(ptr.get() + 8, alias.get());
+  ASSERT_EQ(2, ptr.use_count());
+  ASSERT_FALSE(ptr.owner_before(alias));
+  ASSERT_FALSE(alias.owner_before(ptr));
+
+  auto moved = IntrusivePtr<uint8_t const>(std::move(alias), ptr.get() + 4);
+  ASSERT_EQ(2, ptr.use_count());
+  // NOLINTNEXTLINE(bugprone-use-after-move,hicpp-invalid-access-moved)
+  ASSERT_EQ(nullptr, alias.get());
+  // NOLINTNEXTLINE(bugprone-use-after-move,hicpp-invalid-access-moved)
+  ASSERT_EQ(0, alias.use_count());
+}
+
+TEST(IntrusivePtrTest, emptyAliasOwnsNothing) {
+  auto alias = IntrusivePtr<uint8_t const>(IntrusivePtr<uint8_t const>(),
+                                           Slice::noneSliceData);
+  ASSERT_EQ(Slice::noneSliceData, alias.get());
+  ASSERT_EQ(0, alias.use_count());
+}
+
+TEST(IntrusivePtrTest, isOneWord) {
+  ASSERT_EQ(sizeof(void*), sizeof(IntrusivePtr<uint8_t const>));
+  ASSERT_EQ(sizeof(void*), sizeof(IntrusiveSharedSlice));
+  ASSERT_EQ(sizeof(void*), sizeof(LocalSharedSlice));
+}
+
+TEST(IntrusivePtrTest, aliasesFarIntoTheBuffer) {
+  constexpr std::size_t size = 1 << 20;
+  auto ptr = allocateIntrusiveBuffer(size);
+  std::memset(ptr.get(), 0, size);
+  auto const* end = ptr.get() + size;
+  // Too far behind the header, this needs a forward
+  auto alias = IntrusivePtr<uint8_t const>(ptr, end - 1);
+  ASSERT_EQ(end - 1, alias.get());
+  ASSERT_EQ(ptr.header(), alias.header());
+  ASSERT_FALSE(ptr.owner_before(alias));
+  ASSERT_FALSE(alias.owner_before(ptr));
+  // Near the forward's base, and back near the header
+  auto next = IntrusivePtr<uint8_t const>(alias, end - 100);
+  ASSERT_EQ(end - 100, next.get());
+  auto front = IntrusivePtr<uint8_t const>(std::move(next), ptr.get());
+  ASSERT_EQ(ptr.get(), front.get());
+  ASSERT_EQ(size, intrusiveBufferSize(front.header()));
+
+  ptr.reset();
+  ASSERT_EQ(0, alias.get()[0]);
+  ASSERT_EQ(0, front.get()[0]);
+}
+
+TEST(IntrusivePtrTest, aliasesIntoAWrappedBuffer) {
+  auto buffer = std::make_shared<std::vector<uint8_t>>(1 << 20, uint8_t{42});
+  auto const* data = buffer->data();
+  auto block = makeIntrusive<std::shared_ptr<std::vector<uint8_t>>>(buffer);
+  block.header()->base = data;
+  auto alias = IntrusivePtr<uint8_t const>(block, data + 1000);
+  ASSERT_EQ(data + 1000, alias.get());
+  ASSERT_EQ(block.header(), alias.header());
+  ASSERT_EQ(42, *alias);
+}
+
+TEST(IntrusivePtrTest, makeIntrusiveDestroysPayload) {
+  int destroyed = 0;
+  {
+    auto ptr = makeIntrusive<DestructionCounter>(destroyed);
+    auto copy = ptr;
+    ASSERT_EQ(2, ptr.use_count());
+    ptr.reset();
+    ASSERT_EQ(0, destroyed);
+  }
+  ASSERT_EQ(1, destroyed);
+}
+
+TEST(IntrusiveSharedSliceTest, defaultIsNone) {
+  auto sharedSlice = IntrusiveSharedSlice();
+  ASSERT_TRUE(sharedSlice.isNone());
+  ASSERT_EQ(0, sharedSlice.buffer().use_count());
+}
+
+TEST(IntrusiveSharedSliceTest, fromBuffer) {
+  auto builder = makeObject();
+  auto sharedSlice = IntrusiveSharedSlice(builder.buffer());
+  ASSERT_EQ(builder.slice().start(), sharedSlice.slice().start());
+  ASSERT_EQ(1, sharedSlice.buffer().use_count());
+  ASSERT_EQ(42, sharedSlice.get("foo").getInt());
+}
+
+TEST(IntrusiveSharedSliceTest, aliasesShareOwnership) {
+  auto builder = makeObject();
+  auto sharedSlice = intrusiveCopyOf(builder.slice());
+  ASSERT_EQ(1, sharedSlice.buffer().use_count());
+  ASSERT_TRUE(sharedSlice.binaryEquals(builder.slice()));
+
+  auto value = sharedSlice.get("bar");
+  ASSERT_TRUE(value.isEqualString(std::string("baz")));
+  ASSERT_EQ(2, sharedSlice.buffer().use_count());
+  ASSERT_FALSE(value.buffer().owner_before(sharedSlice.buffer()));
+  ASSERT_FALSE(sharedSlice.buffer().owner_before(value.buffer()));
+
+  ValueLength length;
+  auto string = value.getString(length);
+  ASSERT_EQ(3, sharedSlice.buffer().use_count());
+  ASSERT_EQ(0, std::memcmp("baz", string.get(), length));
+}
+
+TEST(IntrusiveSharedSliceTest, moveLeavesNone) {
+  auto sharedSliceRef = intrusiveCopyOf(makeObject().slice());
+  auto const origPointer = sharedSliceRef.buffer().get();
+
+  IntrusiveSharedSlice sharedSlice{std::move(sharedSliceRef)};
+
+  // NOLINTNEXTLINE(bugprone-use-after-move,hicpp-invalid-access-moved)
+  ASSERT_TRUE(sharedSliceRef.isNone());
+  ASSERT_EQ(1, sharedSlice.buffer().use_count());
+  ASSERT_EQ(origPointer, sharedSlice.buffer().get());
+}
+
+TEST(IntrusiveSharedSliceTest, copyOf) {
+  auto builder = makeObject();
+  auto sharedSlice = IntrusiveSharedSlice::copyOf(builder.slice());
+  ASSERT_TRUE(sharedSlice.binaryEquals(builder.slice()));
+  ASSERT_NE(builder.slice().start(), sharedSlice.slice().start());
+  ASSERT_EQ(1, sharedSlice.buffer().use_count());
+}
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/BufferCaches.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+Builder makeObject(bool unindexed, int size = 100) {
+  Builder builder;
+  builder.openObject(unindexed);
+  for (int i = 0; i < size; ++i) {
+    builder.add("key" + std::to_string(i), Value(i));
+  }
+  builder.add("nested", Value(ValueType::Object));
+  for (int i = 0; i < size; ++i) {
+    builder.add("inner" + std::to_string(i), Value(i));
+  }
+  builder.close();
+  builder.close();
+  return builder;
+}
+}  // namespace
+
+TEST(KeyIndexTest, indexMatchesSliceGet) {
+  for (bool unindexed : {false, true}) {
+    auto const builder = makeObject(unindexed);
+    auto const object = builder.slice();
+    auto index = KeyIndex::build(object);
+    ASSERT_NE(nullptr, index);
+    for (int i = 0; i < 100; ++i) {
+      auto const key = "key" + std::to_string(i);
+      ASSERT_EQ(object.get(key).start(),
+                index->get(object, StringRef(key)).start());
+    }
+    ASSERT_TRUE(index->get(object, StringRef("missing")).isNone());
+    ASSERT_TRUE(index->get(object, StringRef("inner0")).isNone());
+  }
+}
+
+TEST(KeyIndexTest, firstDuplicateWins) {
+  Builder builder;
+  builder.openObject(true);
+  builder.add("foo", Value(1));
+  builder.add("foo", Value(2));
+  builder.close();
+  auto index = KeyIndex::build(builder.slice());
+  ASSERT_NE(nullptr, index);
+  ASSERT_EQ(1, index->get(builder.slice(), StringRef("foo")).getInt());
+}
+
+TEST(SharedSliceKeyIndexTest, getAndHasKeyUseIndex) {
+  auto const builder = makeObject(true);
+  auto sharedSlice = SharedSlice::copyOf(builder.slice());
+  ASSERT_TRUE(sharedSlice.enableKeyIndex());
+
+  for (int i = 0; i < 100; ++i) {
+    auto const key = "key" + std::to_string(i);
+    ASSERT_EQ(i, sharedSlice.get(key).getInt());
+    ASSERT_TRUE(sharedSlice.hasKey(key));
+  }
+  ASSERT_TRUE(sharedSlice.get("missing").isNone());
+  ASSERT_FALSE(sharedSlice.hasKey("missing"));
+
+  // Aliases share the buffer's caches, nested objects get their own index
+  auto nested = sharedSlice.get("nested");
+  ASSERT_EQ(42, nested.get("inner42").getInt());
+  ASSERT_FALSE(nested.hasKey("key42"));
+}
+
+TEST(SharedSliceKeyIndexTest, intrusiveBuffers) {
+  auto const builder = makeObject(true);
+  auto sharedSlice = IntrusiveSharedSlice::copyOf(builder.slice());
+  ASSERT_TRUE(sharedSlice.enableKeyIndex());
+  ASSERT_EQ(7, sharedSlice.get("key7").getInt());
+}
+
+TEST(SharedSliceKeyIndexTest, wrappedBuffersHaveNoIndex) {
+  auto const builder = makeObject(true);
+  auto sharedSlice = SharedSlice(builder.buffer());
+  ASSERT_FALSE(sharedSlice.enableKeyIndex());
+  ASSERT_EQ(7, sharedSlice.get("key7").getInt());
+}
+
+TEST(SharedSliceKeyIndexTest, concurrentLookups) {
+  auto const builder = makeObject(true, 1000);
+  auto sharedSlice = SharedSlice::copyOf(builder.slice());
+  ASSERT_TRUE(sharedSlice.enableKeyIndex());
+
+  auto threads = std::vector<std::thread>();
+  auto failures = std::vector<int>(8, 0);
+  for (std::size_t t = 0; t < failures.size(); ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 1000; ++i) {
+        auto const key =
+            "key" + std::to_string((i + 100 * static_cast<int>(t)) % 1000);
+        if (sharedSlice.get(key).getInt() !=
+            (i + 100 * static_cast<int>(t)) % 1000) {
+          ++failures[t];
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto failed : failures) {
+    ASSERT_EQ(0, failed);
+  }
+}
@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/KeySearch.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+// Keys around the vector widths, and pairs sharing long prefixes
+std::vector<std::string> makeKeys() {
+  auto keys = std::vector<std::string>();
+  for (std::size_t length :
+       {0, 1, 14, 15, 16, 17, 30, 31, 32, 33, 100, 126, 127, 300}) {
+    keys.emplace_back(length, 'a');
+    if (length > 0) {
+      keys.emplace_back(std::string(length - 1, 'a') + 'b');
+    }
+  }
+  return keys;
+}
+
+Builder makeCompactObject(std::vector<std::string> const& keys) {
+  Builder builder;
+  builder.openObject(true);
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    builder.add(keys[i], Value(i));
+  }
+  builder.close();
+  return builder;
+}
+
+std::vector<KeySearchImplementation> supportedImplementations() {
+  auto result = std::vector<KeySearchImplementation>();
+  for (auto implementation :
+       {KeySearchImplementation::scalar, KeySearchImplementation::sse2,
+        KeySearchImplementation::avx2}) {
+    if (isSupported(implementation)) {
+      result.emplace_back(implementation);
+    }
+  }
+  return result;
+}
+}  // namespace
+
+TEST(KeySearchTest, bestIsSupported) {
+  ASSERT_TRUE(isSupported(KeySearchImplementation::scalar));
+  ASSERT_TRUE(isSupported(bestKeySearchImplementation()));
+}
+
+TEST(KeySearchTest, compactObjectsNeedLinearSearch) {
+  auto const keys = makeKeys();
+  ASSERT_TRUE(needsLinearKeySearch(makeCompactObject(keys).slice()));
+
+  Builder sorted;
+  sorted.openObject();
+  sorted.add("foo", Value(1));
+  sorted.add("bar", Value(2));
+  sorted.close();
+  ASSERT_FALSE(needsLinearKeySearch(sorted.slice()));
+}
+
+TEST(KeySearchTest, matchesSliceGet) {
+  auto const keys = makeKeys();
+  auto const builder = makeCompactObject(keys);
+  auto const object = builder.slice();
+  auto probes = keys;
+  probes.emplace_back("missing");
+  probes.emplace_back(15, 'b');
+  probes.emplace_back(40, 'a');
+
+  for (auto implementation : supportedImplementations()) {
+    for (auto const& probe : probes) {
+      auto const expected = object.get(probe);
+      auto const actual =
+          findKeyLinear(object, StringRef(probe), implementation);
+      ASSERT_EQ(expected.start(), actual.start())
+          << "length " << probe.size() << ", implementation "
+          << static_cast<int>(implementation);
+    }
+  }
+}
+
+TEST(KeySearchTest, keysAtTheEndOfTheObject) {
+  // The last keys are too close to the end for a full vector load
+  Builder builder;
+  builder.openObject(true);
+  builder.add("x", Value(1));
+  builder.add("y", Value(2));
+  builder.close();
+  for (auto implementation : supportedImplementations()) {
+    ASSERT_EQ(1, findKeyLinear(builder.slice(), "x", implementation).getInt());
+    ASSERT_EQ(2, findKeyLinear(builder.slice(), "y", implementation).getInt());
+    ASSERT_TRUE(findKeyLinear(builder.slice(), "z", implementation).isNone());
+  }
+}
+
+TEST(KeySearchTest, longKeysDontMatchShortStrings) {
+  // The lengths of these keys don't fit into a short string head, and
+  // 0x40 + 256 would wrap to the head of the empty key, 0x40 + 300 to the
+  // head of the 44 byte key.
+  Builder builder;
+  builder.openObject(true);
+  builder.add(std::string(44, 'a'), Value(1));
+  builder.add("", Value(2));
+  builder.close();
+  for (auto implementation : supportedImplementations()) {
+    for (std::size_t length : {127, 256, 300}) {
+      ASSERT_TRUE(findKeyLinear(builder.slice(), std::string(length, 'a'),
+                                implementation)
+                      .isNone())
+          << "length " << length << ", implementation "
+          << static_cast<int>(implementation);
+    }
+  }
+}
+
+TEST(KeySearchTest, longKeysAreFound) {
+  auto const keys =
+      std::vector<std::string>{"", std::string(127, 'a'), std::string(256, 'a'),
+                               std::string(300, 'a')};
+  auto const builder = makeCompactObject(keys);
+  for (auto implementation : supportedImplementations()) {
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      ASSERT_EQ(
+          i, findKeyLinear(builder.slice(), keys[i], implementation).getUInt())
+          << "length " << keys[i].size() << ", implementation "
+          << static_cast<int>(implementation);
+    }
+  }
+}
+
+TEST(KeySearchTest, firstDuplicateKeyWins) {
+  Builder builder;
+  builder.openObject(true);
+  builder.add("foo", Value(1));
+  builder.add("foo", Value(2));
+  builder.close();
+  for (auto implementation : supportedImplementations()) {
+    ASSERT_EQ(1,
+              findKeyLinear(builder.slice(), "foo", implementation).getInt());
+  }
+}
+
+TEST(KeySearchTest, sharedSliceGetUsesIt) {
+  auto const keys = makeKeys();
+  auto const sharedSlice = SharedSlice::copyOf(makeCompactObject(keys).slice());
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_EQ(i, sharedSlice.get(keys[i]).getUInt());
+    ASSERT_EQ(i, sharedSlice[keys[i]].getUInt());
+    ASSERT_EQ(i, sharedSlice[StringRef(keys[i])].getUInt());
+    ASSERT_TRUE(sharedSlice.hasKey(keys[i]));
+  }
+  ASSERT_FALSE(sharedSlice.hasKey("missing"));
+}
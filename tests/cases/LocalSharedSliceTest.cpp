@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/IntrusivePtr.h"
+#include "velocypack/SharedIterator.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <tuple>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+LocalSharedSlice localCopyOf(Slice slice) {
+  auto buffer =
+      allocateIntrusiveBuffer<detail::LocalRefCount>(slice.byteSize());
+  std::memcpy(buffer.get(), slice.start(), slice.byteSize());
+  return LocalSharedSlice(
+      LocalOwnership::pointer<uint8_t const>(std::move(buffer)));
+}
+
+Builder makeArray() {
+  Builder builder;
+  builder.openArray();
+  builder.add(Value(1));
+  builder.add(Value("two"));
+  builder.add(Value(3));
+  builder.close();
+  return builder;
+}
+
+Builder makeObject() {
+  Builder builder;
+  builder.openObject();
+  builder.add("foo", Value(42));
+  builder.add("bar", Value("baz"));
+  builder.close();
+  return builder;
+}
+}  // namespace
+
+TEST(LocalSharedSliceTest, copiesShareTheRefcount) {
+  auto sharedSlice = localCopyOf(makeObject().slice());
+  ASSERT_EQ(1, sharedSlice.buffer().use_count());
+  {
+    auto copy = sharedSlice;
+    auto alias = sharedSlice.get("foo");
+    ASSERT_EQ(3, sharedSlice.buffer().use_count());
+    ASSERT_EQ(42, alias.getInt());
+  }
+  ASSERT_EQ(1, sharedSlice.buffer().use_count());
+}
+
+TEST(LocalSharedSliceTest, arrayIterator) {
+  auto builder = makeArray();
+  auto sharedSlice = localCopyOf(builder.slice());
+  auto it = LocalSharedArrayIterator(sharedSlice);
+  ASSERT_EQ(2, sharedSlice.buffer().use_count());
+  ValueLength i = 0;
+  for (auto&& value : it) {
+    ASSERT_EQ(builder.slice().at(i).byteSize(), value.byteSize());
+    ASSERT_TRUE(value.binaryEquals(builder.slice().at(i)));
+    ++i;
+  }
+  ASSERT_EQ(3, i);
+  ASSERT_EQ(2, sharedSlice.buffer().use_count());
+}
+
+TEST(LocalSharedSliceTest, objectIterator) {
+  auto builder = makeObject();
+  auto sharedSlice = localCopyOf(builder.slice());
+  auto it = LocalSharedObjectIterator(sharedSlice);
+  ASSERT_TRUE(it.valid());
+  auto pair = *it;
+  ASSERT_EQ(4, sharedSlice.buffer().use_count());
+  ASSERT_TRUE(pair.key.isString());
+  ASSERT_TRUE(
+      pair.value.binaryEquals(builder.slice().get(pair.key.copyString())));
+}
+
+TEST(LocalSharedSliceTest, shareTransfersOwnership) {
+  auto builder = makeObject();
+  auto localSlice = localCopyOf(builder.slice());
+  auto const* origPointer = localSlice.slice().start();
+
+  SharedSlice sharedSlice = std::move(localSlice).share();
+
+  // NOLINTNEXTLINE(bugprone-use-after-move,hicpp-invalid-access-moved)
+  ASSERT_TRUE(localSlice.isNone());
+  ASSERT_EQ(origPointer, sharedSlice.slice().start());
+  ASSERT_EQ(1, sharedSlice.buffer().use_count());
+  ASSERT_TRUE(sharedSlice.binaryEquals(builder.slice()));
+}
+
+TEST(LocalSharedSliceTest, sharedSliceMayBeReleasedOnAnotherThread) {
+  auto localSlice = localCopyOf(makeObject().slice());
+  auto sharedSlice = std::move(localSlice).share();
+  auto weakPtr = std::weak_ptr<uint8_t const>(sharedSlice.buffer());
+
+  std::thread([sharedSlice = std::move(sharedSlice)]() mutable {
+    ASSERT_EQ(42, sharedSlice.get("foo").getInt());
+    sharedSlice = SharedSlice();
+  }).join();
+
+  ASSERT_TRUE(weakPtr.expired());
+}
+
+TEST(LocalSharedSliceTest, shareThrowsWhileStillReferenced) {
+  auto localSlice = localCopyOf(makeObject().slice());
+  auto alias = localSlice.get("bar");
+  ASSERT_EQ(2, localSlice.buffer().use_count());
+
+  ASSERT_THROW(std::ignore = std::move(localSlice).share(), Exception);
+
+  // Nothing changed
+  // NOLINTNEXTLINE(bugprone-use-after-move,hicpp-invalid-access-moved)
+  ASSERT_FALSE(localSlice.isNone());
+  ASSERT_EQ(2, localSlice.buffer().use_count());
+}
+
+TEST(LocalSharedSliceTest, shareNone) {
+  auto sharedSlice = LocalSharedSlice().share();
+  ASSERT_TRUE(sharedSlice.isNone());
+}
+
+TEST(IntrusiveSharedSliceTest, shareKeepsBufferAlive) {
+  auto builder = makeArray();
+  auto intrusiveSlice = IntrusiveSharedSlice(builder.buffer());
+  auto alias = intrusiveSlice.at(1);
+
+  auto sharedSlice = std::move(alias).share();
+  intrusiveSlice = IntrusiveSharedSlice();
+
+  ASSERT_TRUE(sharedSlice.binaryEquals(builder.slice().at(1)));
+}
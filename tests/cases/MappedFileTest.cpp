@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/MappedFile.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Exception.h>
+#include <velocypack/Slice.h>
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <tuple>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+class TemporaryFile {
+ public:
+  TemporaryFile() {
+    char name[] = "/tmp/MappedFileTest.XXXXXX";
+    int fd = ::mkstemp(name);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "mkstemp");
+    }
+    ::close(fd);
+    _path = name;
+  }
+  TemporaryFile(TemporaryFile const&) = delete;
+  TemporaryFile& operator=(TemporaryFile const&) = delete;
+  ~TemporaryFile() { ::unlink(_path.c_str()); }
+
+  void write(uint8_t const* data, std::size_t size) const {
+    auto stream = std::ofstream(_path, std::ios::binary | std::ios::trunc);
+    stream.write(reinterpret_cast<char const*>(data),
+                 static_cast<std::streamsize>(size));
+  }
+
+  [[nodiscard]] std::string const& path() const noexcept { return _path; }
+
+ private:
+  std::string _path;
+};
+
+Builder makeObject() {
+  Builder builder;
+  builder.openObject();
+  builder.add("foo", Value(42));
+  builder.add("bar", Value("baz"));
+  builder.close();
+  return builder;
+}
+}  // namespace
+
+TEST(MappedFileTest, mapsValue) {
+  auto const builder = makeObject();
+  auto const file = TemporaryFile();
+  file.write(builder.slice().start(), builder.slice().byteSize());
+
+  auto sharedSlice = mapFile(file.path());
+  ASSERT_TRUE(sharedSlice.binaryEquals(builder.slice()));
+  ASSERT_EQ(1, sharedSlice.buffer().use_count());
+
+  auto value = sharedSlice.get("bar");
+  sharedSlice = SharedSlice();
+  // The alias keeps the mapping alive
+  ASSERT_TRUE(value.isEqualString(std::string("baz")));
+}
+
+TEST(MappedFileTest, acceptsHints) {
+  auto const builder = makeObject();
+  auto const file = TemporaryFile();
+  file.write(builder.slice().start(), builder.slice().byteSize());
+
+  for (auto advice :
+       {MapFileOptions::Advice::Sequential, MapFileOptions::Advice::Random,
+        MapFileOptions::Advice::WillNeed}) {
+    auto options = MapFileOptions();
+    options.advice = advice;
+    options.hugePages = true;
+    auto sharedSlice = mapFile(file.path(), options);
+    ASSERT_TRUE(sharedSlice.binaryEquals(builder.slice()));
+  }
+}
+
+TEST(MappedFileTest, missingFileThrows) {
+  ASSERT_THROW(std::ignore = mapFile("/nonexistent/MappedFileTest"),
+               std::system_error);
+}
+
+TEST(MappedFileTest, truncatedFileThrows) {
+  auto const builder = makeObject();
+  auto const file = TemporaryFile();
+  file.write(builder.slice().start(), builder.slice().byteSize() - 1);
+  ASSERT_THROW(std::ignore = mapFile(file.path()), Exception);
+
+  file.write(builder.slice().start(), 0);
+  ASSERT_THROW(std::ignore = mapFile(file.path()), Exception);
+}
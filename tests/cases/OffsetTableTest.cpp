@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/BufferCaches.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Exception.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+#include <tuple>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+Builder makeCompactArray(int size) {
+  Builder builder;
+  builder.openArray(true);
+  for (int i = 0; i < size; ++i) {
+    // Mixed sizes, so elements can't be found by multiplying
+    if (i % 2 == 0) {
+      builder.add(Value(i));
+    } else {
+      builder.add(Value(std::string(i % 50, 'x')));
+    }
+  }
+  builder.close();
+  return builder;
+}
+
+Builder makeCompactObject(int size) {
+  Builder builder;
+  builder.openObject(true);
+  for (int i = 0; i < size; ++i) {
+    builder.add("key" + std::to_string(i), Value(std::string(i % 50, 'x')));
+  }
+  builder.close();
+  return builder;
+}
+}  // namespace
+
+TEST(OffsetTableTest, arrayMembers) {
+  auto const builder = makeCompactArray(1000);
+  auto const array = builder.slice();
+  for (ValueLength stride : {1, 3, 16, 5000}) {
+    auto const table = OffsetTable::build(array, stride);
+    ASSERT_NE(nullptr, table);
+    ASSERT_EQ(1000, table->length());
+    for (ValueLength i = 0; i < 1000; ++i) {
+      ASSERT_EQ(array.at(i).start(), table->member(array, i).start())
+          << stride << " " << i;
+    }
+    ASSERT_THROW(std::ignore = table->member(array, 1000), Exception);
+  }
+}
+
+TEST(OffsetTableTest, objectKeys) {
+  auto const builder = makeCompactObject(1000);
+  auto const object = builder.slice();
+  for (ValueLength stride : {1, 7}) {
+    auto const table = OffsetTable::build(object, stride);
+    ASSERT_NE(nullptr, table);
+    for (ValueLength i = 0; i < 1000; ++i) {
+      ASSERT_EQ(object.keyAt(i, false).start(),
+                table->member(object, i).start());
+    }
+  }
+}
+
+TEST(SharedSliceOffsetTableTest, arrayAccess) {
+  auto const builder = makeCompactArray(1000);
+  auto const sharedSlice = SharedSlice::copyOf(builder.slice());
+  ASSERT_TRUE(sharedSlice.enableOffsetTables(8));
+  for (ValueLength i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(sharedSlice.at(i).binaryEquals(builder.slice().at(i)));
+    ASSERT_TRUE(sharedSlice[i].binaryEquals(builder.slice().at(i)));
+  }
+  ASSERT_THROW(std::ignore = sharedSlice.at(1000), Exception);
+}
+
+TEST(SharedSliceOffsetTableTest, objectAccess) {
+  auto const builder = makeCompactObject(1000);
+  auto const sharedSlice = SharedSlice::copyOf(builder.slice());
+  ASSERT_TRUE(sharedSlice.enableOffsetTables());
+  auto const object = builder.slice();
+  for (ValueLength i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(sharedSlice.keyAt(i).binaryEquals(object.keyAt(i)));
+    ASSERT_TRUE(
+        sharedSlice.keyAt(i, false).binaryEquals(object.keyAt(i, false)));
+    ASSERT_TRUE(sharedSlice.valueAt(i).binaryEquals(object.valueAt(i)));
+    ASSERT_TRUE(sharedSlice.getNthValue(i).binaryEquals(object.getNthValue(i)));
+  }
+}
+
+TEST(SharedSliceOffsetTableTest, nestedArraysGetTheirOwnTable) {
+  Builder builder;
+  builder.openArray(true);
+  for (int i = 0; i < 20; ++i) {
+    builder.add(makeCompactArray(100 + i).slice());
+  }
+  builder.close();
+  auto const sharedSlice = SharedSlice::copyOf(builder.slice());
+  ASSERT_TRUE(sharedSlice.enableOffsetTables(4));
+  for (ValueLength i = 0; i < 20; ++i) {
+    auto const inner = sharedSlice.at(i);
+    ASSERT_EQ(100 + i, inner.length());
+    ASSERT_TRUE(inner.at(99).binaryEquals(builder.slice().at(i).at(99)));
+  }
+}
+
+TEST(SharedSliceOffsetTableTest, wrappedBufferHasNoCaches) {
+  auto builder = makeCompactArray(100);
+  auto const sharedSlice = SharedSlice(builder.buffer());
+  ASSERT_FALSE(sharedSlice.enableOffsetTables());
+  ASSERT_TRUE(sharedSlice.at(50).binaryEquals(builder.slice().at(50)));
+}
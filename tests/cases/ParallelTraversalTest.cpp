@@ -0,0 +1,200 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/ParallelTraversal.h"
+#include "velocypack/SharedSlice.h"
+#include "velocypack/WorkStealingPool.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+Builder makeArray(int64_t size, bool compact) {
+  Builder builder;
+  builder.openArray(compact);
+  for (int64_t i = 0; i < size; ++i) {
+    // Mixed sizes, so elements can't be found by multiplying
+    if (i % 3 == 0) {
+      builder.add(Value(i));
+    } else {
+      builder.add(Value(std::to_string(i)));
+    }
+  }
+  builder.close();
+  return builder;
+}
+
+int64_t valueOf(Slice slice) {
+  return slice.isString() ? std::stoll(slice.copyString()) : slice.getInt();
+}
+}  // namespace
+
+TEST(WorkStealingPoolTest, runsEveryIndexOnce) {
+  auto pool = WorkStealingPool(3);
+  auto calls = std::vector<std::atomic<int>>(1000);
+  pool.run(calls.size(), [&](std::size_t index) { ++calls[index]; });
+  for (auto& count : calls) {
+    ASSERT_EQ(1, count.load());
+  }
+}
+
+TEST(WorkStealingPoolTest, nestedRuns) {
+  auto pool = WorkStealingPool(3);
+  auto sum = std::atomic<std::size_t>(0);
+  pool.run(10, [&](std::size_t) {
+    pool.run(10, [&](std::size_t index) { sum += index; });
+  });
+  ASSERT_EQ(450, sum.load());
+}
+
+TEST(WorkStealingPoolTest, withoutWorkers) {
+  auto pool = WorkStealingPool(0);
+  auto sum = std::size_t{0};
+  pool.run(100, [&](std::size_t index) { sum += index; });
+  ASSERT_EQ(4950, sum);
+}
+
+TEST(WorkStealingPoolTest, rethrows) {
+  auto pool = WorkStealingPool(3);
+  ASSERT_THROW(pool.run(100,
+                        [](std::size_t index) {
+                          if (index == 42) {
+                            throw std::runtime_error("42");
+                          }
+                        }),
+               std::runtime_error);
+}
+
+TEST(ParallelTraversalTest, forEachVisitsEveryElement) {
+  auto pool = WorkStealingPool(3);
+  for (bool compact : {false, true}) {
+    auto const array = SharedSlice::copyOf(makeArray(10000, compact).slice());
+    auto visits = std::vector<std::atomic<int>>(10000);
+    parallelForEach(
+        array,
+        [&](ValueLength index, BorrowedSlice element) {
+          ASSERT_EQ(static_cast<int64_t>(index), valueOf(element.slice()));
+          ++visits[index];
+        },
+        ParallelOptions{100, &pool});
+    for (auto& count : visits) {
+      ASSERT_EQ(1, count.load());
+    }
+  }
+}
+
+TEST(ParallelTraversalTest, reduceKeepsOrder) {
+  auto pool = WorkStealingPool(3);
+  auto const array = SharedSlice::copyOf(makeArray(1000, false).slice());
+  // Concatenation is associative but not commutative
+  auto const result = parallelReduce(
+      array, std::string(),
+      [](ValueLength, BorrowedSlice element) {
+        return std::to_string(valueOf(element.slice())) + ",";
+      },
+      [](std::string left, std::string const& right) { return left + right; },
+      ParallelOptions{7, &pool});
+
+  auto expected = std::string();
+  for (int i = 0; i < 1000; ++i) {
+    expected += std::to_string(i) + ",";
+  }
+  ASSERT_EQ(expected, result);
+}
+
+TEST(ParallelTraversalTest, reduceSum) {
+  auto const array =
+      IntrusiveSharedSlice::copyOf(makeArray(100000, true).slice());
+  auto const sum = parallelReduce(
+      array, int64_t{0},
+      [](ValueLength, IntrusiveBorrowedSlice element) {
+        return valueOf(element.slice());
+      },
+      [](int64_t left, int64_t right) { return left + right; });
+  ASSERT_EQ(int64_t{99999} * 100000 / 2, sum);
+}
+
+TEST(ParallelTraversalTest, reduceBool) {
+  // The partials of neighbouring grains are written concurrently
+  auto const array =
+      IntrusiveSharedSlice::copyOf(makeArray(10000, true).slice());
+  auto options = ParallelOptions();
+  options.grainSize = 1;
+  auto const allSmall = parallelReduce(
+      array, true,
+      [](ValueLength, IntrusiveBorrowedSlice element) {
+        return valueOf(element.slice()) < 10000;
+      },
+      [](bool left, bool right) { return left && right; }, options);
+  ASSERT_TRUE(allSmall);
+}
+
+TEST(ParallelTraversalTest, emptyArray) {
+  Builder builder;
+  builder.openArray();
+  builder.close();
+  auto const array = SharedSlice::copyOf(builder.slice());
+  auto calls = std::atomic<int>(0);
+  parallelForEach(array, [&](ValueLength, BorrowedSlice) { ++calls; });
+  ASSERT_EQ(0, calls.load());
+}
+
+TEST(ParallelTraversalTest, ownedElementsOutliveTheArray) {
+  auto pool = WorkStealingPool(3);
+  auto owned = std::vector<SharedSlice>(100);
+  {
+    auto const array = SharedSlice::copyOf(makeArray(100, false).slice());
+    parallelForEach(
+        array,
+        [&](ValueLength index, BorrowedSlice element) {
+          owned[index] = element.own();
+        },
+        ParallelOptions{10, &pool});
+  }
+  for (int64_t i = 0; i < 100; ++i) {
+    ASSERT_EQ(i, valueOf(owned[i].slice()));
+  }
+}
+
+TEST(ParallelTraversalTest, rethrows) {
+  auto pool = WorkStealingPool(3);
+  auto const array = SharedSlice::copyOf(makeArray(1000, false).slice());
+  ASSERT_THROW(parallelForEach(
+                   array,
+                   [](ValueLength index, BorrowedSlice) {
+                     if (index == 500) {
+                       throw std::runtime_error("500");
+                     }
+                   },
+                   ParallelOptions{10, &pool}),
+               std::runtime_error);
+}
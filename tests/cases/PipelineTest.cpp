@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/Pipeline.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#if __cplusplus >= 202002L && __has_include(<ranges>)
+#include <ranges>
+#endif
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+// [{"id": 0, "even": true}, {"id": 1, "even": false}, ...]
+SharedSlice makeArray(int size) {
+  Builder builder;
+  builder.openArray();
+  for (int i = 0; i < size; ++i) {
+    builder.openObject();
+    builder.add("id", Value(i));
+    builder.add("even", Value(i % 2 == 0));
+    builder.close();
+  }
+  builder.close();
+  return SharedSlice::copyOf(builder.slice());
+}
+
+SharedSlice makeObject() {
+  Builder builder;
+  builder.openObject();
+  builder.add("a", Value(1));
+  builder.add("b", Value(2));
+  builder.add("c", Value(3));
+  builder.close();
+  return SharedSlice::copyOf(builder.slice());
+}
+
+bool isEven(BorrowedSlice element) { return element->get("even").isTrue(); }
+}  // namespace
+
+#if __cplusplus >= 202002L && __has_include(<ranges>)
+static_assert(std::ranges::input_range<pipeline::Elements<SharedPtrOwnership>>);
+#endif
+
+TEST(PipelineTest, filterTransformTake) {
+  auto const array = makeArray(100);
+  auto const ids = pipeline::elements(array) | pipeline::filter(isEven) |
+                   pipeline::transform([](BorrowedSlice element) {
+                     return element.borrow(element->get("id"));
+                   }) |
+                   pipeline::take(3) | pipeline::toVector();
+  ASSERT_EQ(3, ids.size());
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    ASSERT_EQ(static_cast<int64_t>(2 * i), ids[i].getInt());
+  }
+  // Only the collected values own a reference
+  ASSERT_EQ(4, array.buffer().use_count());
+}
+
+TEST(PipelineTest, isLazy) {
+  auto const array = makeArray(100);
+  int calls = 0;
+  auto const result = pipeline::elements(array) |
+                      pipeline::transform([&](BorrowedSlice element) {
+                        ++calls;
+                        return element->get("id").getInt();
+                      }) |
+                      pipeline::take(5) | pipeline::toVector();
+  ASSERT_EQ((std::vector<int64_t>{0, 1, 2, 3, 4}), result);
+  ASSERT_EQ(5, calls);
+}
+
+TEST(PipelineTest, dropAndEnumerate) {
+  auto const array = makeArray(10);
+  auto const result = pipeline::elements(array) | pipeline::drop(7) |
+                      pipeline::enumerate() | pipeline::toVector();
+  ASSERT_EQ(3, result.size());
+  for (std::size_t i = 0; i < result.size(); ++i) {
+    ASSERT_EQ(i, result[i].first);
+    ASSERT_EQ(static_cast<int64_t>(7 + i), result[i].second.get("id").getInt());
+  }
+  auto const empty =
+      pipeline::elements(array) | pipeline::drop(20) | pipeline::toVector();
+  ASSERT_TRUE(empty.empty());
+}
+
+TEST(PipelineTest, rangeFor) {
+  auto const array = makeArray(10);
+  int64_t sum = 0;
+  for (auto const& element :
+       pipeline::elements(array) | pipeline::filter(isEven)) {
+    sum += element->get("id").getInt();
+  }
+  ASSERT_EQ(20, sum);
+}
+
+TEST(PipelineTest, objectMembers) {
+  auto const object = makeObject();
+
+  auto keys = std::vector<std::string>();
+  for (auto const& key : pipeline::keys(object)) {
+    keys.emplace_back(key->copyString());
+  }
+  ASSERT_EQ((std::vector<std::string>{"a", "b", "c"}), keys);
+
+  auto const values =
+      pipeline::values(object) |
+      pipeline::transform([](BorrowedSlice value) { return value->getInt(); }) |
+      pipeline::toVector();
+  ASSERT_EQ((std::vector<int64_t>{1, 2, 3}), values);
+
+  auto const members =
+      pipeline::members(object) | pipeline::drop(1) | pipeline::toVector();
+  ASSERT_EQ(2, members.size());
+  ASSERT_TRUE(members[0].first.isEqualString(std::string("b")));
+  ASSERT_EQ(2, members[0].second.getInt());
+}
@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/RandomAccessArray.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Exception.h>
+#include <velocypack/Slice.h>
+
+#include <algorithm>
+#include <atomic>
+#ifdef SHARED_SLICE_PARALLEL_STL
+#include <execution>
+#endif
+#include <iterator>
+#include <numeric>
+#include <string>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+// Sorted, with elements of different sizes
+SharedSlice makeArray(int64_t size, bool compact) {
+  Builder builder;
+  builder.openArray(compact);
+  for (int64_t i = 0; i < size; ++i) {
+    builder.add(Value(i * 1000));
+  }
+  builder.close();
+  return SharedSlice::copyOf(builder.slice());
+}
+
+bool less(BorrowedSlice element, int64_t value) {
+  return element->getInt() < value;
+}
+}  // namespace
+
+// Algorithms dispatch on the category, so this must be random access
+static_assert(
+    std::is_same_v<
+        std::iterator_traits<RandomAccessArray::iterator>::iterator_category,
+        std::random_access_iterator_tag>);
+static_assert(std::is_same_v<RandomAccessArray::iterator::iterator_concept,
+                             std::random_access_iterator_tag>);
+#if __cpp_lib_ranges
+static_assert(std::random_access_iterator<RandomAccessArray::iterator>);
+#endif
+
+TEST(RandomAccessArrayTest, indexing) {
+  for (bool compact : {false, true}) {
+    auto const array = RandomAccessArray(makeArray(1000, compact));
+    ASSERT_EQ(1000, array.size());
+    for (ValueLength i = 0; i < array.size(); ++i) {
+      ASSERT_EQ(static_cast<int64_t>(i * 1000), array[i]->getInt());
+    }
+  }
+}
+
+TEST(RandomAccessArrayTest, iteratorArithmetic) {
+  auto const array = RandomAccessArray(makeArray(100, false));
+  auto it = array.begin();
+  ASSERT_EQ(100, array.end() - it);
+  it += 10;
+  ASSERT_EQ(10000, (*it)->getInt());
+  ASSERT_EQ(15000, it[5]->getInt());
+  ASSERT_EQ(9000, (*(it - 1))->getInt());
+  ASSERT_EQ(12000, (*(2 + it))->getInt());
+  ASSERT_EQ(10, it.index());
+  ASSERT_TRUE(array.begin() < it);
+  ASSERT_TRUE(it <= it);
+  ASSERT_TRUE(array.end() > it);
+  ASSERT_EQ(it, array.begin() + 10);
+  ASSERT_EQ(100, std::distance(array.begin(), array.end()));
+}
+
+TEST(RandomAccessArrayTest, lowerBound) {
+  for (bool compact : {false, true}) {
+    auto const array = RandomAccessArray(makeArray(1000, compact));
+    auto it = std::lower_bound(array.begin(), array.end(), 123456, less);
+    ASSERT_EQ(124, it.index());
+    ASSERT_EQ(124000, (*it)->getInt());
+    ASSERT_EQ(array.end(),
+              std::lower_bound(array.begin(), array.end(), 1000000, less));
+  }
+}
+
+TEST(RandomAccessArrayTest, accumulate) {
+  auto const array = RandomAccessArray(makeArray(100, true));
+  auto const sum = std::accumulate(array.begin(), array.end(), int64_t{0},
+                                   [](int64_t sum, BorrowedSlice element) {
+                                     return sum + element->getInt();
+                                   });
+  ASSERT_EQ(4950 * 1000, sum);
+}
+
+TEST(RandomAccessArrayTest, reverse) {
+  auto const array = RandomAccessArray(makeArray(10, false));
+  auto expected = int64_t{9000};
+  for (auto it = std::make_reverse_iterator(array.end());
+       it != std::make_reverse_iterator(array.begin()); ++it) {
+    ASSERT_EQ(expected, (*it)->getInt());
+    expected -= 1000;
+  }
+}
+
+#ifdef SHARED_SLICE_PARALLEL_STL
+TEST(RandomAccessArrayTest, parallelAlgorithms) {
+  auto const array = RandomAccessArray(makeArray(1000, true));
+  auto sum = std::atomic<int64_t>{0};
+  std::for_each(std::execution::par, array.begin(), array.end(),
+                [&](BorrowedSlice element) { sum += element->getInt(); });
+  ASSERT_EQ(int64_t{499500} * 1000, sum.load());
+
+  ASSERT_TRUE(std::is_sorted(std::execution::par, array.begin(), array.end(),
+                             [](BorrowedSlice left, BorrowedSlice right) {
+                               return left->getInt() < right->getInt();
+                             }));
+  ASSERT_EQ(500, std::count_if(std::execution::par, array.begin(), array.end(),
+                               [](BorrowedSlice element) {
+                                 return element->getInt() >= 500000;
+                               }));
+}
+#endif
+
+TEST(RandomAccessArrayTest, ownedElements) {
+  auto element = SharedSlice();
+  {
+    auto const array = RandomAccessArray(makeArray(10, false));
+    element = array[3].own();
+    ASSERT_EQ(2, array.array().buffer().use_count());
+  }
+  ASSERT_EQ(3000, element.getInt());
+}
+
+TEST(RandomAccessArrayTest, empty) {
+  auto const array = RandomAccessArray(makeArray(0, true));
+  ASSERT_TRUE(array.empty());
+  ASSERT_EQ(array.begin(), array.end());
+}
+
+TEST(RandomAccessArrayTest, notAnArray) {
+  Builder builder;
+  builder.add(Value(1));
+  ASSERT_THROW(RandomAccessArray(SharedSlice::copyOf(builder.slice())),
+               Exception);
+}
@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/RetainedSlice.h"
+#include "velocypack/SharedSlice.h"
+#include "velocypack/SharedSliceArena.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+// An object with a small string and a large padding value
+Builder makeResponse() {
+  Builder builder;
+  builder.openObject();
+  builder.add("name", Value("tiny"));
+  builder.add("padding", Value(std::string(64 * 1024, 'x')));
+  builder.close();
+  return builder;
+}
+
+struct StrictRetention {
+  static constexpr RetentionPolicy policy() noexcept {
+    auto policy = RetentionPolicy();
+    policy.maxWasteRatio = 1.0;
+    policy.minWastedBytes = 0;
+    return policy;
+  }
+};
+}  // namespace
+
+TEST(RetentionTest, pinnedBytesOfCopy) {
+  auto const builder = makeResponse();
+  auto sharedSlice = SharedSlice::copyOf(builder.slice());
+  ASSERT_EQ(builder.slice().byteSize(), sharedSlice.pinnedBytes());
+  ASSERT_EQ(builder.slice().byteSize(), sharedSlice.referencedBytes());
+
+  auto name = sharedSlice.get("name");
+  ASSERT_EQ(builder.slice().byteSize(), name.pinnedBytes());
+  ASSERT_EQ(1 + 4, name.referencedBytes());
+}
+
+TEST(RetentionTest, pinnedBytesOfIntrusiveCopy) {
+  auto const builder = makeResponse();
+  auto sharedSlice = IntrusiveSharedSlice::copyOf(builder.slice());
+  ASSERT_EQ(builder.slice().byteSize(), sharedSlice.get("name").pinnedBytes());
+
+  auto localSlice = LocalSharedSlice::copyOf(builder.slice());
+  ASSERT_EQ(builder.slice().byteSize(), localSlice.get("name").pinnedBytes());
+}
+
+TEST(RetentionTest, pinnedBytesOfArenaChunk) {
+  auto arena = SharedSliceArena(1024);
+  Builder small;
+  small.add(Value(42));
+  auto sharedSlice = arena.copyOf(small.slice());
+  ASSERT_EQ(1024, sharedSlice.pinnedBytes());
+}
+
+TEST(RetentionTest, pinnedBytesOfWrappedBufferIsUnknown) {
+  auto const builder = makeResponse();
+  auto sharedSlice = SharedSlice(builder.buffer());
+  ASSERT_FALSE(sharedSlice.pinnedBytes().has_value());
+  ASSERT_FALSE(
+      IntrusiveSharedSlice(builder.buffer()).pinnedBytes().has_value());
+}
+
+TEST(RetentionTest, noneOwnsNothing) {
+  ASSERT_EQ(0, SharedSlice().pinnedBytes());
+  ASSERT_EQ(0, IntrusiveSharedSlice().pinnedBytes());
+  ASSERT_EQ(0, LocalSharedSlice().pinnedBytes());
+  auto none = SharedSlice();
+  ASSERT_EQ(none.slice().start(), none.compact().slice().start());
+}
+
+TEST(RetentionTest, compactCopiesAlias) {
+  auto const builder = makeResponse();
+  auto name = SharedSlice(builder.buffer()).get("name");
+
+  auto compacted = name.compact();
+  ASSERT_TRUE(compacted.binaryEquals(name.slice()));
+  ASSERT_EQ(compacted.referencedBytes(), compacted.pinnedBytes());
+  ASSERT_EQ(1, compacted.buffer().use_count());
+
+  // Already right-sized
+  auto again = compacted.compact();
+  ASSERT_EQ(compacted.slice().start(), again.slice().start());
+}
+
+TEST(RetentionTest, retainCompactsWastefulSlices) {
+  auto const builder = makeResponse();
+  auto sharedSlice = SharedSlice::copyOf(builder.slice());
+
+  auto name = sharedSlice.get("name").retain();
+  ASSERT_EQ(name.referencedBytes(), name.pinnedBytes());
+  ASSERT_EQ(1, sharedSlice.buffer().use_count());
+
+  auto padding = sharedSlice.get("padding").retain();
+  // Pins hardly anything it doesn't reference
+  ASSERT_EQ(2, sharedSlice.buffer().use_count());
+  ASSERT_EQ(sharedSlice.pinnedBytes(), padding.pinnedBytes());
+
+  auto policy = RetentionPolicy();
+  policy.minWastedBytes = 1024 * 1024;
+  auto kept = sharedSlice.get("name").retain(policy);
+  ASSERT_EQ(sharedSlice.pinnedBytes(), kept.pinnedBytes());
+}
+
+TEST(RetentionTest, retainKeepsUnknownBuffers) {
+  auto const builder = makeResponse();
+  auto sharedSlice = SharedSlice(builder.buffer());
+  auto name = sharedSlice.get("name").retain();
+  ASSERT_FALSE(name.buffer().owner_before(sharedSlice.buffer()));
+  ASSERT_FALSE(sharedSlice.buffer().owner_before(name.buffer()));
+}
+
+TEST(RetentionTest, retainedSlicesRetainOnInsert) {
+  auto const builder = makeResponse();
+  auto sharedSlice = SharedSlice::copyOf(builder.slice());
+
+  auto names = std::vector<RetainedSlice>();
+  names.emplace_back(sharedSlice.get("name"));
+  names.push_back(sharedSlice.get("name"));
+  for (auto const& name : names) {
+    ASSERT_EQ(name->referencedBytes(), name->pinnedBytes());
+  }
+  ASSERT_EQ(1, sharedSlice.buffer().use_count());
+
+  auto padding = RetainedSlice();
+  padding = sharedSlice.get("padding");
+  ASSERT_EQ(2, sharedSlice.buffer().use_count());
+  SharedSlice const& held = padding;
+  ASSERT_TRUE(held.slice().isString());
+}
+
+TEST(RetentionTest, retainedSlicesUseTheirPolicy) {
+  auto const builder = makeResponse();
+  auto sharedSlice = SharedSlice::copyOf(builder.slice());
+
+  auto padding = BasicRetainedSlice<SharedPtrOwnership, StrictRetention>(
+      sharedSlice.get("padding"));
+  ASSERT_EQ(padding->referencedBytes(), padding->pinnedBytes());
+  ASSERT_EQ(sizeof(SharedSlice), sizeof(padding));
+}
@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/ShardedPtr.h"
+#include "velocypack/SharedIterator.h"
+#include "velocypack/SharedSlice.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+Builder makeObject() {
+  Builder builder;
+  builder.openObject();
+  builder.add("foo", Value(42));
+  builder.add("bar", Value("baz"));
+  builder.close();
+  return builder;
+}
+
+struct DestructionCounter {
+  explicit DestructionCounter(int& counter) : counter(counter) {}
+  ~DestructionCounter() { ++counter; }
+  int& counter;
+};
+}  // namespace
+
+TEST(ShardedPtrTest, allocateShardedBuffer) {
+  auto ptr = allocateShardedBuffer(16);
+  ASSERT_NE(nullptr, ptr.get());
+  ASSERT_EQ(1, ptr.use_count());
+  ASSERT_EQ(16, shardedBufferSize(ptr.header()));
+  {
+    auto copy = ptr;
+    ASSERT_EQ(2, ptr.use_count());
+    ASSERT_EQ(ptr, copy);
+  }
+  ASSERT_EQ(1, ptr.use_count());
+}
+
+TEST(ShardedPtrTest, aliasingSharesOwnership) {
+  auto ptr = allocateShardedBuffer(16);
+  auto alias = ShardedPtr<uint8_t>(ptr, ptr.get() + 8);
+  ASSERT_EQ(ptr.get() + 8, alias.get());
+  ASSERT_EQ(2, ptr.use_count());
+  ASSERT_FALSE(ptr.owner_before(alias));
+  ASSERT_FALSE(alias.owner_before(ptr));
+
+  auto moved = ShardedPtr<uint8_t const>(std::move(alias), ptr.get() + 4);
+  ASSERT_EQ(2, ptr.use_count());
+  // NOLINTNEXTLINE(bugprone-use-after-move,hicpp-invalid-access-moved)
+  ASSERT_EQ(nullptr, alias.get());
+  // NOLINTNEXTLINE(bugprone-use-after-move,hicpp-invalid-access-moved)
+  ASSERT_EQ(0, alias.use_count());
+}
+
+TEST(ShardedPtrTest, makeShardedDestroysPayload) {
+  int destroyed = 0;
+  {
+    auto ptr = makeSharded<DestructionCounter>(destroyed);
+    auto copy = ptr;
+    ASSERT_EQ(2, ptr.use_count());
+    ptr.reset();
+    ASSERT_EQ(0, destroyed);
+  }
+  ASSERT_EQ(1, destroyed);
+}
+
+TEST(ShardedPtrTest, copiesReleasedOnOtherThreads) {
+  int destroyed = 0;
+  auto ptr = makeSharded<DestructionCounter>(destroyed);
+  auto copies = std::vector<ShardedPtr<DestructionCounter>>(8);
+
+  auto threads = std::vector<std::thread>();
+  for (std::size_t i = 0; i < copies.size(); ++i) {
+    threads.emplace_back([&, i] {
+      for (int j = 0; j < 1000; ++j) {
+        auto copy = ptr;
+        auto alias = ShardedPtr<int>(copy, &copy->counter);
+      }
+      copies[i] = ptr;
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(9, ptr.use_count());
+  ptr.reset();
+
+  // Release the copies made by the other threads from yet other threads
+  threads.clear();
+  for (std::size_t i = 0; i < copies.size(); i += 2) {
+    threads.emplace_back(
+        [copy = std::move(copies[i])]() mutable { copy.reset(); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(0, destroyed);
+  copies.clear();
+  ASSERT_EQ(1, destroyed);
+}
+
+TEST(ShardedSharedSliceTest, defaultIsNone) {
+  auto sharedSlice = ShardedSharedSlice();
+  ASSERT_TRUE(sharedSlice.isNone());
+  ASSERT_EQ(0, sharedSlice.buffer().use_count());
+  ASSERT_EQ(0, sharedSlice.pinnedBytes());
+}
+
+TEST(ShardedSharedSliceTest, fromBuffer) {
+  auto builder = makeObject();
+  auto sharedSlice = ShardedSharedSlice(builder.buffer());
+  ASSERT_EQ(builder.slice().start(), sharedSlice.slice().start());
+  ASSERT_EQ(1, sharedSlice.buffer().use_count());
+  ASSERT_EQ(42, sharedSlice.get("foo").getInt());
+}
+
+TEST(ShardedSharedSliceTest, aliasesShareOwnership) {
+  auto builder = makeObject();
+  auto sharedSlice = ShardedSharedSlice::copyOf(builder.slice());
+  ASSERT_EQ(1, sharedSlice.buffer().use_count());
+  ASSERT_TRUE(sharedSlice.binaryEquals(builder.slice()));
+  ASSERT_EQ(builder.slice().byteSize(), sharedSlice.pinnedBytes());
+  ASSERT_TRUE(sharedSlice.enableKeyIndex());
+
+  auto value = sharedSlice.get("bar");
+  ASSERT_TRUE(value.isEqualString(std::string("baz")));
+  ASSERT_EQ(2, sharedSlice.buffer().use_count());
+
+  ValueLength length;
+  auto string = value.getString(length);
+  ASSERT_EQ(3, sharedSlice.buffer().use_count());
+  ASSERT_EQ(0, std::memcmp("baz", string.get(), length));
+}
+
+TEST(ShardedSharedSliceTest, moveLeavesNone) {
+  auto sharedSliceRef = ShardedSharedSlice::copyOf(makeObject().slice());
+  auto const origPointer = sharedSliceRef.buffer().get();
+
+  ShardedSharedSlice sharedSlice{std::move(sharedSliceRef)};
+
+  // NOLINTNEXTLINE(bugprone-use-after-move,hicpp-invalid-access-moved)
+  ASSERT_TRUE(sharedSliceRef.isNone());
+  ASSERT_EQ(1, sharedSlice.buffer().use_count());
+  ASSERT_EQ(origPointer, sharedSlice.buffer().get());
+}
+
+TEST(ShardedSharedSliceTest, share) {
+  auto sharedSlice = ShardedSharedSlice::copyOf(makeObject().slice());
+  auto value = sharedSlice.get("bar");
+  auto shared = std::move(value).share();
+  ASSERT_EQ(2, sharedSlice.buffer().use_count());
+  sharedSlice = ShardedSharedSlice();
+  ASSERT_TRUE(shared.isEqualString(std::string("baz")));
+}
+
+TEST(ShardedSharedSliceTest, iterators) {
+  auto sharedSlice = ShardedSharedSlice::copyOf(makeObject().slice());
+  auto count = 0;
+  for (auto it = ShardedSharedObjectIterator(sharedSlice); it.valid();
+       it.next()) {
+    ASSERT_TRUE(it.key().isString());
+    ++count;
+  }
+  ASSERT_EQ(2, count);
+  ASSERT_EQ(1, sharedSlice.buffer().use_count());
+}
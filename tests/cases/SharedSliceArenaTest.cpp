@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/SharedSliceArena.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+Builder makeDocument(int i) {
+  Builder builder;
+  builder.openObject();
+  builder.add("value", Value(i));
+  builder.close();
+  return builder;
+}
+
+// Big enough to be indexed and have its hash cached
+Builder makeBigDocument(int i) {
+  Builder builder;
+  builder.openObject();
+  for (int k = 0; k < 32; ++k) {
+    builder.add("key" + std::to_string(k), Value(i + k));
+  }
+  builder.close();
+  return builder;
+}
+}  // namespace
+
+TEST(SharedSliceArenaTest, documentsShareChunk) {
+  auto arena = SharedSliceArena(1024);
+  auto first = arena.copyOf(makeDocument(1).slice());
+  auto second = arena.copyOf(makeDocument(2).slice());
+
+  ASSERT_EQ(1, first.get("value").getInt());
+  ASSERT_EQ(2, second.get("value").getInt());
+  ASSERT_EQ(first.slice().start() + first.byteSize(), second.slice().start());
+  // arena, first and second
+  ASSERT_EQ(3, first.buffer().use_count());
+  ASSERT_FALSE(first.buffer().owner_before(second.buffer()));
+  ASSERT_FALSE(second.buffer().owner_before(first.buffer()));
+}
+
+TEST(SharedSliceArenaTest, chunkOutlivesArena) {
+  auto weakChunk = std::weak_ptr<uint8_t const>();
+  auto sharedSlice = SharedSlice();
+  {
+    auto arena = SharedSliceArena(1024);
+    sharedSlice = arena.copyOf(makeDocument(42).slice());
+    weakChunk = sharedSlice.buffer();
+  }
+  ASSERT_EQ(1, weakChunk.use_count());
+  ASSERT_EQ(42, sharedSlice.get("value").getInt());
+
+  auto alias = sharedSlice.get("value");
+  sharedSlice = SharedSlice();
+  ASSERT_EQ(1, weakChunk.use_count());
+  alias = SharedSlice();
+  ASSERT_TRUE(weakChunk.expired());
+}
+
+TEST(SharedSliceArenaTest, fullChunkStartsNewOne) {
+  auto const document = makeDocument(1);
+  auto const size = static_cast<std::size_t>(document.slice().byteSize());
+  auto arena = SharedSliceArena(4 * size);
+
+  auto slices = std::vector<SharedSlice>();
+  for (int i = 0; i < 5; ++i) {
+    slices.emplace_back(arena.copyOf(document.slice()));
+  }
+  ASSERT_FALSE(slices[0].buffer().owner_before(slices[3].buffer()) ||
+               slices[3].buffer().owner_before(slices[0].buffer()));
+  ASSERT_TRUE(slices[0].buffer().owner_before(slices[4].buffer()) ||
+              slices[4].buffer().owner_before(slices[0].buffer()));
+  for (auto const& slice : slices) {
+    ASSERT_TRUE(slice.binaryEquals(document.slice()));
+  }
+}
+
+TEST(SharedSliceArenaTest, fullChunkIsNotOverwritten) {
+  auto const document = makeDocument(1);
+  auto const size = static_cast<std::size_t>(document.slice().byteSize());
+  auto arena = SharedSliceArena(4 * size);
+
+  auto first = arena.copyOf(document.slice());
+  auto const* chunkStart = first.slice().start();
+  auto weakChunk = std::weak_ptr<uint8_t const>(first.buffer());
+  for (int i = 0; i < 3; ++i) {
+    std::ignore = arena.copyOf(document.slice());
+  }
+  first = SharedSlice();
+
+  // Only the arena and weakChunk reference the full chunk now. It must not
+  // be overwritten, as weakChunk could be locked at any time.
+  ASSERT_FALSE(weakChunk.expired());
+  auto next = arena.copyOf(makeDocument(2).slice());
+  ASSERT_NE(chunkStart, next.slice().start());
+  ASSERT_EQ(2, next.get("value").getInt());
+  ASSERT_TRUE(weakChunk.expired());
+}
+
+TEST(SharedSliceArenaTest, cachesStayValidAcrossChunks) {
+  auto arena = SharedSliceArena(4096);
+  // Every chunk is freed as soon as the arena moves on, so later chunks are
+  // likely allocated at the addresses of earlier ones
+  for (int i = 0; i < 1000; ++i) {
+    auto const document = makeBigDocument(i);
+    auto const sharedSlice = arena.copyOf(document.slice());
+    ASSERT_TRUE(sharedSlice.enableKeyIndex());
+    ASSERT_TRUE(sharedSlice.enableHashCache());
+    ASSERT_EQ(document.slice().hash(), sharedSlice.hash());
+    ASSERT_EQ(i + 17, sharedSlice.get("key17").getInt());
+  }
+}
+
+TEST(SharedSliceArenaTest, largeValuesGetOwnAllocation) {
+  Builder builder;
+  builder.add(Value(std::string(1024, 'x')));
+  auto arena = SharedSliceArena(1024);
+  auto sharedSlice = arena.copyOf(builder.slice());
+  ASSERT_TRUE(sharedSlice.binaryEquals(builder.slice()));
+  ASSERT_EQ(1, sharedSlice.buffer().use_count());
+}
@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/SharedSlice.h"
+#include "velocypack/SharedSliceArena.h"
+#include "velocypack/SharedSliceInterner.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+SharedSlice makeDocument(int value) {
+  Builder builder;
+  builder.openObject();
+  builder.add("value", Value(value));
+  builder.add("padding", Value(std::string(100, 'x')));
+  builder.close();
+  return SharedSlice::copyOf(builder.slice());
+}
+}  // namespace
+
+TEST(SharedSliceInternerTest, duplicatesShareOneBuffer) {
+  auto interner = SharedSliceInterner();
+  auto const first = interner.intern(makeDocument(1));
+  auto const duplicate = makeDocument(1);
+  auto const second = interner.intern(duplicate);
+
+  ASSERT_EQ(first.buffer().get(), second.buffer().get());
+  ASSERT_NE(duplicate.buffer().get(), second.buffer().get());
+
+  auto const stats = interner.stats();
+  ASSERT_EQ(2, stats.lookups);
+  ASSERT_EQ(1, stats.hits);
+  ASSERT_EQ(duplicate.byteSize(), stats.bytesSaved);
+  ASSERT_EQ(1, stats.entries);
+  ASSERT_DOUBLE_EQ(0.5, stats.dedupRatio());
+}
+
+TEST(SharedSliceInternerTest, distinctValuesStayDistinct) {
+  auto interner = SharedSliceInterner();
+  auto const one = interner.intern(makeDocument(1));
+  auto const two = interner.intern(makeDocument(2));
+  ASSERT_NE(one.buffer().get(), two.buffer().get());
+  ASSERT_EQ(0, interner.stats().hits);
+  ASSERT_EQ(2, interner.stats().entries);
+}
+
+TEST(SharedSliceInternerTest, entriesAreWeak) {
+  auto interner = SharedSliceInterner();
+  auto interned = interner.intern(makeDocument(1));
+  ASSERT_EQ(1, interned.buffer().use_count());
+
+  interned = SharedSlice();
+  ASSERT_EQ(0, interner.stats().entries);
+
+  // Interning again after the value is gone is a miss
+  std::ignore = interner.intern(makeDocument(1));
+  ASSERT_EQ(0, interner.stats().hits);
+}
+
+TEST(SharedSliceInternerTest, sharedBuffersAreCopied) {
+  auto interner = SharedSliceInterner();
+  auto arena = SharedSliceArena();
+  auto const value = arena.copyOf(makeDocument(1).slice());
+  auto interned = interner.intern(value);
+  ASSERT_TRUE(interned.binaryEquals(value.slice()));
+  ASSERT_NE(value.slice().start(), interned.slice().start());
+  ASSERT_EQ(interned.byteSize(), interned.pinnedBytes());
+
+  // Expires with the copy, although the arena still holds the chunk
+  interned = SharedSlice();
+  ASSERT_EQ(0, interner.stats().entries);
+}
+
+TEST(SharedSliceInternerTest, noneIsNotInterned) {
+  auto interner = SharedSliceInterner();
+  ASSERT_TRUE(interner.intern(SharedSlice()).isNone());
+  ASSERT_EQ(0, interner.stats().entries);
+}
+
+TEST(SharedSliceInternerTest, deadEntriesAreRemovedImmediately) {
+  auto interner = SharedSliceInterner();
+  for (int i = 0; i < 10000; ++i) {
+    std::ignore = interner.intern(makeDocument(i));
+    ASSERT_EQ(0, interner.stats().entries);
+  }
+}
+
+TEST(SharedSliceInternerTest, valuesMayOutliveTheInterner) {
+  auto interned = SharedSlice();
+  {
+    auto interner = SharedSliceInterner();
+    interned = interner.intern(makeDocument(1));
+  }
+  ASSERT_TRUE(interned.binaryEquals(makeDocument(1).slice()));
+}
+
+TEST(SharedSliceInternerTest, concurrentInterning) {
+  auto interner = SharedSliceInterner();
+  auto threads = std::vector<std::thread>();
+  auto results = std::vector<std::vector<SharedSlice>>(4);
+  for (std::size_t t = 0; t < results.size(); ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 100; ++i) {
+        results[t].emplace_back(interner.intern(makeDocument(i)));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (std::size_t t = 1; t < results.size(); ++t) {
+    for (int i = 0; i < 100; ++i) {
+      ASSERT_EQ(results[0][i].buffer().get(), results[t][i].buffer().get());
+    }
+  }
+  ASSERT_EQ(300, interner.stats().hits);
+}
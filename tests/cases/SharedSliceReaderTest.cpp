@@ -0,0 +1,224 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/SharedSliceReader.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Exception.h>
+#include <velocypack/Slice.h>
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+// A pipe with everything written to it already. Must stay below the pipe
+// capacity.
+class Pipe {
+ public:
+  explicit Pipe(std::vector<Builder> const& values) {
+    if (::pipe(_fds) != 0) {
+      throw std::system_error(errno, std::generic_category(), "pipe");
+    }
+    for (auto const& value : values) {
+      auto const slice = value.slice();
+      std::ignore = ::write(_fds[1], slice.start(), slice.byteSize());
+    }
+    ::close(_fds[1]);
+  }
+  explicit Pipe(std::vector<uint8_t> const& bytes) {
+    if (::pipe(_fds) != 0) {
+      throw std::system_error(errno, std::generic_category(), "pipe");
+    }
+    std::ignore = ::write(_fds[1], bytes.data(), bytes.size());
+    ::close(_fds[1]);
+  }
+  Pipe(Pipe const&) = delete;
+  Pipe& operator=(Pipe const&) = delete;
+  ~Pipe() { ::close(_fds[0]); }
+
+  [[nodiscard]] int fd() const noexcept { return _fds[0]; }
+
+ private:
+  int _fds[2]{};
+};
+
+std::vector<Builder> makeValues() {
+  auto values = std::vector<Builder>();
+  for (int i = 0; i < 100; ++i) {
+    Builder builder;
+    builder.openObject();
+    builder.add("value", Value(i));
+    builder.add("name", Value(std::string(static_cast<std::size_t>(i), 'x')));
+    builder.close();
+    values.emplace_back(std::move(builder));
+
+    Builder compact;
+    compact.openArray(true);
+    compact.add(Value(i));
+    compact.close();
+    values.emplace_back(std::move(compact));
+  }
+  return values;
+}
+
+// One custom type value per head with a byte length, i.e. 1, 2, 4 and 8
+// length bytes, each with a payload of 3 bytes. Returns the start of each.
+std::vector<std::size_t> appendCustomValues(std::vector<uint8_t>& bytes) {
+  auto starts = std::vector<std::size_t>();
+  for (unsigned head = 0xf4; head <= 0xff; ++head) {
+    starts.emplace_back(bytes.size());
+    bytes.emplace_back(static_cast<uint8_t>(head));
+    auto const lengthBytes = std::size_t{1} << ((head - 0xf4) / 3);
+    // little endian
+    bytes.emplace_back(3);
+    bytes.insert(bytes.end(), lengthBytes - 1, 0);
+    bytes.insert(bytes.end(), {0xaa, 0xbb, 0xcc});
+  }
+  return starts;
+}
+}  // namespace
+
+class SharedSliceReaderChunkTest
+    : public ::testing::TestWithParam<std::size_t> {};
+
+TEST_P(SharedSliceReaderChunkTest, readsAllValues) {
+  auto const values = makeValues();
+  auto const pipe = Pipe(values);
+  auto reader = SharedSliceReader(pipe.fd(), GetParam());
+
+  auto slices = std::vector<SharedSlice>();
+  while (auto slice = reader.next()) {
+    slices.emplace_back(std::move(*slice));
+  }
+  ASSERT_EQ(values.size(), slices.size());
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    ASSERT_TRUE(slices[i].binaryEquals(values[i].slice())) << i;
+  }
+}
+
+TEST_P(SharedSliceReaderChunkTest, readsCustomTypes) {
+  // The last value ends exactly at the end of the stream
+  auto bytes = std::vector<uint8_t>();
+  auto const starts = appendCustomValues(bytes);
+  auto const pipe = Pipe(bytes);
+  auto reader = SharedSliceReader(pipe.fd(), GetParam());
+
+  for (auto start : starts) {
+    auto const expected = Slice(bytes.data() + start);
+    auto const value = reader.next();
+    ASSERT_TRUE(value.has_value()) << "head " << static_cast<int>(bytes[start]);
+    ASSERT_EQ(expected.byteSize(), value->byteSize());
+    ASSERT_TRUE(value->binaryEquals(expected));
+  }
+  ASSERT_FALSE(reader.next().has_value());
+}
+
+INSTANTIATE_TEST_CASE_P(SharedSliceReaderChunkSizes, SharedSliceReaderChunkTest,
+                        ::testing::Values(1, 7, 64,
+                                          SharedSliceReader::defaultChunkSize));
+
+TEST(SharedSliceReaderTest, valuesAliasTheChunk) {
+  auto const values = makeValues();
+  auto const pipe = Pipe(values);
+  auto reader = SharedSliceReader(pipe.fd());
+
+  auto first = *reader.next();
+  auto second = *reader.next();
+  ASSERT_EQ(first.slice().start() + first.byteSize(), second.slice().start());
+  ASSERT_FALSE(first.buffer().owner_before(second.buffer()));
+  ASSERT_FALSE(second.buffer().owner_before(first.buffer()));
+}
+
+TEST(SharedSliceReaderTest, releasedChunkIsNotOverwritten) {
+  auto const values = makeValues();
+  auto const pipe = Pipe(values);
+  auto const size = static_cast<std::size_t>(values[0].slice().byteSize());
+  auto reader = SharedSliceReader(pipe.fd(), size);
+
+  auto first = *reader.next();
+  auto weakChunk = std::weak_ptr<uint8_t const>(first.buffer());
+  first = SharedSlice();
+  // Only the reader and weakChunk reference the first chunk now. It must not
+  // be overwritten, as weakChunk could be locked at any time.
+  auto second = *reader.next();
+  ASSERT_TRUE(second.binaryEquals(values[1].slice()));
+  ASSERT_TRUE(weakChunk.expired());
+}
+
+TEST(SharedSliceReaderTest, releasedChunksAreReused) {
+  // Custom type values of 5 bytes each, two per chunk
+  auto bytes = std::vector<uint8_t>();
+  for (uint8_t i = 0; i < 8; ++i) {
+    bytes.insert(bytes.end(), {0xf4, 3, i, i, i});
+  }
+  auto const pipe = Pipe(bytes);
+  auto reader = SharedSliceReader(pipe.fd(), 10);
+
+  auto first = *reader.next();
+  auto const* firstChunk = first.slice().start();
+  first = SharedSlice();
+  std::ignore = *reader.next();
+  auto third = *reader.next();
+  ASSERT_NE(firstChunk, third.slice().start());
+  std::ignore = *reader.next();
+  // The first chunk was released when the reader moved to the second one
+  auto fifth = *reader.next();
+  ASSERT_EQ(firstChunk, fifth.slice().start());
+  ASSERT_TRUE(fifth.binaryEquals(Slice(bytes.data() + 4 * 5)));
+  // The second chunk is still referenced by third
+  std::ignore = *reader.next();
+  auto seventh = *reader.next();
+  ASSERT_NE(third.slice().start(), seventh.slice().start());
+  ASSERT_TRUE(third.binaryEquals(Slice(bytes.data() + 2 * 5)));
+}
+
+TEST(SharedSliceReaderTest, truncatedStreamThrows) {
+  auto values = std::vector<Builder>();
+  values.emplace_back(makeValues()[0]);
+  int fds[2];
+  ASSERT_EQ(0, ::pipe(fds));
+  auto const slice = values[0].slice();
+  ASSERT_EQ(static_cast<ssize_t>(slice.byteSize() - 1),
+            ::write(fds[1], slice.start(), slice.byteSize() - 1));
+  ::close(fds[1]);
+
+  auto reader = SharedSliceReader(fds[0]);
+  ASSERT_THROW(std::ignore = reader.next(), Exception);
+  ::close(fds[0]);
+}
+
+TEST(SharedSliceReaderTest, emptyStream) {
+  auto const pipe = Pipe(std::vector<Builder>());
+  auto reader = SharedSliceReader(pipe.fd());
+  ASSERT_FALSE(reader.next().has_value());
+}
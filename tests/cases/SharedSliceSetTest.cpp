@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2020 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Tobias Gödderz
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "velocypack/SharedSlice.h"
+#include "velocypack/SharedSliceHash.h"
+#include "velocypack/SharedSliceSet.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+#include <tuple>
+#include <unordered_set>
+
+using namespace arangodb;
+using namespace arangodb::velocypack;
+
+namespace {
+SharedSlice makeString(std::string const& value) {
+  Builder builder;
+  builder.add(Value(value));
+  return SharedSlice::copyOf(builder.slice());
+}
+
+template <typename T>
+SharedSlice makeValue(T value) {
+  Builder builder;
+  builder.add(Value(value));
+  return SharedSlice::copyOf(builder.slice());
+}
+}  // namespace
+
+TEST(SharedSliceHashTest, worksWithStandardContainers) {
+  auto set =
+      std::unordered_set<SharedSlice, SharedSliceHash, SharedSliceEqual>();
+  ASSERT_TRUE(set.insert(makeString("foo")).second);
+  ASSERT_FALSE(set.insert(makeString("foo")).second);
+  ASSERT_TRUE(set.insert(makeString("bar")).second);
+  ASSERT_EQ(2, set.size());
+}
+
+TEST(SharedSliceHashTest, slicesAndSharedSlicesAgree) {
+  auto const sharedSlice = makeString("foo");
+  ASSERT_EQ(SharedSliceHash{}(sharedSlice.slice()),
+            SharedSliceHash{}(sharedSlice));
+  ASSERT_TRUE(SharedSliceEqual{}(sharedSlice, sharedSlice.slice()));
+  ASSERT_TRUE(SharedSliceEqual{}(sharedSlice.slice(), makeString("foo")));
+  ASSERT_FALSE(SharedSliceEqual{}(sharedSlice, makeString("bar")));
+  ASSERT_EQ(SharedSliceNormalizedHash{}(sharedSlice.slice()),
+            SharedSliceNormalizedHash{}(sharedSlice));
+}
+
+TEST(SharedSliceHashTest, normalizedIgnoresNumberType) {
+  auto const small = makeValue(1);
+  auto const dbl = makeValue(1.0);
+  ASSERT_FALSE(SharedSliceEqual{}(small, dbl));
+  ASSERT_TRUE(SharedSliceNormalizedEqual{}(small, dbl));
+  ASSERT_EQ(SharedSliceNormalizedHash{}(small),
+            SharedSliceNormalizedHash{}(dbl));
+}
+
+TEST(SharedSliceSetTest, insertFindErase) {
+  auto set = SharedSliceSet<>();
+  ASSERT_TRUE(set.empty());
+  ASSERT_TRUE(set.insert(makeString("foo")));
+  ASSERT_FALSE(set.insert(makeString("foo")));
+  ASSERT_EQ(1, set.size());
+
+  auto const probe = makeString("foo");
+  auto const* found = set.find(probe.slice());
+  ASSERT_NE(nullptr, found);
+  ASSERT_TRUE(found->isEqualString(std::string("foo")));
+  ASSERT_TRUE(set.contains(probe));
+  ASSERT_FALSE(set.contains(makeString("bar").slice()));
+
+  ASSERT_TRUE(set.erase(probe.slice()));
+  ASSERT_FALSE(set.erase(probe.slice()));
+  ASSERT_TRUE(set.empty());
+}
+
+TEST(SharedSliceSetTest, manyKeys) {
+  auto set = SharedSliceSet<>();
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(set.insert(makeString(std::to_string(i))));
+  }
+  ASSERT_EQ(1000, set.size());
+  // Erase every other key, the rest must stay reachable
+  for (int i = 0; i < 1000; i += 2) {
+    ASSERT_TRUE(set.erase(makeString(std::to_string(i))));
+  }
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(i % 2 == 1, set.contains(makeString(std::to_string(i)))) << i;
+  }
+  std::size_t count = 0;
+  set.forEach([&](SharedSlice const& key) {
+    ASSERT_TRUE(key.isString());
+    ++count;
+  });
+  ASSERT_EQ(500, count);
+}
+
+TEST(SharedSliceSetTest, erasingReleasesKeys) {
+  auto set = SharedSliceSet<>();
+  auto const key = makeString("foo");
+  set.insert(key);
+  ASSERT_EQ(2, key.buffer().use_count());
+  set.erase(key);
+  ASSERT_EQ(1, key.buffer().use_count());
+  set.insert(key);
+  set.clear();
+  ASSERT_EQ(1, key.buffer().use_count());
+}
+
+TEST(SharedSliceSetTest, normalized) {
+  auto set =
+      SharedSliceSet<SharedSliceNormalizedHash, SharedSliceNormalizedEqual>();
+  ASSERT_TRUE(set.insert(makeValue(1)));
+  ASSERT_FALSE(set.insert(makeValue(1.0)));
+  ASSERT_EQ(1, set.size());
+}
+
+TEST(SharedSliceMapTest, tryEmplaceAndFind) {
+  auto map = SharedSliceMap<int>();
+  auto [value, inserted] = map.tryEmplace(makeString("foo"), 1);
+  ASSERT_TRUE(inserted);
+  ASSERT_EQ(1, *value);
+  std::tie(value, inserted) = map.tryEmplace(makeString("foo"), 2);
+  ASSERT_FALSE(inserted);
+  ASSERT_EQ(1, *value);
+
+  map[makeString("bar")] += 5;
+  map[makeString("bar")] += 5;
+  ASSERT_EQ(10, *map.find(makeString("bar").slice()));
+  ASSERT_EQ(nullptr, map.find(makeString("baz").slice()));
+  ASSERT_EQ(2, map.size());
+
+  int sum = 0;
+  map.forEach([&](SharedSlice const&, int& entry) { sum += entry; });
+  ASSERT_EQ(11, sum);
+}
@@ -28,6 +28,7 @@
 #include <velocypack/Slice.h>
 
 #include <memory>
+#include <tuple>
 #include <variant>
 
 using namespace arangodb;
@@ -1114,6 +1115,14 @@ bool haveSameOwnership(SharedSlice const& leftSlice, SharedSlice const& rightSli
 }
 }
 
+TEST(SharedSliceRefcountTest, defaultConstructor) {
+  SharedSlice sharedSlice;
+  ASSERT_TRUE(sharedSlice.isNone());
+  // None must not share a refcount with anything, not even other Nones
+  ASSERT_EQ(0, sharedSlice.buffer().use_count());
+  ASSERT_EQ(0, SharedSlice().buffer().use_count());
+}
+
 TEST(SharedSliceRefcountTest, copyConstructor) {
   forAllTestCases([&](SharedSlice&& sharedSliceRef) {
     // We assume to be the only owner of the referenced buffer
@@ -1165,8 +1174,10 @@ TEST(SharedSliceRefcountTest, moveConstructor) {
     // Execute move constructor
     SharedSlice sharedSlice{std::move(sharedSliceRef)};
 
-    // The passed slice should now point to a valid None slice
-    ASSERT_LE(1, sharedSliceRef.buffer().use_count()); // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+    // The passed slice should now point to a valid None slice, which owns
+    // nothing
+    // NOLINTNEXTLINE(bugprone-use-after-move,hicpp-invalid-access-moved)
+    ASSERT_EQ(0, sharedSliceRef.buffer().use_count());
     ASSERT_TRUE(sharedSliceRef.isNone());
     // The underlying buffers should be different
     ASSERT_NE(sharedSliceRef.buffer(), sharedSlice.buffer());
@@ -1193,8 +1204,10 @@ TEST(SharedSliceRefcountTest, moveAssignment) {
     // Execute move assignment
     sharedSlice = std::move(sharedSliceRef);
 
-    // The passed slice should now point to a valid None slice
-    ASSERT_LE(1, sharedSliceRef.buffer().use_count()); // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+    // The passed slice should now point to a valid None slice, which owns
+    // nothing
+    // NOLINTNEXTLINE(bugprone-use-after-move,hicpp-invalid-access-moved)
+    ASSERT_EQ(0, sharedSliceRef.buffer().use_count());
     ASSERT_TRUE(sharedSliceRef.isNone());
     // The underlying buffers should be different
     ASSERT_NE(sharedSliceRef.buffer(), sharedSlice.buffer());
@@ -1340,3 +1353,34 @@ TEST(SharedSliceRefcountTest, getBCD) {
     }
   });
 }
+
+TEST(SharedSliceFactoryTest, copyOf) {
+  forAllTestCases([&](SharedSlice sharedSlice) {
+    auto copy = SharedSlice::copyOf(sharedSlice.slice());
+    ASSERT_TRUE(copy.binaryEquals(sharedSlice.slice()));
+    ASSERT_NE(sharedSlice.slice().start(), copy.slice().start());
+    ASSERT_EQ(1, copy.buffer().use_count());
+    ASSERT_FALSE(haveSameOwnership(sharedSlice, copy));
+  });
+}
+
+TEST(SharedSliceFactoryTest, fromBuilder) {
+  Builder builder;
+  builder.openObject();
+  builder.add("foo", Value("bar"));
+  builder.close();
+  auto const expected = builder.slice().toJson();
+
+  auto sharedSlice = SharedSlice::fromBuilder(std::move(builder));
+  ASSERT_EQ(expected, sharedSlice.toJson());
+  ASSERT_EQ(1, sharedSlice.buffer().use_count());
+  // NOLINTNEXTLINE(bugprone-use-after-move,hicpp-invalid-access-moved)
+  ASSERT_TRUE(builder.isEmpty());
+}
+
+TEST(SharedSliceFactoryTest, fromOpenBuilderThrows) {
+  Builder builder;
+  builder.openArray();
+  ASSERT_THROW(std::ignore = SharedSlice::fromBuilder(std::move(builder)),
+               Exception);
+}